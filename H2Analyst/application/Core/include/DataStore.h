@@ -7,11 +7,25 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <numeric>
+#include <execution>
+#include <queue>
+#include <limits>
+#include <cmath>
+#include <sstream>
+#include <iomanip>
+#include <set>
+#include <functional>
 
 #include "Parsers.h"
 #include "DataStructures.h"
+#include "DatasetCatalog.h"
 #include "Populator.h"
+#include "AlignWorker.h"
+#include "TimeAlignment.h"
+#include "Expression.h"
 #include "Dialogs.h"
+#include "Emcies.h"
 
 
 class DataStore : public QObject
@@ -20,13 +34,39 @@ class DataStore : public QObject
 	Q_OBJECT
 
 	uint8_t m_MergeCounter = 1;
+	uint32_t m_DerivedCounter = 0;
+	const uint32_t DERIVED_UID_BASE = 0x80000000; // UIDs of derived datasets start here, to not collide with UIDs from logs
+
+	H2A::Datafile* m_Derived = nullptr; // Datafile that holds all derived datasets
+	std::set<const H2A::Dataset*> m_Reevaluate; // Derived datasets of which the evaluation in progress is outdated
 
 	std::vector<H2A::Datafile*> m_Datafiles;
+	DatasetCatalog m_Catalog;
 
 	H2A::Datafile* loadFileFromName(const std::string& filename);
 	void createPopulator(H2A::Datafile* datafile);
 	void alignTimeVectors(std::vector<H2A::Datafile*> datafiles);
-	H2A::Datafile* mergeData(std::vector<H2A::Datafile*> datafiles);
+	void applyTimeCorrection(H2A::Datafile* datafile, const H2A::Alignment::Correction& correction);
+
+	// Time correction per datafile that is merged, in the order of the merged datafiles. A merge applies these corrections
+	// instead of changing the corrections of the datafiles, so the datafiles it merges from are not modified.
+	using Timebase = std::vector<H2A::Alignment::Correction>;
+	static Timebase timebase(const std::vector<H2A::Datafile*>& datafiles, bool align);
+	static double correctTime(const H2A::Alignment::Correction& correction, double time) { return time * (1.0 + correction.drift) + correction.offset; };
+
+	H2A::Datafile* mergeData(std::vector<H2A::Datafile*> datafiles, bool align = false);
+	void allocateMessages(const std::vector<H2A::Datafile*>& datafiles, H2A::Datafile* df) const;
+	void concatenateMessages(const std::vector<H2A::Datafile*>& datafiles, const Timebase& timebase, H2A::Datafile* df) const;
+	void interleaveMessages(const std::vector<H2A::Datafile*>& datafiles, const Timebase& timebase, H2A::Datafile* df) const;
+	void assembleDatasets(const std::vector<H2A::Datafile*>& datafiles, const Timebase& timebase, H2A::Datafile* df) const;
+	static void copyMessages(const H2A::Datafile* src, const H2A::Alignment::Correction& correction, arma::uword first, arma::uword last, H2A::Datafile* df, arma::uword target);
+	static bool overlapInTime(const std::vector<H2A::Datafile*>& datafiles);
+	static bool overlapInTime(const std::vector<H2A::Datafile*>& datafiles, const Timebase& timebase);
+	static std::vector<std::vector<H2A::Datafile*>> groupNonOverlapping(std::vector<H2A::Datafile*> datafiles);
+	const H2A::Dataset* findDataset(const std::string& name) const;
+	void startEvaluation(H2A::Dataset* dataset);
+	void reevaluateDerived(const H2A::Datafile* datafile);
+	static bool dependsOn(const H2A::Dataset* dataset, const H2A::Datafile* datafile);
 
 public:
 
@@ -35,11 +75,17 @@ public:
 	const std::vector<H2A::Datafile*>& getDatafiles();
 	void requestDatasetPopulation(const H2A::Dataset* dataset);
 	void loadFiles(const QStringList &files);
+	void mergeDatafiles(const std::vector<const H2A::Datafile*>& datafiles);
+	bool alignOnSignal(const H2A::Dataset* reference, const H2A::Dataset* target, double maxLag, const std::function<void(bool)>& finished = nullptr);
+	bool alignOnAnchors(const H2A::Datafile* datafile, const std::vector<std::pair<double, double>>& anchors);
 	bool datasetPresentUID(const H2A::Datafile* datafile, const uint32_t uid) const;
+	std::shared_ptr<const H2A::Emcy::Index> emcyIndex(const H2A::Datafile* datafile);
+	const H2A::Dataset* createDerivedDataset(const std::string& name, const std::string& unit, const std::string& formula, std::string& error);
 
 signals:
 	void fileLoaded();
 	void datasetChanged(const H2A::Dataset* dataset);
+	void timeCorrected(const H2A::Datafile* datafile);
 
 };
 
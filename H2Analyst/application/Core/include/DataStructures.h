@@ -5,15 +5,53 @@
 
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+#include <memory>
 
 #include <armadillo>
 
 #include "Timestamp.h"
+#include "RangeIndex.h"
 
 namespace H2A
 {
 	
 	struct Datafile;
+	class Expression;
+	namespace Emcy { class Index; }
+
+	/**
+	* Summary statistics of a Dataset, computed when the dataset is populated.
+	* Times are stored without the time correction of the datafile.
+	**/
+	struct DatasetStats
+	{
+		static constexpr double GAP_FACTOR = 5.0; // Intervals longer than this factor times the median interval are counted as gap
+
+		size_t count = 0; // Number of datapoints
+		double min = std::numeric_limits<double>::quiet_NaN();
+		double max = std::numeric_limits<double>::quiet_NaN();
+		double mean = std::numeric_limits<double>::quiet_NaN();
+		double stddev = std::numeric_limits<double>::quiet_NaN();
+		double firstTime = 0.0;
+		double lastTime = 0.0;
+		double medianInterval = 0.0;
+		size_t gaps = 0;
+
+		void add(double value);
+		void finish(const std::vector<double>& time);
+		bool hasRange() const { return m_Finite > 0; }; // False if there are no finite values, min and max are NaN then
+		double samplingFreq() const { return medianInterval > 0.0 ? 1.0 / medianInterval : 0.0; };
+
+	private:
+		size_t m_Finite = 0; // Sums of the finite values, shifted by the first one to limit cancellation in the variance
+		double m_Shift = 0.0;
+		double m_Sum = 0.0;
+		double m_SumSquares = 0.0;
+	};
 
 	/**
 	* A Dataset contains one timeseries of a single signal.
@@ -24,7 +62,7 @@ namespace H2A
 		std::vector<double> timeVector = std::vector<double>();
 
 	public:
-		QMutex mutex = QMutex(); // Mutex for multi-thread protection
+		mutable QMutex mutex = QMutex(); // Mutex for multi-thread protection, also locked to read a const dataset
 
 		Datafile* datafile = nullptr;
 
@@ -39,12 +77,26 @@ namespace H2A
 		float offset = 0.0;
 		float scale = 0.0;
 
-		void setTimeVec(std::vector<double> time) { timeVector = time; };
+		void setTimeVec(std::vector<double> time) { timeVector = std::move(time); index.clear(); };
 		const std::vector<double> timeVec() const;
+		const std::vector<double>& rawTimeVec() const { return timeVector; }; // Time vector without time correction of datafile
+		double time(size_t i) const;
+
+		void setDefinition(const Dataset& other);
+		bool sameDefinition(const Dataset& other) const;
+
+		DatasetStats stats;
+		void computeStats();
+
+		RangeIndex index; // Refers to time and data vector, built when the dataset is populated
+		void buildIndex() { index.build(timeVector, dataVec); };
+		bool windowStats(double tStart, double tEnd, WindowStats& result) const;
 
 		std::vector<double> dataVec = std::vector<double>();
 		std::vector<uint64_t> byteVec = std::vector<uint64_t>();
 
+		std::shared_ptr<const Expression> expression; // Formula of a derived dataset, which is evaluated instead of decoded on population
+
 		bool volatile populating = false;
 		bool volatile populated = false;
 	};
@@ -60,6 +112,8 @@ namespace H2A
 		Timestamp startTime;
 		Timestamp endTime;
 		double timeOffset = 0.0;
+		double timeDrift = 0.0; // Relative clock drift w.r.t. the aligned timebase (corrected time = time * (1 + drift) + offset)
+		double startOffset = 0.0; // Part of the offset that follows from the start times, see DataStore::alignTimeVectors
 		std::vector<Dataset*> datasets = std::vector<Dataset*>();
 
 		arma::Row<uint16_t>* message_ids = nullptr;
@@ -69,6 +123,11 @@ namespace H2A
 		bool volatile populationStarted = false;
 		QThread* populationThread;
 		std::vector<Dataset*> populationPrioList = std::vector<Dataset*>();
+
+		std::shared_ptr<const Emcy::Index> emcyIndex; // Built on first use, see DataStore::emcyIndex
+
+		double correctTime(double time) const { return time * (1.0 + timeDrift) + timeOffset; };
+		double rawTime(double time) const { return (time - timeOffset) / (1.0 + timeDrift); };
 	};
 }
 
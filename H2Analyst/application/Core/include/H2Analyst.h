@@ -7,6 +7,9 @@
 #include <QSplitter>
 #include <QSizePolicy>
 #include <QFileDialog>
+#include <QInputDialog>
+#include <QProgressDialog>
+#include <QThread>
 
 #include "ControlPanel.h"
 #include "DataStore.h"
@@ -17,6 +20,8 @@
 #include "Parsers.h"
 #include "PanelToggleButton.h"
 #include "Exporters.h"
+#include "ExportWorker.h"
+#include "DialogExport.h"
 
 class PanelToggleButton;
 
@@ -43,6 +48,8 @@ private:
 
     QPixmap m_Logo;
 
+    H2A::Export::Settings m_ExportSettings;
+
 public:
     H2Analyst(QWidget* parent = Q_NULLPTR);
 
@@ -50,6 +57,6 @@ public:
 public slots:
     void hideSidePanel();
     void openFiles();
-    void exportDatasets();
+    void exportDatasets(AbstractPlot* source = nullptr);
 
 };
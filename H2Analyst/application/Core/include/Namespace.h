@@ -18,10 +18,43 @@ namespace H2A
     inline void logInfo(const std::string& mess) { std::cout << "[INFO] " << mess << std::endl; };
     inline void logWarning(const std::string& mess) { std::cout << "[Warning] " << mess << std::endl; };
 
+    /**
+    * DataStore
+    **/
+    // Merging of logs that overlap in time: interleave their messages or keep them as separate datafiles
+    enum class MergeMode : uint8_t { Interleave, Separate };
+
+    /**
+    * DataOperations
+    **/
+    // Resampling: hold previous sample, take nearest sample, interpolate linearly or average over the resampling interval (anti-aliasing)
+    enum class ResampleMode : uint8_t { ZeroOrderHold, Nearest, Linear, Average };
+    const size_t RESAMPLE_CHUNK_SIZE = 4096; // Number of points resampled at once, to keep the working set in cache
+
+    /**
+    * Filters
+    **/
+    enum class FilterType : uint8_t { None, MovingAverage, Exponential, LowPass, HighPass, Median };
+
+    /**
+    * EventSearch
+    **/
+    // Level conditions give intervals, edge conditions and changes give instants
+    enum class EventCondition : uint8_t { Above, Below, InRange, OutOfRange, InSet, RisingEdge, FallingEdge, Change };
+
+    /**
+    * Exporters
+    **/
+    // Resampled to a uniform grid, one row per native timestamp of any dataset, or one (time, signal, value) row per sample
+    // in order of time (long format) or of one dataset after the other (per signal)
+    enum class ExportLayout : uint8_t { Resampled, EventTable, LongFormat, PerSignal };
+    // MAT is a struct per dataset, IntCanLog the message table of a datafile in the format of the car logs
+    enum class ExportFormat : uint8_t { CSV, Arrow, MAT, IntCanLog };
+
     /**
     * Plots
     **/
-    enum PlotType { Abstract, Time, XY, EmcyList };
+    enum PlotType { Abstract, Time, XY, EmcyList, Spectrum, Histogram, Heatmap };
 
     const std::vector<QColor> PlotColors = {
         QColor(0, 114, 189),
@@ -22,6 +22,7 @@ public:
 	SettingsManager();
 	
 	void resetAllToDefault();
+	static QString settingsFolder();
 
 };
 
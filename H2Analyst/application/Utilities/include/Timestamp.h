@@ -13,6 +13,7 @@ struct Timestamp
 
 	boost::posix_time::ptime timePoint;
 	void set(std::vector<uint16_t> vec);
+	std::vector<uint16_t> get() const;
 
 	bool operator< (const Timestamp& ts) const {
 		return timePoint < ts.timePoint;
@@ -15,6 +15,9 @@
 #include <QDrag>
 #include <QMimeData>
 #include <QLineEdit>
+#include <QMenu>
+#include <QInputDialog>
+#include <QRegularExpression>
 
 #include "DataStore.h"
 #include "DataStructures.h"
@@ -24,6 +27,20 @@
 Q_DECLARE_METATYPE(const void*)
 Q_DECLARE_METATYPE(H2A::ItemType)
 
+/**
+* Tree item of a dataset. Its tooltip is created when it is shown, because the statistics of the dataset
+* are only known after population.
+**/
+class DatasetItem :
+    public QStandardItem
+{
+    const H2A::Dataset* m_Dataset;
+
+public:
+    DatasetItem(const H2A::Dataset* dataset, const QString& text) : QStandardItem(text), m_Dataset(dataset) {};
+    QVariant data(int role = Qt::UserRole + 1) const override;
+};
+
 class DataPanel :
     public QWidget
 {
@@ -45,7 +62,7 @@ class DataPanel :
     QStandardItem* createTreeItemFromDatafile(const H2A::Datafile* df);
     QStandardItem* createTreeItem(const H2A::Datafile* datafile, const std::string& name);
     QStandardItem* createTreeItem(const H2A::Dataset* dataset, const std::string& name);
-    QStandardItem* createTreeItem(const H2A::ItemType& type, const std::string& name);
+    QStandardItem* createTreeItem(const H2A::ItemType& type, const std::string& name, QStandardItem* item = nullptr);
     void addChildrenDatasets(const QStandardItem* item, std::vector<const H2A::Dataset*>& target) const;
 
     const H2A::Dataset* getDatasetFromItem(const QStandardItem* item) const;
@@ -64,9 +81,14 @@ public:
 
     void requestDatasetPopulation(const H2A::Dataset* dataset, bool blocking = false) const;
     void requestDatasetPopulation(std::vector<const H2A::Dataset*> datasets, bool blocking = false) const;
+    std::shared_ptr<const H2A::Emcy::Index> getEmcyIndex(const H2A::Datafile* datafile) const;
 
 private slots:
     void searchInputChanged();
+    void contextMenu(const QPoint& pos);
+    void alignOnSignal();
+    void alignOnAnchors();
+    void createDerivedDataset();
 
 public slots:
     void updateData();
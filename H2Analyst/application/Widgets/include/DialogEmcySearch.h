@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QDialog>
+#include <QGridLayout>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QLabel>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QRegularExpressionValidator>
+
+#include <vector>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+
+#include "Emcies.h"
+#include "DataPanel.h"
+
+/**
+* Dialog to search the EMCYs of all loaded logs for codes and severities. The search uses the EMCY index of every datafile,
+* which is built the first time a datafile is searched or shown in an EMCY list.
+**/
+class DialogEmcySearch :
+	public QDialog
+{
+
+	Q_OBJECT
+
+	const int MAX_LISTED = 1000; // Largest number of EMCYs shown per log
+
+	const DataPanel* m_DataPanel;
+	const H2A::Emcy::Definitions* m_Definitions;
+
+	QLineEdit* m_Codes;
+	QComboBox* m_Severity;
+	QTreeWidget* m_Results;
+	QLabel* m_Status;
+
+public:
+	DialogEmcySearch(const DataPanel* dataPanel, const H2A::Emcy::Definitions* definitions, const QString& codes, QWidget* parent = nullptr);
+
+	static std::vector<uint16_t> parseCodes(const QString& text);
+
+private slots:
+	void search();
+
+signals:
+	void timeSelected(double time);
+
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QDialog>
+#include <QGridLayout>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QLabel>
+#include <QPushButton>
+#include <QListWidget>
+#include <QDoubleValidator>
+
+#include <vector>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+
+#include "EventSearch.h"
+
+/**
+* Dialog to search datasets for events (threshold crossings, edges, values in a range or set) and step through
+* the found events with the time cursor.
+**/
+class DialogEventSearch :
+	public QDialog
+{
+
+	Q_OBJECT
+
+	const int MAX_LISTED = 1000; // Largest number of events shown in the list, all events can be stepped through
+
+	std::vector<const H2A::Dataset*> m_Datasets;
+	std::vector<H2A::Events::Interval> m_Events;
+	double m_CurrentTime;
+
+	QComboBox* m_Condition;
+	QLineEdit* m_Lower;
+	QLineEdit* m_Upper;
+	QLineEdit* m_Values;
+	QListWidget* m_List;
+	QLabel* m_Status;
+
+	void select(size_t index);
+
+public:
+	DialogEventSearch(const std::vector<const H2A::Dataset*>& datasets, QWidget* parent = nullptr);
+
+public slots:
+	void setCurrentTime(double time) { m_CurrentTime = time; };
+
+private slots:
+	void conditionChanged(int index);
+	void search();
+	void previous();
+	void next();
+
+signals:
+	void timeSelected(double time);
+
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QDialog>
+#include <QGridLayout>
+#include <QComboBox>
+#include <QSpinBox>
+#include <QDoubleSpinBox>
+#include <QLabel>
+#include <QPushButton>
+#include <QCheckBox>
+
+#include <cmath>
+#include <algorithm>
+
+#include "Exporters.h"
+
+/**
+* Dialog to choose the format, layout, resampling, precision and time range of an export. The time range can be the full extent of the
+* datasets, the visible range of a plot, a window around the time cursor or a custom range.
+**/
+class DialogExport :
+	public QDialog
+{
+
+	Q_OBJECT
+
+	enum Range { Full, Visible, Cursor, Custom };
+
+	QComboBox* m_Format;
+	QComboBox* m_Layout;
+	QDoubleSpinBox* m_Freq;
+	QComboBox* m_Mode;
+	QSpinBox* m_Precision;
+	QComboBox* m_Range;
+	QDoubleSpinBox* m_Margin;
+	QDoubleSpinBox* m_Start;
+	QDoubleSpinBox* m_End;
+	QCheckBox* m_Compress;
+
+	double m_VisibleStart, m_VisibleEnd;
+	double m_CursorTime;
+
+	QDoubleSpinBox* createTimeBox(double value);
+
+public:
+	DialogExport(const H2A::Export::Settings& settings, QWidget* parent = nullptr);
+
+	void setVisibleRange(double start, double end, bool select = false);
+	void setCursorTime(double time);
+	H2A::Export::Settings settings() const;
+
+private slots:
+	void updateFields();
+
+};
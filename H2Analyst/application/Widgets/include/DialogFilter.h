@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QDialog>
+#include <QGridLayout>
+#include <QComboBox>
+#include <QSlider>
+#include <QLabel>
+#include <QPushButton>
+
+#include <cmath>
+
+#include "Filters.h"
+
+/**
+* Dialog to select a filter for a plot. The filter is emitted on every change, so the plot can be updated while
+* the slider is moved.
+**/
+class DialogFilter :
+	public QDialog
+{
+
+	Q_OBJECT
+
+	const int SLIDER_STEPS = 1000;
+
+	QComboBox* m_Type;
+	QSlider* m_Slider;
+	QLabel* m_Value;
+	H2A::Filters::Settings m_Settings;
+
+	void parameterRange(double& lower, double& upper) const;
+
+public:
+	DialogFilter(const H2A::Filters::Settings& settings, QWidget* parent = nullptr);
+
+	const H2A::Filters::Settings& settings() const { return m_Settings; };
+
+private slots:
+	void typeChanged(int index);
+	void sliderMoved(int position);
+
+signals:
+	void filterChanged(const H2A::Filters::Settings& settings);
+
+};
@@ -3,8 +3,14 @@
 #include "AbstractPlot.h"
 #include "TimePlot.h"
 #include "EmcyPlot.h"
+#include "SpectrumPlot.h"
+#include "HistogramPlot.h"
+#include "HeatmapPlot.h"
+#include "XYPlot.h"
 #include "DataPanel.h"
 #include "DialogPlotLayout.h"
+#include "DialogFilter.h"
+#include "DialogEventSearch.h"
 #include "Dialogs.h"
 #include "Namespace.h"
 #include "FlexGridLayout.h"
@@ -58,6 +64,7 @@ public:
     bool allPlotsEmpty();
     const bool timeCursorEnabled() const { return m_TimeCursorEnabled; };
     const double timeCursorTime() const { return m_TimeCursorTime; };
+    bool visibleTimeRange(QCPRange& range);
 
 public slots:
     void contextMenu(AbstractPlot* source, const QPoint& pos);
@@ -66,13 +73,18 @@ public slots:
     void alignTimeAxis(AbstractPlot* ref = nullptr);
     void setTimeCursorEnabled(bool enabled);
     void setTimeCursorTime(double time);
+    void showTime(double time);
+    void searchEvents(AbstractPlot* source);
     void resetAllViews();
     void deletePlot(AbstractPlot* source);
     void insertPlot(AbstractPlot* source, H2A::Direction dir);
     void plotSelected(AbstractPlot* target = nullptr, H2A::PlotType type = H2A::Abstract, bool clearFirst = true);
     void setSelectedCar(H2A::Car car);
+    void timeCorrected(const H2A::Datafile* datafile);
+    void datasetChanged(const H2A::Dataset* dataset);
     
 signals:
     void timeCursorMoved(double time);
     void selectedCarChanged(H2A::Car car);
+    void exportRequested(AbstractPlot* source);
 };
\ No newline at end of file
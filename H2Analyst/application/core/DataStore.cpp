@@ -2,7 +2,8 @@
 
 
 DataStore::DataStore() :
-	m_Datafiles() {
+	m_Datafiles(),
+	m_Catalog() {
 }
 
 const std::vector<H2A::Datafile*>& DataStore::getDatafiles() {
@@ -13,6 +14,15 @@ void DataStore::requestDatasetPopulation(const H2A::Dataset* dataset) {
 	// This function adds the given dataset to the population priority list of its datafile
 
 	H2A::Datafile* datafile = dataset->datafile;
+	if (datafile == m_Derived) {
+		// Derived datasets are evaluated on request, after requesting population of the datasets they are computed from
+		for (const auto& input : dataset->expression->inputs())
+			if (!input->populated) this->requestDatasetPopulation(input);
+		auto derived = std::find(m_Derived->datasets.begin(), m_Derived->datasets.end(), dataset);
+		if (derived != m_Derived->datasets.end()) this->startEvaluation(*derived);
+		return;
+	}
+
 	for (const auto& ds : datafile->datasets)
 	{
 		if (ds == dataset)
@@ -35,6 +45,7 @@ H2A::Datafile* DataStore::loadFileFromName(const std::string& filename) {
 	// Todo: select parser based on filetype
 	H2A::Parsers::IntCanLog(filename, df);
 	this->createPopulator(df);
+	m_Catalog.add(df);
 
 	return df;
 }
@@ -87,7 +98,25 @@ void DataStore::loadFiles(const QStringList& files) {
 	// If requested, merge and/or align data
 	if (mergeData) {
 		this->alignTimeVectors(datafiles);
-		m_Datafiles.push_back(this->mergeData(datafiles));
+
+		// Logs that overlap in time can be interleaved into a single datafile or kept as separate sources
+		H2A::MergeMode mode = H2A::MergeMode::Interleave;
+		if (DataStore::overlapInTime(datafiles) && !H2A::Dialog::question("Some files overlap in time. Interleave them into a single datafile?"))
+			mode = H2A::MergeMode::Separate;
+
+		std::vector<H2A::Datafile*> merged;
+		if (mode == H2A::MergeMode::Interleave) {
+			merged.push_back(this->mergeData(datafiles));
+		}
+		else {
+			for (const auto& group : DataStore::groupNonOverlapping(datafiles))
+				merged.push_back(this->mergeData(group));
+		}
+		m_Datafiles.insert(m_Datafiles.end(), merged.begin(), merged.end());
+
+		// The loaded datafiles are replaced by the merged datafiles in the catalog
+		for (const auto& datafile : datafiles)
+			if (std::find(merged.begin(), merged.end(), datafile) == merged.end()) m_Catalog.remove(datafile);
 	}
 	else {
 		m_Datafiles.insert(m_Datafiles.end(), datafiles.begin(), datafiles.end());
@@ -102,6 +131,158 @@ void DataStore::loadFiles(const QStringList& files) {
 
 }
 
+/**
+* Merge datafiles that are already loaded into a new datafile. The loaded datafiles are kept, including their time correction.
+*
+* @param datafiles Datafiles to merge.
+**/
+void DataStore::mergeDatafiles(const std::vector<const H2A::Datafile*>& datafiles) {
+	if (datafiles.size() < 2) return;
+
+	// Find the datafiles in the store, the given pointers are const
+	std::vector<H2A::Datafile*> sources;
+	for (const auto& datafile : m_Datafiles)
+		if (datafile != m_Derived && std::find(datafiles.begin(), datafiles.end(), datafile) != datafiles.end()) sources.push_back(datafile);
+	if (sources.size() < 2) return;
+
+	// The datafiles can be shown in plots, so aligning them on their start time only affects the merged datafile
+	const bool align = H2A::Dialog::question("Align time vectors before merging?");
+	H2A::Datafile* merged = this->mergeData(sources, align);
+	m_Datafiles.push_back(merged);
+	emit fileLoaded();
+
+	if (!merged->populationStarted) merged->populationThread->start();
+}
+
+/**
+* Create a dataset that is computed from other datasets with a formula (see H2A::Expression for the syntax).
+* The dataset is added to the datafile with derived datasets and is evaluated when its population is requested.
+*
+* @param name Name of the dataset.
+* @param unit Unit of the dataset.
+* @param formula Formula to compute the dataset with.
+* @param error String to store error message in if the formula is invalid.
+**/
+const H2A::Dataset* DataStore::createDerivedDataset(const std::string& name, const std::string& unit, const std::string& formula, std::string& error) {
+	auto expression = H2A::Expression::compile(formula, [this](const std::string& name) { return this->findDataset(name); }, error);
+	if (!expression) return nullptr;
+
+	if (m_Derived == nullptr) {
+		m_Derived = new H2A::Datafile;
+		m_Derived->name = "Derived";
+		m_Derived->populationStarted = true; // Derived datasets are not populated by a populator, but evaluated on request
+		if (!m_Datafiles.empty()) m_Derived->startTime = m_Datafiles.front()->startTime;
+		m_Datafiles.push_back(m_Derived);
+	}
+
+	H2A::Dataset* dataset = new H2A::Dataset;
+	dataset->datafile = m_Derived;
+	dataset->name = "Derived - " + name;
+	dataset->quantity = name;
+	dataset->unit = unit;
+	dataset->uid = DERIVED_UID_BASE + m_DerivedCounter++;
+	dataset->datatype = 9;
+	dataset->scale = 1.0;
+	dataset->expression = expression;
+
+	m_Catalog.remove(m_Derived);
+	m_Derived->datasets.push_back(dataset);
+	m_Catalog.add(m_Derived);
+	emit fileLoaded();
+
+	return dataset;
+}
+
+/**
+* Find a dataset by name. If datafiles contain datasets with the same name, the dataset of the first loaded datafile is returned.
+*
+* @param name Name of the dataset.
+**/
+const H2A::Dataset* DataStore::findDataset(const std::string& name) const {
+	const auto& datasets = m_Catalog.findName(name);
+	for (const auto& datafile : m_Datafiles)
+		for (const auto& dataset : datasets)
+			if (dataset->datafile == datafile) return dataset;
+	return nullptr;
+}
+
+/**
+* Start evaluation of a derived dataset in a separate thread, if it is not evaluated yet.
+*
+* @param dataset Derived dataset to evaluate.
+**/
+void DataStore::startEvaluation(H2A::Dataset* dataset) {
+	dataset->mutex.lock();
+	bool start = !dataset->populated && !dataset->populating;
+	dataset->populating = true;
+	dataset->mutex.unlock();
+	if (!start) return;
+
+	QThread* thread = new QThread();
+	PopulatorWorker* worker = new PopulatorWorker(dataset);
+	worker->moveToThread(thread);
+
+	connect(thread, &QThread::started, worker, &PopulatorWorker::run);
+	connect(worker, &PopulatorWorker::finished, this, [=](const H2A::Dataset* evaluated) {
+		// The time correction of a datafile it is computed from changed during the evaluation, so it is evaluated again
+		if (m_Reevaluate.erase(evaluated) > 0) {
+			dataset->mutex.lock();
+			dataset->populated = false;
+			dataset->populating = false;
+			dataset->mutex.unlock();
+			this->startEvaluation(dataset);
+			return;
+		}
+		emit datasetChanged(evaluated);
+	});
+	connect(worker, &PopulatorWorker::finished, thread, &QThread::quit);
+	connect(worker, &PopulatorWorker::finished, worker, &PopulatorWorker::deleteLater);
+	connect(thread, &QThread::finished, thread, &QThread::deleteLater);
+
+	thread->start();
+}
+
+/**
+* Evaluate the derived datasets that are computed from datasets of a datafile again, after the time correction of the
+* datafile changed. Derived datasets are on the corrected timebase of their inputs, so their time and data are outdated.
+* Datasets that were not evaluated yet are evaluated with the new correction on request, datasets that are being evaluated
+* are evaluated again when that evaluation finishes. The plots are notified by datasetChanged once a dataset is evaluated.
+*
+* @param datafile Datafile of which the time correction changed.
+**/
+void DataStore::reevaluateDerived(const H2A::Datafile* datafile) {
+	if (m_Derived == nullptr || datafile == m_Derived) return;
+
+	for (const auto& dataset : m_Derived->datasets) {
+		if (!DataStore::dependsOn(dataset, datafile)) continue;
+
+		dataset->mutex.lock();
+		const bool evaluating = dataset->populating && !dataset->populated;
+		const bool evaluated = dataset->populated;
+		if (evaluated) {
+			dataset->populated = false;
+			dataset->populating = false;
+		}
+		dataset->mutex.unlock();
+
+		if (evaluating) m_Reevaluate.insert(dataset);
+		if (evaluated) this->startEvaluation(dataset);
+	}
+}
+
+/**
+* Check if a derived dataset is computed from datasets of a datafile, directly or through other derived datasets.
+*
+* @param dataset Derived dataset to check.
+* @param datafile Datafile to check for.
+**/
+bool DataStore::dependsOn(const H2A::Dataset* dataset, const H2A::Datafile* datafile) {
+	if (!dataset->expression) return false;
+	for (const auto& input : dataset->expression->inputs())
+		if (input->datafile == datafile || DataStore::dependsOn(input, datafile)) return true;
+	return false;
+}
+
 /**
 * Function to check if a given UID is present in the given datafile.
 *
@@ -109,13 +290,15 @@ void DataStore::loadFiles(const QStringList& files) {
 * @param uid UID to check for.
 **/
 bool DataStore::datasetPresentUID(const H2A::Datafile* datafile, const uint32_t uid) const {
-	return false;
+	return m_Catalog.findUID(datafile, uid) != nullptr;
 }
 
 /**
 * Adds a padding to the time vectors to make the given datafiles have the same start time.
+* Any drift correction that was estimated before is reset.
 **/
 void DataStore::alignTimeVectors(std::vector<H2A::Datafile*> datafiles) {
+	datafiles.erase(std::remove(datafiles.begin(), datafiles.end(), m_Derived), datafiles.end()); // Derived datasets are already on the aligned timebase
 	if (datafiles.size() == 0) return;
 
 	// Find datafile that start at the earliest timestamp
@@ -125,17 +308,111 @@ void DataStore::alignTimeVectors(std::vector<H2A::Datafile*> datafiles) {
 			first = datafile;
 	}
 
-	// Apply offset to all datafiles to align time vectors
+	// Apply offset to all datafiles to align time vectors, which notifies the plots of datafiles that are already shown
+	first->startOffset = 0.0;
 	for (const auto& datafile : datafiles) {
 		if (datafile == first) continue;
 		
 		boost::posix_time::time_duration diff = datafile->startTime - first->startTime;
-		long ms = diff.total_milliseconds();
-		datafile->timeOffset = static_cast<double>(std::floor(ms / 1000) + (static_cast<double>(ms % 1000)) / 1000.0);
+		H2A::Alignment::Correction correction;
+		correction.offset = static_cast<double>(diff.total_microseconds()) * 1.0e-6;
+		datafile->startOffset = correction.offset;
+		this->applyTimeCorrection(datafile, correction);
 	}
 }
 
-H2A::Datafile* DataStore::mergeData(std::vector<H2A::Datafile*> datafiles)
+/**
+* Align the datafile of the target dataset with the datafile of the reference dataset, by cross-correlating the two datasets.
+* Both the offset and the clock drift between the datafiles are estimated. The datasets are populated and correlated in a
+* separate thread, after which the correction is applied and the given function is called with the result.
+* Returns false if the datafiles cannot be aligned, in which case the function is not called.
+*
+* @param reference Dataset of which the datafile is used as reference.
+* @param target Dataset of which the datafile is aligned.
+* @param maxLag Largest time difference [s] between the datafiles that is searched for.
+* @param finished Function that is called when the alignment finished, with whether a correlation was found.
+**/
+bool DataStore::alignOnSignal(const H2A::Dataset* reference, const H2A::Dataset* target, double maxLag, const std::function<void(bool)>& finished) {
+	if (reference->datafile == target->datafile || target->datafile == m_Derived) return false;
+
+	// Both signals are needed as a whole, so they are populated first
+	for (const auto& dataset : { reference, target })
+		if (!dataset->populated) this->requestDatasetPopulation(dataset);
+
+	QThread* thread = new QThread();
+	AlignWorker* worker = new AlignWorker(reference, target, maxLag);
+	worker->moveToThread(thread);
+
+	connect(thread, &QThread::started, worker, &AlignWorker::run);
+	connect(worker, &AlignWorker::finished, this, [=](bool success, double offset, double drift) {
+		if (success) this->applyTimeCorrection(target->datafile, { offset, drift });
+		else H2A::logWarning("Failed to align datafiles: no correlation found between " + reference->name + " and " + target->name);
+		if (finished) finished(success);
+	});
+	connect(worker, &AlignWorker::finished, thread, &QThread::quit);
+	connect(worker, &AlignWorker::finished, worker, &AlignWorker::deleteLater);
+	connect(thread, &QThread::finished, thread, &QThread::deleteLater);
+
+	thread->start();
+	return true;
+}
+
+/**
+* Align a datafile using anchor events, which are pairs of the time at which an event is currently shown and the time at
+* which the event actually happened. With a single anchor only the offset is corrected, with more anchors also the drift.
+*
+* @param datafile Datafile to align.
+* @param anchors Pairs of (current time, correct time).
+**/
+bool DataStore::alignOnAnchors(const H2A::Datafile* datafile, const std::vector<std::pair<double, double>>& anchors) {
+	auto df = std::find(m_Datafiles.begin(), m_Datafiles.end(), datafile);
+	if (df == m_Datafiles.end() || *df == m_Derived) return false;
+
+	H2A::Alignment::Correction correction;
+	if (!H2A::Alignment::fromAnchors(*df, anchors, correction)) return false;
+	this->applyTimeCorrection(*df, correction);
+	return true;
+}
+
+/**
+* Index of the EMCYs of a datafile. The index is built on first use and kept with the datafile, until the time correction
+* of the datafile changes. The EMCY datasets of the datafile have to be populated.
+*
+* @param datafile Datafile to get the EMCY index of.
+**/
+std::shared_ptr<const H2A::Emcy::Index> DataStore::emcyIndex(const H2A::Datafile* datafile) {
+	auto it = std::find(m_Datafiles.begin(), m_Datafiles.end(), datafile);
+	if (it == m_Datafiles.end()) return nullptr;
+
+	H2A::Datafile* df = *it;
+	if (!df->emcyIndex) df->emcyIndex = std::make_shared<const H2A::Emcy::Index>(H2A::Emcy::datasets(df));
+	return df->emcyIndex;
+}
+
+/**
+* Sets the time correction of a datafile. The correction is applied when the time of its datasets is read,
+* so the stored time vectors are not changed. Plots that copied the time of its datasets are notified by timeCorrected.
+* Derived datasets that are computed from the datafile are evaluated again.
+*
+* @param datafile Datafile to set correction of.
+* @param correction New time correction.
+**/
+void DataStore::applyTimeCorrection(H2A::Datafile* datafile, const H2A::Alignment::Correction& correction) {
+	datafile->mutex.lock();
+	datafile->timeOffset = correction.offset;
+	datafile->timeDrift = correction.drift;
+	datafile->emcyIndex.reset(); // The index holds corrected times, so it is built again when it is used next
+	datafile->mutex.unlock();
+	emit this->timeCorrected(datafile);
+	this->reevaluateDerived(datafile);
+
+	std::stringstream ss;
+	ss << "Time correction of " << datafile->name << ": offset " << std::fixed << std::setprecision(6) << correction.offset
+		<< " s, drift " << std::setprecision(3) << correction.drift * 1.0e6 << " ppm";
+	H2A::logInfo(ss.str());
+}
+
+H2A::Datafile* DataStore::mergeData(std::vector<H2A::Datafile*> datafiles, bool align)
 {
 	if (datafiles.size() == 1) return datafiles.front();
 
@@ -143,6 +420,7 @@ H2A::Datafile* DataStore::mergeData(std::vector<H2A::Datafile*> datafiles)
 	std::sort(datafiles.begin(), datafiles.end(), [](const H2A::Datafile* lhs, const H2A::Datafile* rhs) {
 		return lhs->startTime < rhs->startTime;
 	});
+	Timebase timebase = DataStore::timebase(datafiles, align);
 
 	// Create new datafile
 	H2A::Datafile* df = new H2A::Datafile;
@@ -151,41 +429,376 @@ H2A::Datafile* DataStore::mergeData(std::vector<H2A::Datafile*> datafiles)
 	++ m_MergeCounter;
 	df->name = name.str();
 	df->startTime = datafiles.front()->startTime;
-	df->endTime = datafiles.back()->endTime;
+	df->endTime = datafiles.front()->endTime;
+	for (const auto& datafile : datafiles)
+		if (datafile->endTime > df->endTime) df->endTime = datafile->endTime;
 
-	// Store datasets of first datafile in new datafile.
-	df->datasets = datafiles.front()->datasets;
-	// Remove all datasets that are not in all other datafiles.
-	for (const auto& datafile : datafiles) {
-		df->datasets.erase(std::remove_if(df->datasets.begin(), df->datasets.end(),
-			[datafile](H2A::Dataset* ds) {
-				return std::find_if(datafile->datasets.begin(), datafile->datasets.end(), [ds](H2A::Dataset* ds2) {
-					return ds->uid == ds2->uid;
-					}) == datafile->datasets.end();
-			}), df->datasets.end());
+	// Create datasets in the new datafile for the datasets of the first datafile that are in all other datafiles.
+	for (const auto& dataset : datafiles.front()->datasets) {
+		bool common = std::all_of(datafiles.begin() + 1, datafiles.end(), [&](const H2A::Datafile* datafile) {
+			return this->datasetPresentUID(datafile, dataset->uid);
+		});
+		if (!common) continue;
+
+		H2A::Dataset* ds = new H2A::Dataset;
+		ds->setDefinition(*dataset);
+		ds->datafile = df;
+		df->datasets.push_back(ds);
 	}
 
-	// Set datafile of datasets to the new merged datafile
-	for (const auto& dataset : df->datasets) dataset->datafile = df;
+	// Order the datafiles on the corrected time of their first message, as a time correction can move a datafile
+	// before another datafile that started earlier. Datafiles without messages are placed first.
+	std::vector<size_t> order(datafiles.size());
+	std::iota(order.begin(), order.end(), 0);
+	auto firstTime = [&](size_t i) {
+		if (datafiles[i]->message_time->n_cols == 0) return -std::numeric_limits<double>::infinity();
+		return DataStore::correctTime(timebase[i], datafiles[i]->message_time->at(0));
+	};
+	std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) { return firstTime(lhs) < firstTime(rhs); });
+	std::vector<H2A::Datafile*> sorted;
+	Timebase sortedTimebase;
+	for (const size_t i : order) {
+		sorted.push_back(datafiles[i]);
+		sortedTimebase.push_back(timebase[i]);
+	}
+	datafiles = sorted;
+	timebase = sortedTimebase;
+
+	// Combine the message tables. Logs that overlap in time are interleaved on their timestamps, other
+	// logs can simply be concatenated since they are in chronological order.
+	this->allocateMessages(datafiles, df);
+	if (DataStore::overlapInTime(datafiles, timebase)) this->interleaveMessages(datafiles, timebase, df);
+	else this->concatenateMessages(datafiles, timebase, df);
+
+	// Datasets that are already decoded in all merged datafiles don't have to be decoded again
+	this->assembleDatasets(datafiles, timebase, df);
 
-	// Create message ID, time and message objects by concatenating the ones in the merging datafiles
-	arma::Row<uint16_t> messageIDs;
-	arma::Row<double> messageTimes;
-	arma::Mat<uint8_t> messages;
-	for (const auto& datafile : datafiles) {
-		messageIDs = arma::join_horiz(messageIDs, *(datafile->message_ids));
-		messages = arma::join_horiz(messages, *(datafile->messages));
-		//messageTimes = arma::join_horiz(messageTimes, *(datafile->message_time));
-		arma::Row<double> offsetMessageTimes = *(datafile->message_time);
-		offsetMessageTimes += (arma::Row<double>(offsetMessageTimes.n_cols, arma::fill::ones) * datafile->timeOffset);
-		messageTimes = arma::join_horiz(messageTimes, offsetMessageTimes);
-	}
-	df->message_ids = new arma::Row<uint16_t>(messageIDs);
-	df->message_time = new arma::Row<double>(messageTimes);
-	df->messages = new arma::Mat<uint8_t>(messages);
-	
 	// Create new populator for this datafile
 	this->createPopulator(df);
+	m_Catalog.add(df);
 
 	return df;
 }
+
+/**
+* Time corrections with which datafiles are merged: the current corrections of the datafiles, or offsets that align the
+* datafiles on their start time (without drift correction).
+*
+* @param datafiles Datafiles that are merged.
+* @param align Align the datafiles on their start time.
+**/
+DataStore::Timebase DataStore::timebase(const std::vector<H2A::Datafile*>& datafiles, bool align) {
+	Timebase timebase(datafiles.size());
+	if (datafiles.empty()) return timebase;
+
+	const H2A::Datafile* first = *std::min_element(datafiles.begin(), datafiles.end(), [](const H2A::Datafile* lhs, const H2A::Datafile* rhs) {
+		return lhs->startTime < rhs->startTime;
+	});
+	for (size_t i = 0; i < datafiles.size(); ++i) {
+		if (align) {
+			boost::posix_time::time_duration diff = datafiles[i]->startTime - first->startTime;
+			timebase[i].offset = static_cast<double>(diff.total_microseconds()) * 1.0e-6;
+			continue;
+		}
+		datafiles[i]->mutex.lock();
+		timebase[i].offset = datafiles[i]->timeOffset;
+		timebase[i].drift = datafiles[i]->timeDrift;
+		datafiles[i]->mutex.unlock();
+	}
+	return timebase;
+}
+
+/**
+* Allocates the message table of a merged datafile, large enough to hold the messages of all given datafiles.
+*
+* @param datafiles Datafiles that are merged.
+* @param df Merged datafile to allocate the message table of.
+**/
+void DataStore::allocateMessages(const std::vector<H2A::Datafile*>& datafiles, H2A::Datafile* df) const {
+	arma::uword nCols = 0;
+	arma::uword nRows = 0;
+	for (const auto& datafile : datafiles) {
+		nCols += datafile->message_ids->n_cols;
+		nRows = std::max(nRows, datafile->messages->n_rows);
+	}
+
+	df->message_ids = new arma::Row<uint16_t>(nCols, arma::fill::none);
+	df->message_time = new arma::Row<double>(nCols, arma::fill::none);
+	df->messages = new arma::Mat<uint8_t>(nRows, nCols, arma::fill::none);
+}
+
+/**
+* Copies a range of messages from a datafile into the message table of a merged datafile.
+* The time correction of the source datafile in the merge is applied to the copied message times.
+*
+* @param src Datafile to copy messages from.
+* @param correction Time correction of the source datafile.
+* @param first First column in the source message table to copy.
+* @param last Last column in the source message table to copy.
+* @param df Merged datafile to copy the messages to.
+* @param target First column in the merged message table to copy to.
+**/
+void DataStore::copyMessages(const H2A::Datafile* src, const H2A::Alignment::Correction& correction, arma::uword first, arma::uword last, H2A::Datafile* df, arma::uword target) {
+	const arma::uword targetLast = target + (last - first);
+	df->message_ids->cols(target, targetLast) = src->message_ids->cols(first, last);
+	df->message_time->cols(target, targetLast) = src->message_time->cols(first, last) * (1.0 + correction.drift) + correction.offset;
+
+	// Message tables with less data rows only fill the upper rows, the remaining bytes are zeroed
+	const arma::uword rows = src->messages->n_rows;
+	if (rows == df->messages->n_rows) {
+		df->messages->cols(target, targetLast) = src->messages->cols(first, last);
+	}
+	else {
+		df->messages->cols(target, targetLast).zeros();
+		if (rows > 0) df->messages->submat(0, target, rows - 1, targetLast) = src->messages->cols(first, last);
+	}
+}
+
+/**
+* Fills the message table of a merged datafile by concatenating the message tables of the given datafiles.
+* Every datafile is copied once into its own column range, which is done in parallel.
+*
+* @param datafiles Datafiles to concatenate, sorted on the corrected time of their first message.
+* @param timebase Time corrections of the datafiles.
+* @param df Merged datafile with allocated message table.
+**/
+void DataStore::concatenateMessages(const std::vector<H2A::Datafile*>& datafiles, const Timebase& timebase, H2A::Datafile* df) const {
+	std::vector<arma::uword> colOffsets(datafiles.size() + 1, 0);
+	for (size_t i = 0; i < datafiles.size(); ++i)
+		colOffsets[i + 1] = colOffsets[i] + datafiles[i]->message_ids->n_cols;
+
+	std::vector<size_t> fileIndices(datafiles.size());
+	std::iota(fileIndices.begin(), fileIndices.end(), 0);
+	std::for_each(std::execution::par, fileIndices.begin(), fileIndices.end(), [&](size_t i) {
+		if (colOffsets[i + 1] == colOffsets[i]) return;
+		DataStore::copyMessages(datafiles[i], timebase[i], 0, colOffsets[i + 1] - colOffsets[i] - 1, df, colOffsets[i]);
+	});
+}
+
+/**
+* Fills the message table of a merged datafile with a k-way merge on the message times of the given datafiles.
+* The message tables of the datafiles are already sorted on time, so the merge streams over them once and
+* copies the longest possible run of consecutive messages from a datafile at once. Messages are ordered on time, and
+* messages at the same time in the order of the datafiles.
+*
+* @param datafiles Datafiles to interleave.
+* @param timebase Time corrections of the datafiles.
+* @param df Merged datafile with allocated message table.
+**/
+void DataStore::interleaveMessages(const std::vector<H2A::Datafile*>& datafiles, const Timebase& timebase, H2A::Datafile* df) const {
+	// Head of the remaining messages of a single datafile
+	struct Head {
+		double time;
+		size_t file;
+		arma::uword col;
+	};
+	auto later = [](const Head& lhs, const Head& rhs) {
+		return lhs.time > rhs.time || (lhs.time == rhs.time && lhs.file > rhs.file);
+	};
+	std::priority_queue<Head, std::vector<Head>, decltype(later)> heads(later);
+
+	for (size_t i = 0; i < datafiles.size(); ++i) {
+		if (datafiles[i]->message_time->n_cols == 0) continue;
+		heads.push({ DataStore::correctTime(timebase[i], datafiles[i]->message_time->at(0)), i, 0 });
+	}
+
+	arma::uword target = 0;
+	while (!heads.empty()) {
+		const Head head = heads.top();
+		heads.pop();
+
+		// Find the run of messages of this datafile that come before the next message of any other datafile
+		const H2A::Datafile* datafile = datafiles[head.file];
+		const H2A::Alignment::Correction& correction = timebase[head.file];
+		const arma::Row<double>& time = *(datafile->message_time);
+		const double bound = heads.empty() ? std::numeric_limits<double>::infinity() : heads.top().time;
+		const size_t boundFile = heads.empty() ? datafiles.size() : heads.top().file;
+		auto before = [&](double t) { return t < bound || (t == bound && head.file < boundFile); };
+		arma::uword last = head.col;
+		while (last + 1 < time.n_cols && before(DataStore::correctTime(correction, time(last + 1)))) ++last;
+
+		DataStore::copyMessages(datafile, correction, head.col, last, df, target);
+		target += last - head.col + 1;
+
+		if (last + 1 < time.n_cols)
+			heads.push({ DataStore::correctTime(correction, time(last + 1)), head.file, last + 1 });
+	}
+}
+
+/**
+* Checks if any of the given datafiles overlap in time, taking their time corrections into account.
+*
+* @param datafiles Datafiles to check.
+**/
+bool DataStore::overlapInTime(const std::vector<H2A::Datafile*>& datafiles) {
+	return DataStore::overlapInTime(datafiles, DataStore::timebase(datafiles, false));
+}
+
+/**
+* Checks if any of the given datafiles overlap in time, with the given time corrections.
+*
+* @param datafiles Datafiles to check.
+* @param timebase Time corrections of the datafiles.
+**/
+bool DataStore::overlapInTime(const std::vector<H2A::Datafile*>& datafiles, const Timebase& timebase) {
+	std::vector<std::pair<double, double>> spans;
+	for (size_t i = 0; i < datafiles.size(); ++i) {
+		const H2A::Datafile* datafile = datafiles[i];
+		if (datafile->message_time->n_cols == 0) continue;
+		spans.push_back({ DataStore::correctTime(timebase[i], datafile->message_time->front()), DataStore::correctTime(timebase[i], datafile->message_time->back()) });
+	}
+	std::sort(spans.begin(), spans.end());
+
+	for (size_t i = 1; i < spans.size(); ++i)
+		if (spans[i].first < spans[i - 1].second) return true;
+	return false;
+}
+
+/**
+* Splits the given datafiles into groups of datafiles that do not overlap in time.
+* Datafiles are assigned to the first group in which they fit, which results in the minimum number of groups.
+*
+* @param datafiles Datafiles to split into groups.
+**/
+std::vector<std::vector<H2A::Datafile*>> DataStore::groupNonOverlapping(std::vector<H2A::Datafile*> datafiles) {
+	// Datafiles without messages can not overlap, they are added to the first group
+	std::vector<H2A::Datafile*> empty;
+	for (const auto& datafile : datafiles)
+		if (datafile->message_time->n_cols == 0) empty.push_back(datafile);
+	datafiles.erase(std::remove_if(datafiles.begin(), datafiles.end(), [](const H2A::Datafile* datafile) {
+		return datafile->message_time->n_cols == 0;
+		}), datafiles.end());
+
+	std::sort(datafiles.begin(), datafiles.end(), [](const H2A::Datafile* lhs, const H2A::Datafile* rhs) {
+		return lhs->correctTime(lhs->message_time->front()) < rhs->correctTime(rhs->message_time->front());
+	});
+
+	std::vector<std::vector<H2A::Datafile*>> groups;
+	std::vector<double> groupEnds;
+	for (const auto& datafile : datafiles) {
+		const double start = datafile->correctTime(datafile->message_time->front());
+		const double end = datafile->correctTime(datafile->message_time->back());
+
+		auto group = std::find_if(groupEnds.begin(), groupEnds.end(), [start](double groupEnd) { return groupEnd <= start; });
+		if (group == groupEnds.end()) {
+			groups.push_back({ datafile });
+			groupEnds.push_back(end);
+		}
+		else {
+			groups[group - groupEnds.begin()].push_back(datafile);
+			*group = end;
+		}
+	}
+
+	if (groups.empty()) groups.push_back({});
+	groups.front().insert(groups.front().end(), empty.begin(), empty.end());
+	return groups;
+}
+
+/**
+* Fills the datasets of a merged datafile with the data of the already decoded datasets of the datafiles it is merged from.
+* The decoded data of the merged datafiles is concatenated (or interleaved if the datafiles overlap in time) with their time
+* corrections applied, which is done in parallel for all datasets. Datasets of which not all sources are decoded are left for
+* the populator of the merged datafile. Samples are ordered like the messages in the message table of the merged datafile.
+* The source datasets are locked while they are read, since they can still be populated.
+*
+* @param datafiles Datafiles that are merged, sorted on time.
+* @param timebase Time corrections of the datafiles.
+* @param df Merged datafile.
+**/
+void DataStore::assembleDatasets(const std::vector<H2A::Datafile*>& datafiles, const Timebase& timebase, H2A::Datafile* df) const {
+	const bool interleave = DataStore::overlapInTime(datafiles, timebase);
+
+	std::for_each(std::execution::par, df->datasets.begin(), df->datasets.end(), [&](H2A::Dataset* dataset) {
+		// Collect the decoded source datasets, which must be decoded in exactly the same way as the merged dataset
+		std::vector<const H2A::Dataset*> sources;
+		auto unlock = [&]() { for (const auto& source : sources) source->mutex.unlock(); };
+		for (const auto& datafile : datafiles) {
+			const H2A::Dataset* source = m_Catalog.findUID(datafile, dataset->uid);
+			if (source == nullptr) {
+				unlock();
+				return;
+			}
+			source->mutex.lock();
+			sources.push_back(source);
+			if (!source->populated || !source->sameDefinition(*dataset)) {
+				unlock();
+				return;
+			}
+		}
+
+		size_t size = 0;
+		for (const auto& source : sources) size += source->rawTimeVec().size();
+		std::vector<double> time(size);
+		std::vector<double> data(size);
+		std::vector<uint64_t> bytes(size);
+
+		// Copies a range of samples of a source dataset to the given position in the merged dataset
+		auto copy = [&](size_t s, size_t first, size_t last, size_t target) {
+			const H2A::Dataset* source = sources[s];
+			const H2A::Alignment::Correction& correction = timebase[s];
+			std::transform(source->rawTimeVec().begin() + first, source->rawTimeVec().begin() + last, time.begin() + target, [&correction](double t) { return DataStore::correctTime(correction, t); });
+			std::copy(source->dataVec.begin() + first, source->dataVec.begin() + last, data.begin() + target);
+			std::copy(source->byteVec.begin() + first, source->byteVec.begin() + last, bytes.begin() + target);
+		};
+
+		size_t target = 0;
+		if (!interleave) {
+			for (size_t s = 0; s < sources.size(); ++s) {
+				copy(s, 0, sources[s]->rawTimeVec().size(), target);
+				target += sources[s]->rawTimeVec().size();
+			}
+		}
+		else {
+			// K-way merge of the sources on time, ties are resolved in the order of the datafiles like the message tables
+			std::vector<size_t> cursors(sources.size(), 0);
+			while (target < size) {
+				size_t next = sources.size();
+				double nextTime = std::numeric_limits<double>::infinity();
+				for (size_t s = 0; s < sources.size(); ++s) {
+					if (cursors[s] >= sources[s]->rawTimeVec().size()) continue;
+					double t = DataStore::correctTime(timebase[s], sources[s]->rawTimeVec()[cursors[s]]);
+					if (t < nextTime) {
+						nextTime = t;
+						next = s;
+					}
+				}
+
+				// Find the next sample of the other sources, which bounds the run that can be copied from the selected source
+				size_t boundSource = sources.size();
+				double bound = std::numeric_limits<double>::infinity();
+				for (size_t s = 0; s < sources.size(); ++s) {
+					if (s == next || cursors[s] >= sources[s]->rawTimeVec().size()) continue;
+					double t = DataStore::correctTime(timebase[s], sources[s]->rawTimeVec()[cursors[s]]);
+					if (t < bound) {
+						bound = t;
+						boundSource = s;
+					}
+				}
+
+				const std::vector<double>& sourceTime = sources[next]->rawTimeVec();
+				size_t last = cursors[next] + 1;
+				while (last < sourceTime.size()) {
+					double t = DataStore::correctTime(timebase[next], sourceTime[last]);
+					if (t > bound || (t == bound && next > boundSource)) break;
+					++last;
+				}
+
+				copy(next, cursors[next], last, target);
+				target += last - cursors[next];
+				cursors[next] = last;
+			}
+		}
+		unlock();
+
+		dataset->mutex.lock();
+		dataset->setTimeVec(std::move(time));
+		dataset->dataVec = std::move(data);
+		dataset->byteVec = std::move(bytes);
+		dataset->computeStats();
+		dataset->buildIndex();
+		dataset->populated = true;
+		dataset->mutex.unlock();
+		PopulatorWorker::notifyPopulated();
+	});
+}
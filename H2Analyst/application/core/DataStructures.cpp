@@ -1,11 +1,136 @@
 #include "DataStructures.h"
 
 /**
-* Time vector getter. Needed because it applies offset defined in datafile.
+* Time vector getter. Needed because it applies the time correction (offset and drift) defined in datafile.
 **/
 const std::vector<double> H2A::Dataset::timeVec() const
 {
-	std::vector<double> time = timeVector;
-	std::for_each(time.begin(), time.end(), [this](double& t) {t += datafile->timeOffset; });
+	std::vector<double> time(timeVector.size());
+	std::transform(timeVector.begin(), timeVector.end(), time.begin(), [this](double t) { return datafile->correctTime(t); });
 	return time;
 }
+
+/**
+* Returns a single timestamp with the time correction of the datafile applied.
+*
+* @param i Index of the timestamp.
+**/
+double H2A::Dataset::time(size_t i) const
+{
+	return datafile->correctTime(timeVector[i]);
+}
+
+/**
+* Computes the statistics of the dataset over a time window (with the time correction of the datafile applied).
+*
+* @param tStart Start of window.
+* @param tEnd End of window.
+* @param result Object to store statistics in.
+**/
+bool H2A::Dataset::windowStats(double tStart, double tEnd, WindowStats& result) const
+{
+	if (!index.query(datafile->rawTime(tStart), datafile->rawTime(tEnd), result)) return false;
+	result.integral *= 1.0 + datafile->timeDrift;
+	return true;
+}
+
+/**
+* Copies the definition of another dataset (name, units and how it is decoded from messages), but not its data.
+*
+* @param other Dataset to copy the definition of.
+**/
+void H2A::Dataset::setDefinition(const Dataset& other)
+{
+	name = other.name;
+	quantity = other.quantity;
+	unit = other.unit;
+	length = other.length;
+	byteOffset = other.byteOffset;
+	id = other.id;
+	uid = other.uid;
+	datatype = other.datatype;
+	offset = other.offset;
+	scale = other.scale;
+}
+
+/**
+* Checks if another dataset is decoded from messages in exactly the same way as this dataset.
+*
+* @param other Dataset to compare with.
+**/
+bool H2A::Dataset::sameDefinition(const Dataset& other) const
+{
+	return uid == other.uid && id == other.id && length == other.length && byteOffset == other.byteOffset &&
+		datatype == other.datatype && offset == other.offset && scale == other.scale;
+}
+
+/**
+* Computes the statistics of the dataset from its data and time vector. Used for datasets that are not decoded
+* by a PopulatorWorker, which computes the statistics while decoding.
+**/
+void H2A::Dataset::computeStats()
+{
+	stats = DatasetStats();
+	for (const auto& value : dataVec) stats.add(value);
+	stats.finish(timeVector);
+}
+
+/**
+* Adds a value to the statistics of the data. Non-finite values are counted, but not included in the range, mean and stddev.
+* The mean and stddev are computed from the sums in finish.
+*
+* @param value Value to add.
+**/
+void H2A::DatasetStats::add(double value)
+{
+	++count;
+	if (!std::isfinite(value)) return;
+
+	if (m_Finite == 0) {
+		min = value;
+		max = value;
+		m_Shift = value;
+	}
+	else {
+		min = std::min(min, value);
+		max = std::max(max, value);
+	}
+
+	++m_Finite;
+	const double shifted = value - m_Shift;
+	m_Sum += shifted;
+	m_SumSquares += shifted * shifted;
+}
+
+/**
+* Computes the mean and stddev and the time statistics once all values are added.
+*
+* @param time Time vector of the dataset (ascending).
+**/
+void H2A::DatasetStats::finish(const std::vector<double>& time)
+{
+	if (m_Finite > 0) {
+		const double shiftedMean = m_Sum / m_Finite;
+		mean = m_Shift + shiftedMean;
+		stddev = std::sqrt(std::max(m_SumSquares / m_Finite - shiftedMean * shiftedMean, 0.0));
+	}
+
+	gaps = 0;
+	medianInterval = 0.0;
+	if (time.empty()) return;
+	firstTime = time.front();
+	lastTime = time.back();
+	if (time.size() < 2) return;
+
+	std::vector<double> intervals(time.size() - 1);
+	std::adjacent_difference(time.begin() + 1, time.end(), intervals.begin());
+	intervals.front() = time[1] - time[0];
+	auto median = intervals.begin() + intervals.size() / 2;
+	std::nth_element(intervals.begin(), median, intervals.end());
+	medianInterval = *median;
+	if (medianInterval <= 0.0) return;
+
+	const double gapThreshold = GAP_FACTOR * medianInterval;
+	for (size_t i = 1; i < time.size(); ++i)
+		if (time[i] - time[i - 1] > gapThreshold) ++gaps;
+}
@@ -0,0 +1,68 @@
+#include "DatasetCatalog.h"
+
+const std::vector<H2A::Dataset*> DatasetCatalog::EMPTY = std::vector<H2A::Dataset*>();
+
+/**
+* Adds the datasets of a datafile to the catalog.
+* If the datafile was already added, its entries are refreshed.
+*
+* @param datafile Datafile to add.
+**/
+void DatasetCatalog::add(const H2A::Datafile* datafile) {
+	if (this->contains(datafile)) this->remove(datafile);
+
+	auto& byUID = m_ByFileUID[datafile];
+	for (const auto& dataset : datafile->datasets) {
+		m_ByName[dataset->name].push_back(dataset);
+		byUID.emplace(dataset->uid, dataset); // Only the first dataset is stored if a UID is used more than once
+	}
+	m_Registered[datafile] = datafile->datasets;
+}
+
+/**
+* Removes all datasets that were added with the given datafile from the catalog.
+*
+* @param datafile Datafile to remove.
+**/
+void DatasetCatalog::remove(const H2A::Datafile* datafile) {
+	auto registered = m_Registered.find(datafile);
+	if (registered == m_Registered.end()) return;
+
+	// Remove the dataset from the list under the given key, and the key itself if its list becomes empty
+	auto erase = [](auto& map, const auto& key, const H2A::Dataset* dataset) {
+		auto entry = map.find(key);
+		if (entry == map.end()) return;
+		auto& datasets = entry->second;
+		datasets.erase(std::remove(datasets.begin(), datasets.end(), dataset), datasets.end());
+		if (datasets.empty()) map.erase(entry);
+	};
+
+	for (const auto& dataset : registered->second) {
+		erase(m_ByName, dataset->name, dataset);
+	}
+	m_ByFileUID.erase(datafile);
+	m_Registered.erase(registered);
+}
+
+/**
+* Returns the datasets with the given name from all datafiles.
+*
+* @param name Name to look up.
+**/
+const std::vector<H2A::Dataset*>& DatasetCatalog::findName(const std::string& name) const {
+	auto entry = m_ByName.find(name);
+	return (entry == m_ByName.end()) ? EMPTY : entry->second;
+}
+
+/**
+* Returns the dataset with the given UID in the given datafile, or a nullptr if it is not present.
+*
+* @param datafile Datafile to look in.
+* @param uid UID to look up.
+**/
+H2A::Dataset* DatasetCatalog::findUID(const H2A::Datafile* datafile, const uint32_t uid) const {
+	auto file = m_ByFileUID.find(datafile);
+	if (file == m_ByFileUID.end()) return nullptr;
+	auto entry = file->second.find(uid);
+	return (entry == file->second.end()) ? nullptr : entry->second;
+}
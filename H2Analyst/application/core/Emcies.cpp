@@ -1,4 +1,5 @@
 #include "Emcies.h"
+#include "EmcyCodes.h"
 
 /**
 * Function that converts the numerical severity value to a string with the readable severity.
@@ -43,59 +44,310 @@ void H2A::Emcy::readPayload(Emcy& emcy, const uint64_t& payload) {
 	emcy.severity = static_cast<H2A::Emcy::Severity>(static_cast<uint8_t>((payload >> 24) & 0xFF));
 }
 
-void H2A::Emcy::readEmcyCodesFromSettings(std::map<uint16_t, H2A::Emcy::Properties>& map, H2A::Car car) {
-	map.clear();
+void H2A::Emcy::readPayload(Record& record, const uint64_t& payload) {
+	record.code = payload & 0xFFFF;
+	record.severity = static_cast<H2A::Emcy::Severity>(static_cast<uint8_t>((payload >> 24) & 0xFF));
+}
 
-	QString fileName;
+/**
+* Merge time-sorted streams of EMCYs (one per source) into a single time-sorted list, by a k-way merge on a heap of the next
+* EMCY of every stream. EMCYs at the same time are kept in the order of their streams.
+*
+* @param streams Time-sorted EMCYs per source.
+* @param include Function that returns if an EMCY is added to the merged list.
+**/
+std::vector<H2A::Emcy::Record> H2A::Emcy::merge(const std::vector<std::vector<Record>>& streams, const std::function<bool(const Record&)>& include) {
+	size_t total = 0;
+	for (const auto& stream : streams) total += stream.size();
+	std::vector<Record> merged;
+	merged.reserve(total);
 
-	switch (car) {
-	case H2A::Car::Forze8:
-		fileName = F8_EMCY_FILE;
-		break;
-	case H2A::Car::Forze9:
-		fileName = F9_EMCY_FILE;
-		break;
+	// Heap of (stream, position) of the next EMCY of every stream, with the earliest EMCY on top
+	using Head = std::pair<size_t, size_t>;
+	auto later = [&](const Head& lhs, const Head& rhs) {
+		const double lt = streams[lhs.first][lhs.second].time;
+		const double rt = streams[rhs.first][rhs.second].time;
+		return (lt != rt) ? lt > rt : lhs.first > rhs.first;
+	};
+	std::priority_queue<Head, std::vector<Head>, decltype(later)> heads(later);
+	for (size_t i = 0; i < streams.size(); ++i)
+		if (!streams[i].empty()) heads.push({ i, 0 });
+
+	while (!heads.empty()) {
+		const Head head = heads.top();
+		heads.pop();
+		const Record& record = streams[head.first][head.second];
+		if (include(record)) merged.push_back(record);
+		if (head.second + 1 < streams[head.first].size()) heads.push({ head.first, head.second + 1 });
+	}
+	return merged;
+}
+
+namespace
+{
+	constexpr bool sorted(const H2A::Emcy::Properties* begin, const H2A::Emcy::Properties* end) {
+		for (auto it = begin; it + 1 < end; ++it)
+			if (!(it->code < (it + 1)->code)) return false;
+		return true;
 	}
+	static_assert(sorted(std::begin(H2A::Emcy::F8_CODES), std::end(H2A::Emcy::F8_CODES)), "F8 EMCY definitions are not sorted on code");
+	static_assert(sorted(std::begin(H2A::Emcy::F9_CODES), std::end(H2A::Emcy::F9_CODES)), "F9 EMCY definitions are not sorted on code");
+}
+
+/**
+* EMCY definitions, from compiled definitions and an optional file with overrides.
+*
+* @param begin First compiled definition, which are sorted on code.
+* @param end End of the compiled definitions.
+* @param overrideFile File with definitions that replace or add to the compiled definitions, which is ignored if it does not exist.
+**/
+H2A::Emcy::Definitions::Definitions(const Properties* begin, const Properties* end, const QString& overrideFile) :
+m_Begin(begin),
+m_End(end)
+{
+	QFile file(overrideFile);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return;
+
+	std::cout << "Loading EMCY definitions from " << overrideFile.toStdString() << std::endl;
+
+	std::map<uint16_t, Properties> overrides;
+	QTextStream in(&file);
+	std::string line;
+	while (!in.atEnd()) {
+		line = in.readLine().toStdString();
+
+		if (line.size() < 5) continue;
+
+		// Split line based on delimiter ';'
+		std::vector<std::string> split_line;
+		boost::split(split_line, line, boost::is_any_of(";"));
 
-	std::cout << "Loading EMCY definitions from " << fileName.toStdString() << std::endl;
+		H2A::Emcy::Properties properties = {};
 
-	QFile file(fileName);
-	if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-		QTextStream in(&file);
-		std::string line;
-		while (!in.atEnd()) {
-			line = in.readLine().toStdString();
+		// Emcy code
+		std::stringstream ss;
+		ss << std::hex << StrOps::trim_copy(split_line[0]);
+		if (!(ss >> properties.code)) continue;
 
-			if (line.size() < 5) continue;
+		// Text
+		m_Texts.push_back(split_line.size() > 1 ? StrOps::trim_copy(split_line[1]) : "");
+		properties.text = m_Texts.back();
 
-			// Split line based on delimiter ';'
-			std::vector<std::string> split_line;
-			boost::split(split_line, line, boost::is_any_of(";"));
+		// Hide flag (if this is set, the EMCY will not be shown in the EMCY list)
+		properties.hide = split_line.size() > 2 && StrOps::trim_copy(split_line[2]) == "hide";
 
-			H2A::Emcy::Properties properties;
-			uint16_t code;
+		if (overrides.find(properties.code) != overrides.end()) {
+			H2A::logWarning("Duplicate EMCY codes defined. Please check the EMCY codes definition.");
+		}
+		overrides[properties.code] = properties;
+	}
+	file.close();
 
-			// Emcy code
-			std::stringstream ss;
-			ss << std::hex << StrOps::trim_copy(split_line[0]);
-			ss >> code;
+	// Merge the sorted compiled definitions with the sorted overrides, of which the overrides take precedence
+	auto it = overrides.begin();
+	for (auto compiled = begin; compiled < end || it != overrides.end();) {
+		if (it == overrides.end() || (compiled < end && compiled->code < it->first)) {
+			m_Merged.push_back(*compiled++);
+			continue;
+		}
+		if (compiled < end && compiled->code == it->first) ++compiled;
+		m_Merged.push_back((it++)->second);
+	}
+	m_Begin = m_Merged.data();
+	m_End = m_Merged.data() + m_Merged.size();
+}
 
-			// Text
-			properties.text = StrOps::trim_copy(split_line[1]);
+/**
+* Definition of an EMCY code, found by binary search, or nullptr if the code is not defined.
+*
+* @param code EMCY code.
+**/
+const H2A::Emcy::Properties* H2A::Emcy::Definitions::find(uint16_t code) const {
+	auto it = std::lower_bound(m_Begin, m_End, code, [](const Properties& properties, uint16_t c) { return properties.code < c; });
+	return (it != m_End && it->code == code) ? it : nullptr;
+}
 
-			// Hide flag (if this is set, the EMCY will not be shown in the EMCY list)
-			properties.hide = StrOps::trim_copy(split_line[2]) == "hide";
+/**
+* EMCY definitions of a car. The definitions are created on first use, after which they are kept for the rest of the session.
+* Overrides in the settings folder are therefore read once per car.
+*
+* @param car Car to get the EMCY definitions of.
+**/
+const H2A::Emcy::Definitions& H2A::Emcy::definitions(H2A::Car car) {
+	static std::map<H2A::Car, std::unique_ptr<Definitions>> cache;
+	static QMutex mutex;
+	QMutexLocker lock(&mutex);
+
+	auto& definitions = cache[car];
+	if (!definitions) {
+		const QDir settings(SettingsManager::settingsFolder());
+		switch (car) {
+		case H2A::Car::Forze8:
+			definitions = std::make_unique<Definitions>(std::begin(F8_CODES), std::end(F8_CODES), settings.filePath(F8_EMCY_FILE));
+			break;
+		case H2A::Car::Forze9:
+			definitions = std::make_unique<Definitions>(std::begin(F9_CODES), std::end(F9_CODES), settings.filePath(F9_EMCY_FILE));
+			break;
+		}
+	}
+	return *definitions;
+}
+
+namespace
+{
+	// Severity bucket in the index, severities that are not defined are counted as Unknown
+	size_t bucket(H2A::Emcy::Severity severity) {
+		return std::min<size_t>(severity, H2A::Emcy::Unknown);
+	}
+}
 
-			//std::cout << std::hex << code << std::dec << "; " << properties.text << "; " << properties.hide << std::endl;
+/**
+* Index of the EMCYs of the EMCY datasets of a datafile. The datasets are decoded in parallel and merged on time, after
+* which the positions per code and per severity are filled in by a counting sort, so they stay in time order.
+*
+* @param datasets Populated EMCY datasets, of which every dataset is a source.
+**/
+H2A::Emcy::Index::Index(const std::vector<const H2A::Dataset*>& datasets) {
+	for (const auto& dataset : datasets) {
+		std::vector<std::string> str_split;
+		boost::split_regex(str_split, dataset->name, boost::regex("EMCY"));
+		m_Sources.push_back(StrOps::trim_copy(str_split.back()));
+	}
 
-			// Add code with description to map for later reference.
-			// First check if this code does not already exist in map.
-			if (map.find(code) != map.end()) {
-				H2A::logWarning("Duplicate EMCY codes defined. Please check the EMCY codes definition.");
-			}
-			map[code] = properties;
+	std::vector<std::vector<Record>> streams(datasets.size());
+	std::vector<size_t> indices(datasets.size());
+	std::iota(indices.begin(), indices.end(), 0);
+	std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t i) {
+		const H2A::Dataset* dataset = datasets[i];
+		const auto timeVec = dataset->timeVec();
+		auto& emcies = streams[i];
+		emcies.resize(std::min(timeVec.size(), dataset->byteVec.size()));
+		for (size_t j = 0; j < emcies.size(); ++j) {
+			readPayload(emcies[j], static_cast<uint64_t>(dataset->byteVec[j]));
+			emcies[j].time = timeVec[j];
+			emcies[j].source = static_cast<uint16_t>(i);
 		}
-		file.close();
+	});
+	m_Emcies = merge(streams, [](const Record&) { return true; });
+
+	// Count the EMCYs per code and per severity, of which the counts are turned into offsets
+	std::vector<uint32_t> next(std::numeric_limits<uint16_t>::max() + 1, 0);
+	m_SeverityOffsets.fill(0);
+	for (const auto& emcy : m_Emcies) {
+		++next[emcy.code];
+		++m_SeverityOffsets[bucket(emcy.severity) + 1];
+	}
+	m_CodeOffsets.push_back(0);
+	for (size_t code = 0; code < next.size(); ++code) {
+		if (next[code] == 0) continue;
+		const uint32_t count = next[code];
+		next[code] = m_CodeOffsets.back();
+		m_Codes.push_back(static_cast<uint16_t>(code));
+		m_CodeOffsets.push_back(m_CodeOffsets.back() + count);
+	}
+	std::partial_sum(m_SeverityOffsets.begin(), m_SeverityOffsets.end(), m_SeverityOffsets.begin());
+
+	auto nextSeverity = m_SeverityOffsets;
+	m_ByCode.resize(m_Emcies.size());
+	m_BySeverity.resize(m_Emcies.size());
+	for (uint32_t i = 0; i < m_Emcies.size(); ++i) {
+		m_ByCode[next[m_Emcies[i].code]++] = i;
+		m_BySeverity[nextSeverity[bucket(m_Emcies[i].severity)]++] = i;
+	}
+}
+
+/**
+* Positions of the EMCYs with a code, in time order.
+*
+* @param code EMCY code.
+**/
+H2A::Emcy::Index::Positions H2A::Emcy::Index::occurrences(uint16_t code) const {
+	auto it = std::lower_bound(m_Codes.begin(), m_Codes.end(), code);
+	if (it == m_Codes.end() || *it != code) return { m_ByCode.data(), m_ByCode.data() };
+	const size_t i = it - m_Codes.begin();
+	return { m_ByCode.data() + m_CodeOffsets[i], m_ByCode.data() + m_CodeOffsets[i + 1] };
+}
+
+/**
+* Positions of the EMCYs with a severity, in time order. Severities that are not defined are found as Unknown.
+*
+* @param severity EMCY severity.
+**/
+H2A::Emcy::Index::Positions H2A::Emcy::Index::occurrences(Severity severity) const {
+	const size_t i = bucket(severity);
+	return { m_BySeverity.data() + m_SeverityOffsets[i], m_BySeverity.data() + m_SeverityOffsets[i + 1] };
+}
+
+/**
+* Range of positions of the EMCYs in a time window, found by binary search.
+*
+* @param tStart Start of the time window.
+* @param tEnd End of the time window, which is included.
+**/
+std::pair<uint32_t, uint32_t> H2A::Emcy::Index::range(double tStart, double tEnd) const {
+	auto first = std::lower_bound(m_Emcies.begin(), m_Emcies.end(), tStart, [](const Record& emcy, double t) { return emcy.time < t; });
+	auto last = std::upper_bound(first, m_Emcies.end(), tEnd, [](double t, const Record& emcy) { return t < emcy.time; });
+	return { static_cast<uint32_t>(first - m_Emcies.begin()), static_cast<uint32_t>(last - m_Emcies.begin()) };
+}
+
+/**
+* Positions of the EMCYs that match a filter, in time order. The candidates are the positions of the codes in the filter,
+* or else of the severities in the filter, limited to the time window. Without codes and severity all EMCYs in the time
+* window are candidates.
+*
+* @param filter Criteria of the EMCYs to select.
+**/
+std::vector<uint32_t> H2A::Emcy::Index::filter(const Filter& filter) const {
+	const auto window = this->range(filter.tStart, filter.tEnd);
+	auto accept = [&](uint32_t position) {
+		const Record& emcy = m_Emcies[position];
+		return emcy.severity >= filter.minSeverity
+			&& (filter.source < 0 || emcy.source == filter.source)
+			&& (filter.hidden.empty() || !filter.hidden[emcy.code]);
+	};
+
+	std::vector<Positions> candidates;
+	if (!filter.codes.empty()) {
+		std::set<uint16_t> codes(filter.codes.begin(), filter.codes.end());
+		for (const auto& code : codes) candidates.push_back(this->occurrences(code));
+	}
+	else if (filter.minSeverity > None) {
+		for (size_t severity = bucket(filter.minSeverity); severity <= Unknown; ++severity)
+			candidates.push_back(this->occurrences(static_cast<Severity>(severity)));
 	}
 
+	std::vector<uint32_t> positions;
+	if (candidates.empty()) {
+		positions.reserve(window.second - window.first);
+		for (uint32_t i = window.first; i < window.second; ++i)
+			if (accept(i)) positions.push_back(i);
+		return positions;
+	}
+
+	size_t total = 0;
+	for (auto& candidate : candidates) {
+		candidate.first = std::lower_bound(candidate.first, candidate.second, window.first);
+		candidate.second = std::lower_bound(candidate.first, candidate.second, window.second);
+		total += candidate.second - candidate.first;
+	}
+	positions.reserve(total);
+	for (const auto& candidate : candidates)
+		for (auto it = candidate.first; it != candidate.second; ++it)
+			if (accept(*it)) positions.push_back(*it);
+
+	// The positions of several codes or severities are each in time order, but not together
+	if (candidates.size() > 1) std::sort(positions.begin(), positions.end());
+	return positions;
+}
+
+/**
+* EMCY datasets of a datafile.
+*
+* @param datafile Datafile to get the EMCY datasets of.
+**/
+std::vector<const H2A::Dataset*> H2A::Emcy::datasets(const H2A::Datafile* datafile) {
+	std::vector<const H2A::Dataset*> datasets;
+	for (const auto& dataset : datafile->datasets)
+		if (dataset->datatype == DATATYPE) datasets.push_back(dataset);
+	return datasets;
 }
@@ -50,9 +50,12 @@ H2Analyst::H2Analyst(QWidget* parent)
     // Connect signals to slots
     connect(m_PbHidePanel, SIGNAL(clicked()), this, SLOT(hideSidePanel()));
     connect(m_DataStore, SIGNAL(fileLoaded()), m_DataPanel, SLOT(updateData()));
+    connect(m_DataStore, &DataStore::timeCorrected, m_PlotManager, &PlotManager::timeCorrected);
+    connect(m_DataStore, &DataStore::datasetChanged, m_PlotManager, &PlotManager::datasetChanged);
     connect(m_ControlPanel, SIGNAL(pbLoad()), this, SLOT(openFiles()));
     connect(m_ControlPanel, SIGNAL(pbPlotLayout()), m_PlotManager, SLOT(setPlotLayoutDialog()));
     connect(m_ControlPanel, SIGNAL(pbExport()), this, SLOT(exportDatasets()));
+    connect(m_PlotManager, &PlotManager::exportRequested, this, &H2Analyst::exportDatasets);
     connect(m_ControlPanel, SIGNAL(setTimeAlignEnable(bool)), m_PlotManager, SLOT(setTimeAlignEnabled(bool)));
     connect(m_ControlPanel, SIGNAL(setTimeCursorEnable(bool)), m_PlotManager, SLOT(setTimeCursorEnabled(bool)));
     connect(m_ControlPanel, SIGNAL(setTimeCursorTime(double)), m_PlotManager, SLOT(setTimeCursorTime(double)));
@@ -90,13 +93,71 @@ void H2Analyst::hideSidePanel()
 }
 
 
-void H2Analyst::exportDatasets()
+/**
+* Export datasets to a CSV, Arrow or MAT-file chosen by the user, either resampled or at their native timestamps, over their full
+* extent or a time range. A datafile can also be exported as a car log, e.g. to save a merged or trimmed log. The export runs in a separate thread, showing its progress in a dialog from which it can be canceled.
+*
+* @param source Plot of which the datasets are exported over its visible range, or nullptr to export the selected datasets.
+**/
+void H2Analyst::exportDatasets(AbstractPlot* source)
 {
-    const std::vector<const H2A::Dataset*> datasets = m_DataPanel->getSelectedDatasets();
-    for (const auto& dataset : datasets) {
-        if (!dataset->populated) m_DataPanel->requestDatasetPopulation(dataset, true);
+    const std::vector<const H2A::Dataset*> datasets = source ? source->datasets() : m_DataPanel->getSelectedDatasets();
+    if (datasets.empty()) {
+        H2A::Dialog::message("No datasets selected. Please select the datasets to export.");
+        return;
+    }
+
+    DialogExport settingsDialog(m_ExportSettings, this);
+    QCPRange view;
+    if (source) settingsDialog.setVisibleRange(source->xAxis->range().lower, source->xAxis->range().upper, true);
+    else if (m_PlotManager->visibleTimeRange(view)) settingsDialog.setVisibleRange(view.lower, view.upper);
+    if (m_PlotManager->timeCursorEnabled()) settingsDialog.setCursorTime(m_PlotManager->timeCursorTime());
+    if (settingsDialog.exec() != QDialog::Accepted) return;
+    const H2A::Export::Settings settings = settingsDialog.settings();
+    m_ExportSettings = settings;
+
+    // A car log is written from the messages of a single datafile, the datasets only select the datafile
+    const bool log = settings.format == H2A::ExportFormat::IntCanLog;
+    if (log && std::any_of(datasets.begin(), datasets.end(), [&](const H2A::Dataset* dataset) { return dataset->datafile != datasets.front()->datafile; })) {
+        H2A::Dialog::message("Datasets of multiple datafiles selected. Please select datasets of a single datafile to export it as car log.");
+        return;
+    }
+    if (log && datasets.front()->datafile->message_ids == nullptr) {
+        H2A::Dialog::message("The datafile of the selected datasets contains no messages to export.");
+        return;
     }
-    H2A::Export::CSV(datasets, "test.csv");
+
+    QString filter = "CSV file (*.csv)";
+    if (settings.format == H2A::ExportFormat::Arrow) filter = "Arrow/Feather file (*.arrow *.feather)";
+    else if (settings.format == H2A::ExportFormat::MAT || log) filter = "MAT-file (*.mat)";
+    const QString filename = QFileDialog::getSaveFileName(this, "Export datasets", "", filter);
+    if (filename.isEmpty()) return;
+
+    if (!log) m_DataPanel->requestDatasetPopulation(datasets, true);
+
+    QProgressDialog* dialog = new QProgressDialog("Exporting datasets...", "Cancel", 0, 100, this);
+    dialog->setWindowModality(Qt::WindowModal);
+    dialog->setMinimumDuration(500);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+
+    QThread* thread = new QThread();
+    ExportWorker* worker = new ExportWorker(datasets, filename.toStdString(), settings);
+    worker->moveToThread(thread);
+
+    connect(thread, &QThread::started, worker, &ExportWorker::run);
+    connect(worker, &ExportWorker::progress, dialog, &QProgressDialog::setValue);
+    connect(dialog, &QProgressDialog::canceled, worker, &ExportWorker::cancel, Qt::DirectConnection); // The worker thread is busy
+    connect(worker, &ExportWorker::finished, dialog, [=](bool success, const QString& error) {
+        // Closing the dialog emits canceled, while the worker is deleted after finishing
+        disconnect(dialog, &QProgressDialog::canceled, nullptr, nullptr);
+        if (!success && !dialog->wasCanceled()) H2A::Dialog::message("Export failed. " + (error.isEmpty() ? QString("Please check if the file is writable.") : error));
+        dialog->close();
+    });
+    connect(worker, &ExportWorker::finished, thread, &QThread::quit);
+    connect(worker, &ExportWorker::finished, worker, &ExportWorker::deleteLater);
+    connect(thread, &QThread::finished, thread, &QThread::deleteLater);
+
+    thread->start();
 }
 
 /**
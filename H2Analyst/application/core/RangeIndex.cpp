@@ -0,0 +1,158 @@
+#include "RangeIndex.h"
+
+/**
+* Builds the index. The time and data vectors are referenced, not copied, so they must outlive the index (or the
+* index must be rebuilt when they change).
+*
+* @param time Time vector of the signal (ascending).
+* @param data Data vector of the signal.
+**/
+void H2A::RangeIndex::build(const std::vector<double>& time, const std::vector<double>& data)
+{
+	m_Time = &time;
+	m_Data = &data;
+	m_Size = std::min(time.size(), data.size());
+	m_Blocks = (m_Size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+	m_Count.assign(m_Blocks + 1, 0);
+	m_Sum.assign(m_Blocks + 1, 0.0);
+	m_SumSq.assign(m_Blocks + 1, 0.0);
+	m_Integral.assign(m_Blocks + 1, 0.0);
+	m_Min.assign(2 * m_Blocks, std::numeric_limits<double>::infinity());
+	m_Max.assign(2 * m_Blocks, -std::numeric_limits<double>::infinity());
+
+	for (size_t b = 0; b < m_Blocks; ++b) {
+		WindowStats block;
+		double sumSq = 0.0, integral = 0.0;
+		const size_t first = b * BLOCK_SIZE;
+		const size_t last = std::min(first + BLOCK_SIZE, m_Size);
+		this->scan(first, last, block, sumSq);
+		this->scanIntegral(first, last, integral);
+
+		m_Count[b + 1] = m_Count[b] + block.count;
+		m_Sum[b + 1] = m_Sum[b] + (block.count > 0 ? block.mean * block.count : 0.0);
+		m_SumSq[b + 1] = m_SumSq[b] + sumSq;
+		m_Integral[b + 1] = m_Integral[b] + integral;
+		if (block.count > 0) {
+			m_Min[m_Blocks + b] = block.min;
+			m_Max[m_Blocks + b] = block.max;
+		}
+	}
+	for (size_t node = m_Blocks - 1; node > 0 && m_Blocks > 0; --node) {
+		m_Min[node] = std::min(m_Min[2 * node], m_Min[2 * node + 1]);
+		m_Max[node] = std::max(m_Max[2 * node], m_Max[2 * node + 1]);
+	}
+}
+
+/**
+* Clears the index, for instance when the data it refers to is replaced.
+**/
+void H2A::RangeIndex::clear()
+{
+	*this = RangeIndex();
+}
+
+/**
+* Returns the trapezoidal integral of the interval between datapoint i and i + 1 (0 if either is not finite).
+**/
+double H2A::RangeIndex::interval(size_t i) const
+{
+	const double a = (*m_Data)[i], b = (*m_Data)[i + 1];
+	if (!std::isfinite(a) || !std::isfinite(b)) return 0.0;
+	return 0.5 * (a + b) * ((*m_Time)[i + 1] - (*m_Time)[i]);
+}
+
+/**
+* Adds the datapoints in [first, last) to the statistics.
+*
+* @param first First datapoint.
+* @param last Datapoint after the last datapoint.
+* @param stats Statistics to update (count, min, max and mean, which is used as running sum).
+* @param sumSq Sum of squares to update.
+**/
+void H2A::RangeIndex::scan(size_t first, size_t last, WindowStats& stats, double& sumSq) const
+{
+	double sum = stats.count > 0 ? stats.mean * stats.count : 0.0;
+	for (size_t i = first; i < last; ++i) {
+		const double value = (*m_Data)[i];
+		if (!std::isfinite(value)) continue;
+		stats.min = stats.count > 0 ? std::min(stats.min, value) : value;
+		stats.max = stats.count > 0 ? std::max(stats.max, value) : value;
+		sum += value;
+		sumSq += value * value;
+		++stats.count;
+	}
+	if (stats.count > 0) stats.mean = sum / stats.count;
+}
+
+/**
+* Adds the intervals starting at the datapoints in [first, last) to the integral (the interval after the last datapoint
+* of the signal does not exist).
+**/
+void H2A::RangeIndex::scanIntegral(size_t first, size_t last, double& integral) const
+{
+	last = std::min(last, m_Size - 1);
+	for (size_t i = first; i < last; ++i)
+		integral += this->interval(i);
+}
+
+/**
+* Computes the statistics of the signal over a time window.
+*
+* @param tStart Start of window.
+* @param tEnd End of window.
+* @param stats Object to store statistics in.
+**/
+bool H2A::RangeIndex::query(double tStart, double tEnd, WindowStats& stats) const
+{
+	stats = WindowStats();
+	if (!this->built() || m_Size == 0 || tEnd < tStart) return false;
+
+	// Datapoints in window [first, last)
+	const auto timeBegin = m_Time->begin();
+	const size_t first = std::lower_bound(timeBegin, timeBegin + m_Size, tStart) - timeBegin;
+	const size_t last = std::upper_bound(timeBegin, timeBegin + m_Size, tEnd) - timeBegin;
+	if (first >= last) return false;
+
+	// Partial blocks at the edges are scanned, full blocks in between are taken from the index
+	const size_t firstBlock = (first + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	const size_t lastBlock = last / BLOCK_SIZE;
+	double sumSq = 0.0, integral = 0.0;
+
+	if (firstBlock >= lastBlock) {
+		this->scan(first, last, stats, sumSq);
+		this->scanIntegral(first, last - 1, integral);
+	}
+	else {
+		this->scan(first, firstBlock * BLOCK_SIZE, stats, sumSq);
+		this->scan(lastBlock * BLOCK_SIZE, last, stats, sumSq);
+		this->scanIntegral(first, firstBlock * BLOCK_SIZE, integral);
+		this->scanIntegral(lastBlock * BLOCK_SIZE, last - 1, integral);
+
+		const size_t count = m_Count[lastBlock] - m_Count[firstBlock];
+		if (count > 0) {
+			double min = std::numeric_limits<double>::infinity();
+			double max = -std::numeric_limits<double>::infinity();
+			for (size_t lo = firstBlock + m_Blocks, hi = lastBlock + m_Blocks; lo < hi; lo /= 2, hi /= 2) {
+				if (lo & 1) { min = std::min(min, m_Min[lo]); max = std::max(max, m_Max[lo]); ++lo; }
+				if (hi & 1) { --hi; min = std::min(min, m_Min[hi]); max = std::max(max, m_Max[hi]); }
+			}
+
+			const double sum = (stats.count > 0 ? stats.mean * stats.count : 0.0) + m_Sum[lastBlock] - m_Sum[firstBlock];
+			stats.min = stats.count > 0 ? std::min(stats.min, min) : min;
+			stats.max = stats.count > 0 ? std::max(stats.max, max) : max;
+			stats.count += count;
+			stats.mean = sum / stats.count;
+		}
+		sumSq += m_SumSq[lastBlock] - m_SumSq[firstBlock];
+
+		// The last full block also holds the interval to the first datapoint after it, which is only part of the window if that datapoint is
+		integral += m_Integral[lastBlock] - m_Integral[firstBlock];
+		if (lastBlock * BLOCK_SIZE == last && last < m_Size) integral -= this->interval(last - 1);
+	}
+
+	if (stats.count == 0) return false;
+	stats.rms = std::sqrt(sumSq / stats.count);
+	stats.integral = integral;
+	return true;
+}
@@ -45,4 +45,11 @@ void SettingsManager::checkFolders() {
 **/
 void SettingsManager::resetAllToDefault() {
 	this->checkFolders();
-}
\ No newline at end of file
+}
+
+/**
+* Path of the folder with the settings files of the user, which is a subfolder of the application folder.
+**/
+QString SettingsManager::settingsFolder() {
+	return QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).filePath("Settings");
+}
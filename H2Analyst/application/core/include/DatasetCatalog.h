@@ -0,0 +1,31 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "DataStructures.h"
+
+/**
+* Index of the datasets of all loaded datafiles, allowing constant time lookups by name and by UID within a datafile.
+**/
+class DatasetCatalog
+{
+
+	std::unordered_map<std::string, std::vector<H2A::Dataset*>> m_ByName;
+	std::unordered_map<const H2A::Datafile*, std::unordered_map<uint32_t, H2A::Dataset*>> m_ByFileUID;
+	std::unordered_map<const H2A::Datafile*, std::vector<H2A::Dataset*>> m_Registered;
+
+	static const std::vector<H2A::Dataset*> EMPTY;
+
+public:
+
+	void add(const H2A::Datafile* datafile);
+	void remove(const H2A::Datafile* datafile);
+	bool contains(const H2A::Datafile* datafile) const { return m_Registered.find(datafile) != m_Registered.end(); };
+
+	const std::vector<H2A::Dataset*>& findName(const std::string& name) const;
+	H2A::Dataset* findUID(const H2A::Datafile* datafile, const uint32_t uid) const;
+
+};
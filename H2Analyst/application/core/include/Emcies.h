@@ -2,25 +2,42 @@
 
 #include "Namespace.h"
 #include "StringOperations.h"
+#include "SettingsManager.h"
+#include "DataStructures.h"
 
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
+#include <deque>
+#include <memory>
+#include <string_view>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <execution>
+#include <queue>
+#include <functional>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <filesystem>
 #include <boost/algorithm/string.hpp>
+#include <boost/algorithm/string/regex.hpp>
 #include <QFile>
 #include <QTextStream>
+#include <QMutex>
 
 namespace H2A
 {
 	namespace Emcy
 	{
 
-		static QString F8_EMCY_FILE = ":/data/emcy-codes-f8";
-		static QString F9_EMCY_FILE = ":/data/emcy-codes-f9";
+		// Files in the settings folder of which the definitions override the compiled EMCY definitions
+		static QString F8_EMCY_FILE = "emcy_codes_f8.txt";
+		static QString F9_EMCY_FILE = "emcy_codes_f9.txt";
+
+		const uint32_t DATATYPE = 10; // Datatype of the EMCY datasets of a datafile
 
 		enum Severity : uint8_t { None = 0, Event = 1, Anomaly = 2, Notice = 3, Inhibiting = 4, Critical = 5, Panic = 6, Unknown = 7 };
 		std::string getSeverityStr(H2A::Emcy::Severity severity);
@@ -28,7 +45,8 @@ namespace H2A
 		enum Level { System, FC, HighSide, Traction, LowSide, LV };
 
 		struct Properties {
-			std::string text;
+			uint16_t code;
+			std::string_view text;
 			bool hide;
 		};
 
@@ -46,7 +64,85 @@ namespace H2A
 		};
 		void readPayload(Emcy& emcy, const uint64_t& payload);
 
-		void readEmcyCodesFromSettings(std::map<uint16_t, H2A::Emcy::Properties>& emcyMap, H2A::Car car);
+		// Compact EMCY as stored in the EMCY list, of which the source refers to the list of sources of the list
+		struct Record {
+			double time;
+			uint16_t code;
+			H2A::Emcy::Severity severity;
+			uint16_t source;
+
+			bool operator < (const Record& rhs) const {
+				return time < rhs.time;
+			}
+		};
+		void readPayload(Record& record, const uint64_t& payload);
+		std::vector<Record> merge(const std::vector<std::vector<Record>>& streams, const std::function<bool(const Record&)>& include);
+
+		/**
+		* EMCY definitions of a car, sorted on code. The definitions are compiled in (generated from the emcy_codes files in
+		* default_settings) and can be overridden per code by the emcy_codes file of the car in the settings folder.
+		**/
+		class Definitions
+		{
+			std::vector<Properties> m_Merged; // Compiled definitions with the overrides, empty if there are no overrides
+			std::deque<std::string> m_Texts; // Texts of the overrides, to which the merged definitions refer
+			const Properties* m_Begin;
+			const Properties* m_End;
+
+		public:
+			Definitions(const Properties* begin, const Properties* end, const QString& overrideFile);
+			Definitions(const Definitions&) = delete;
+			Definitions& operator=(const Definitions&) = delete;
+
+			const Properties* find(uint16_t code) const;
+			size_t size() const { return static_cast<size_t>(m_End - m_Begin); };
+		};
+		const Definitions& definitions(H2A::Car car);
+
+		/**
+		* Selection of EMCYs in an index. Codes, severity and time window are looked up in the index, the other criteria are
+		* checked for the EMCYs that are found.
+		**/
+		struct Filter {
+			std::vector<uint16_t> codes; // Codes to select, all codes if empty
+			Severity minSeverity = None;
+			int source = -1; // Source to select, all sources if negative
+			double tStart = -std::numeric_limits<double>::infinity();
+			double tEnd = std::numeric_limits<double>::infinity();
+			std::vector<bool> hidden; // Flags per code of the codes that are left out, none if empty
+		};
+
+		/**
+		* Index of the EMCYs of a datafile: all EMCYs (also hidden ones) in one time-sorted array, with the positions of the
+		* EMCYs per code and per severity. Positions are stored in time order, so the EMCYs of a code in a time window are a range
+		* of positions that is found by binary search, and filtering only visits the EMCYs that can match.
+		**/
+		class Index
+		{
+			std::vector<Record> m_Emcies;
+			std::vector<std::string> m_Sources; // Names of the sources, to which the EMCYs refer
+
+			// Positions per code (sorted on code) and per severity, stored back to back with the start of each code and severity
+			std::vector<uint16_t> m_Codes;
+			std::vector<uint32_t> m_CodeOffsets;
+			std::vector<uint32_t> m_ByCode;
+			std::array<uint32_t, Unknown + 2> m_SeverityOffsets;
+			std::vector<uint32_t> m_BySeverity;
+
+		public:
+			using Positions = std::pair<const uint32_t*, const uint32_t*>;
+
+			Index(const std::vector<const H2A::Dataset*>& datasets);
+
+			const std::vector<Record>& emcies() const { return m_Emcies; };
+			const std::vector<std::string>& sources() const { return m_Sources; };
+			const std::vector<uint16_t>& codes() const { return m_Codes; };
+			Positions occurrences(uint16_t code) const;
+			Positions occurrences(Severity severity) const;
+			std::pair<uint32_t, uint32_t> range(double tStart, double tEnd) const;
+			std::vector<uint32_t> filter(const Filter& filter) const;
+		};
+		std::vector<const H2A::Dataset*> datasets(const H2A::Datafile* datafile);
 	}
 }
 
@@ -0,0 +1,697 @@
+#pragma once
+
+// Generated from data/default_settings/emcy_codes_f8.txt and emcy_codes_f9.txt by generate_emcy_codes.ps1, do not edit.
+
+#include "Emcies.h"
+
+namespace H2A
+{
+	namespace Emcy
+	{
+
+		// EMCY definitions per car, sorted on code
+		inline constexpr Properties F8_CODES[] = {
+			{ 0x1000, "Driver: Up Command", false },
+			{ 0x1001, "Driver: Down Command", false },
+			{ 0x1002, "Logging Stopped", false },
+			{ 0x1003, "Logging Restarted", false },
+			{ 0x1004, "ACC ENERGY TOO LOW", false },
+			{ 0x1005, "RADIO STILL ON", false },
+			{ 0x1006, "RELEASE THROTTLE", false },
+			{ 0x1007, "APPLY BRAKE PRESSURE", false },
+			{ 0x100A, "Diagnostic Trigger 0", false },
+			{ 0x100B, "Diagnostic Trigger 1", false },
+			{ 0x100C, "Diagnostic Trigger 2", false },
+			{ 0x100D, "Diagnostic Trigger 3", false },
+			{ 0x100E, "Diagnostic Trigger 4", false },
+			{ 0x100F, "Diagnostic Trigger 5", false },
+			{ 0x4000, "Node overtemperature", false },
+			{ 0x4001, "Node temp warning", false },
+			{ 0x5000, "Chk Throttle Sensor 1", false },
+			{ 0x5001, "Chk Throttle Sensor 2", false },
+			{ 0x5002, "Chk Brake Pres Rear", false },
+			{ 0x5003, "Chk Steer Angle PS", false },
+			{ 0x5004, "Chk Steer Angle Shaft", false },
+			{ 0x5005, "Chk H2 Comp Front", false },
+			{ 0x5006, "Chk H2 Comp Rear", false },
+			{ 0x5007, "Chk Tank Front Temp", false },
+			{ 0x5008, "Chk Tank Front Pres", false },
+			{ 0x5009, "Chk Tank Rear Temp", false },
+			{ 0x500A, "Chk Tank Rear Pres", false },
+			{ 0x500B, "Chk Rad Righ Temp In", false },
+			{ 0x500C, "Chk Rad Righ Temp Out", false },
+			{ 0x500D, "Chk Rad Left Temp In", false },
+			{ 0x500E, "Chk Rad Left Temp Out", false },
+			{ 0x500F, "Chk FC H2 RTH In", false },
+			{ 0x5010, "Chk FC H2 Pres In", false },
+			{ 0x5011, "Chk FC H2 RTH Out", false },
+			{ 0x5012, "Chk FC H2 Pres Out", false },
+			{ 0x5013, "Chk LPB H2 Pres Front", false },
+			{ 0x5014, "Chk LPB H2 Pres Rear", false },
+			{ 0x5015, "Chk Prop Valve Temp", false },
+			{ 0x5016, "Chk LPB MFC Temp", false },
+			{ 0x5017, "Chk Castle Temp", false },
+			{ 0x5018, "Chk Recirc Vicor Temp", false },
+			{ 0x5019, "Chk Recirc Vicor Crnt", false },
+			{ 0x501A, "Chk FC Air RTH In", false },
+			{ 0x501B, "Chk FC Air RTH Out", false },
+			{ 0x501C, "Chk FC Air Pres In", false },
+			{ 0x501D, "Chk FC Air pres Out", false },
+			{ 0x501E, "Chk Comp Air Massflow", false },
+			{ 0x501F, "Chk Comp Air RTH In", false },
+			{ 0x5020, "Chk Comp Air Temp Out", false },
+			{ 0x5021, "Chk Comp Air Pres Out", false },
+			{ 0x5022, "Chk Comp Air Pres In", false },
+			{ 0x5023, "Chk Exhaust RTH Out", false },
+			{ 0x5024, "Chk LSJB Temp", false },
+			{ 0x5025, "Chk LSJB Isense", false },
+			{ 0x5026, "Chk LSJB Isense Ref", false },
+			{ 0x5027, "Chk HSJB Temp", false },
+			{ 0x5028, "Chk HSJB Isense", false },
+			{ 0x5029, "Chk HSJB Isense Ref", false },
+			{ 0x502A, "Chk FC Cool Temp In", false },
+			{ 0x502B, "Chk FC Cool Pres In", false },
+			{ 0x502C, "Chk FC Cool Temp Out", false },
+			{ 0x502D, "Chk FC Cool Pres Out", false },
+			{ 0x502E, "Chk FC RadR Temp Out", false },
+			{ 0x502F, "Chk FC RadL Temp Out", false },
+			{ 0x5030, "Chk FC Pump Pres Out", false },
+			{ 0x5031, "Chk Sevcon Temp In", false },
+			{ 0x5032, "Chk Sevcon Pres In", false },
+			{ 0x5033, "Chk Sevcon Temp Out", false },
+			{ 0x5034, "Chk Sevcon Pres Out", false },
+			{ 0x5035, "Chk Brusa Temp In", false },
+			{ 0x5036, "Chk Brusa Pres In", false },
+			{ 0x5037, "Chk Bruvcon Pump Pres", false },
+			{ 0x5038, "Chk Ac Cool Temp In", false },
+			{ 0x5039, "Chk Acc Cool Pres In", false },
+			{ 0x503A, "Chk Acc Cool Temp Out", false },
+			{ 0x503B, "Chk Acc Cool Pres Out", false },
+			{ 0x503C, "Chk Acc Pump Pres Out", false },
+			{ 0x503D, "Chk AP Motor Temp In", false },
+			{ 0x503E, "Chk AP Motor Pres In", false },
+			{ 0x503F, "Chk AP Motor Temp Out", false },
+			{ 0x5040, "Chk AP Motor Pres Out", false },
+			{ 0x5041, "Chk AP Pump Pres Out", false },
+			{ 0x5042, "Chk AP Rad Temp Out", false },
+			{ 0x5043, "Chk AP Rad Pres Out", false },
+			{ 0x5044, "Chk AP Brnch Temp Out", false },
+			{ 0x5045, "Chk Yasa Oil Temp In", false },
+			{ 0x5046, "Chk Yasa Oil Pres In", false },
+			{ 0x5047, "Chk Yasa Oil Temp Out", false },
+			{ 0x5048, "Chk Yasa Oil Pres Out", false },
+			{ 0x5049, "Chk Yasa Pump Pres", false },
+			{ 0x504A, "Chk Yasa HE Temp Out", false },
+			{ 0x504B, "Chk Yasa HE Pres Out", false },
+			{ 0x504C, "Chk Rotrex Temp In", false },
+			{ 0x504D, "Chk Rotrex Temp Out", false },
+			{ 0x504E, "Chk GB Oil Temp In", false },
+			{ 0x504F, "Chk GB Oil Temp Out", false },
+			{ 0x5050, "Chk GB Oil Pres In", false },
+			{ 0x6000, "EmbOS RTOS", false },
+			{ 0x6001, "EmbOS application", false },
+			{ 0x6002, "Stack almost full", false },
+			{ 0x6003, "Background starved", false },
+			{ 0x6004, "EEPROM timeout", false },
+			{ 0x6005, "Backgnd starved DAQ", false },
+			{ 0x8120, "CAN error passive", false },
+			{ 0x8140, "CAN busoff", false },
+			{ 0x8260, "CAN warning", false },
+			{ 0x8280, "CAN overrun", false },
+			{ 0xF000, "LV invalid command", false },
+			{ 0xF001, "LV command no effect", false },
+			{ 0xF002, "LV critical state", false },
+			{ 0xF003, "LV panic state", false },
+			{ 0xF004, "LV EMCY received", true },
+			{ 0xF005, "Dashboard HB lost", false },
+			{ 0xF006, "Lifeline cut", false },
+			{ 0xF007, "Lost backup pwr", false },
+			{ 0xF008, "PDU Vicor fault", false },
+			{ 0xF009, "PDU Vicor fault", false },
+			{ 0xF00A, "PDU Vicor fault", false },
+			{ 0xF00B, "Crashed. Still alive?", false },
+			{ 0xF00C, "Vicor overtemp.", false },
+			{ 0xF00D, "Vicor overtemp.", false },
+			{ 0xF00E, "Battery overcurrent", false },
+			{ 0xF00F, "Aux. overcurrent", false },
+			{ 0xF010, "24V undervoltage", false },
+			{ 0xF011, "24V overvoltage", false },
+			{ 0xF012, "Node P overcurrent", false },
+			{ 0xF013, "Node P fuse blown", false },
+			{ 0xF014, "Node S overcurrent", false },
+			{ 0xF015, "Node S fuse blown", false },
+			{ 0xF016, "F light overcurrent", false },
+			{ 0xF017, "F light fuse blown", false },
+			{ 0xF018, "Wiper overcurrent", false },
+			{ 0xF019, "Wiper fuse blown", false },
+			{ 0xF022, "Cool 1 overcurrent", false },
+			{ 0xF023, "Cool 1 fuse blown", false },
+			{ 0xF024, "Cool 2 overcurrent", false },
+			{ 0xF025, "Cool 2 fuse blown", false },
+			{ 0xF026, "Extra overcurrent", false },
+			{ 0xF027, "Extra fuse blown", false },
+			{ 0xF028, "Extra overcurrent", false },
+			{ 0xF029, "Extra fuse blown", false },
+			{ 0xF02A, "Extra overcurrent", false },
+			{ 0xF02B, "Extra fuse blown", false },
+			{ 0xF02C, "PDU DAC communication", false },
+			{ 0xF02D, "Startup battery empty", false },
+			{ 0xF02E, "R light overcurrent", false },
+			{ 0xF02F, "R Brake light overcur", false },
+			{ 0xF030, "R l indicator overcur", false },
+			{ 0xF031, "R r indicator overcur", false },
+			{ 0xF032, "F l indicator overcur", false },
+			{ 0xF033, "F r indicator overcur", false },
+			{ 0xF034, "F l indic reset fail", false },
+			{ 0xF035, "F r indic reset fail", false },
+			{ 0xF036, "F l indic reset fail", false },
+			{ 0xF037, "R light reset failed", false },
+			{ 0xF038, "R Brake light reset f", false },
+			{ 0xF039, "R l indic reset fail", false },
+			{ 0xF03A, "R r indic reset fail", false },
+			{ 0xF03B, "F pos light overcur", false },
+			{ 0xF03C, "F position reset fail", false },
+			{ 0xF03D, "R brake led overcur", false },
+			{ 0xF03E, "R brakeled reset fail", false },
+			{ 0xF03F, "Castle fan overcurr.", false },
+			{ 0xF040, "Rear tank fuse blown", false },
+			{ 0xF041, "Front tank fuse blown", false },
+			{ 0xF042, "FRONT SOLENOID PANIC!", false },
+			{ 0xF043, "REAR SOLENOID PANIC!", false },
+			{ 0xF044, "PDU FC Vicor Timeout", false },
+			{ 0xF045, "FC pump vicor overcur", false },
+			{ 0xF046, "FC pump vicor LS trip", false },
+			{ 0xF047, "Battery almost empty", false },
+			{ 0xF048, "F.Tank Sol no current", false },
+			{ 0xF049, "R.Tank Sol no current", false },
+			{ 0xF100, "HS invalid command", false },
+			{ 0xF101, "HS command no effect", false },
+			{ 0xF102, "HS critical state", false },
+			{ 0xF103, "HS panic state", false },
+			{ 0xF104, "HS EMCY received", true },
+			{ 0xF105, "Dashboard HB lost", false },
+			{ 0xF106, "HS precharge timeout", false },
+			{ 0xF107, "AMS current timeout", false },
+			{ 0xF108, "BRUSA communic. lost", false },
+			{ 0xF109, "BRUSA error", false },
+			{ 0xF10A, "HSJB lifeline cut", false },
+			{ 0xF10B, "HSJB interlock cut", false },
+			{ 0xF10C, "HS bus overvoltage", false },
+			{ 0xF10D, "HS bus voltage range", false },
+			{ 0xF10E, "HS ADS1118 communic.", false },
+			{ 0xF10F, "HSJB overtemperature", false },
+			{ 0xF110, "LEM CAB accumulator 1", false },
+			{ 0xF111, "LEM CAB accumulator 2", false },
+			{ 0xF112, "LEM CAB Sevcon 1", false },
+			{ 0xF113, "LEM CAB Sevcon 2", false },
+			{ 0xF114, "RTM light overcurrent", false },
+			{ 0xF115, "Acc. cool timeout", false },
+			{ 0xF116, "Acc. cool checksum", false },
+			{ 0xF117, "Acc. under pres.", false },
+			{ 0xF118, "Acc. over pres.", false },
+			{ 0xF119, "HS reset failed", false },
+			{ 0xF11A, "Acc. ZERO pres.", false },
+			{ 0xF11B, "Acc coolpump overtemp", false },
+			{ 0xF11C, "Acc coolpump overcurr", false },
+			{ 0xF11D, "Acc. coolpump blocked", false },
+			{ 0xF11E, "IMD resistance warn", false },
+			{ 0xF11F, "HSJB temp warning", false },
+			{ 0xF120, "IMD resistance low", false },
+			{ 0xF121, "ACC ESR high warning", false },
+			{ 0xF122, "BRUSA warning", false },
+			{ 0xF123, "ACC Balance Stopped", false },
+			{ 0xF180, "Acc. undervoltage", false },
+			{ 0xF181, "Acc. undervoltage", false },
+			{ 0xF182, "Acc. overvoltage", false },
+			{ 0xF183, "Acc. overtemperature", false },
+			{ 0xF184, "Acc. PEC error", false },
+			{ 0xF185, "Acc. SPI error", false },
+			{ 0xF186, "Acc. mux error", false },
+			{ 0xF187, "IMD critically low", false },
+			{ 0xF188, "HS acc. overvoltage", false },
+			{ 0xF189, "HS acc. voltage range", false },
+			{ 0xF18A, "RESS overcurrent", false },
+			{ 0xF18B, "HS cont. overcurrent", false },
+			{ 0xF18C, "HS cont. overcurrent", false },
+			{ 0xF18D, "HS cont. overcurrent", false },
+			{ 0xF200, "Traction invalid cmd", false },
+			{ 0xF201, "Trac cmd no effect", false },
+			{ 0xF202, "Traction crit. state", false },
+			{ 0xF203, "Traction panic state", false },
+			{ 0xF204, "Traction EMCY received", true },
+			{ 0xF205, "Dashboard HB lost", false },
+			{ 0xF206, "Traction reset failed", false },
+			{ 0xF207, "Throttle sig. invalid", false },
+			{ 0xF208, "Sevcon communication", false },
+			{ 0xF209, "Sevcon 1 EMCY", false },
+			{ 0xF20A, "Sevcon 2 EMCY", false },
+			{ 0xF20B, "Sevcon 1 HB lost", false },
+			{ 0xF20C, "Sevcon 2 HB lost", false },
+			{ 0xF20D, "Sevcon 1 timeout", false },
+			{ 0xF20E, "Sevcon 2 timeout", false },
+			{ 0xF20F, "YASA rotor overtemp.", false },
+			{ 0xF210, "YASA rotor overtemp.", false },
+			{ 0xF211, "YASA stator overtemp.", false },
+			{ 0xF212, "Sevcon overtemp.", false },
+			{ 0xF213, "YASA rotor overtemp.", false },
+			{ 0xF214, "YASA rotor overtemp.", false },
+			{ 0xF215, "YASA stator overtemp.", false },
+			{ 0xF216, "Sevcon overtemp.", false },
+			{ 0xF217, "Gearbox overtemp.", false },
+			{ 0xF218, "Gearbox overtemp.", false },
+			{ 0xF21B, "Bruvcon pump timeout", false },
+			{ 0xF21C, "Bruvcon pump checksum", false },
+			{ 0xF21D, "Yasa pump timeout", false },
+			{ 0xF21E, "Yasa pump checksum", false },
+			{ 0xF21F, "Gearbox under pres.", false },
+			{ 0xF220, "Gearbox over pres.", false },
+			{ 0xF221, "Bruvcon under pres.", false },
+			{ 0xF222, "Bruvcon over pres.", false },
+			{ 0xF223, "Yasa under pres.", false },
+			{ 0xF224, "Yasa under pres.", false },
+			{ 0xF225, "ABS timeout", false },
+			{ 0xF226, "ABS fault", false },
+			{ 0xF227, "GPS communication", false },
+			{ 0xF228, "GPS failure", false },
+			{ 0xF229, "GPS antenna", false },
+			{ 0xF22A, "GPS overcurrent", false },
+			{ 0xF22B, "SR control failed", false },
+			{ 0xF22C, "SR control restored", false },
+			{ 0xF22D, "ABS failed", false },
+			{ 0xF22E, "ABS restored", false },
+			{ 0xF22F, "Power steer failed", false },
+			{ 0xF230, "Power steer restored", false },
+			{ 0xF231, "Regen failed", false },
+			{ 0xF232, "Regen restored", false },
+			{ 0xF233, "TV failed", false },
+			{ 0xF234, "TV restored", false },
+			{ 0xF235, "Power steer timeout", false },
+			{ 0xF236, "Power steer overcurr.", false },
+			{ 0xF237, "Powersteer fuse blown", false },
+			{ 0xF238, "ABS overcurrent", false },
+			{ 0xF239, "ABS fuse blown", false },
+			{ 0xF23A, "Pos display overcurr", false },
+			{ 0xF23B, "Pos disp. fuse blown", false },
+			{ 0xF23C, "Powersteer overcurr.", false },
+			{ 0xF23D, "Power steer fault", false },
+			{ 0xF23E, "GB fan overcurrent", false },
+			{ 0xF23F, "GB fan fuse blown", false },
+			{ 0xF240, "Sevcon 1 Disabled", false },
+			{ 0xF241, "Sevcon 2 Disabled", false },
+			{ 0xF242, "GB Feed pump timeout", false },
+			{ 0xF243, "GB Feed pump checksum", false },
+			{ 0xF244, "GB Scav pump timeout", false },
+			{ 0xF245, "GB Scav pump checksum", false },
+			{ 0xF246, "Yasa R power fault", false },
+			{ 0xF247, "Yasa L power fault", false },
+			{ 0xF248, "Yasa R encoder fault", false },
+			{ 0xF249, "Yasa L encoder fault", false },
+			{ 0xF24A, "Sevcon 1 interlock", false },
+			{ 0xF24B, "Sevcon 2 interlock", false },
+			{ 0xF24C, "Gearbox ZERO pres.", false },
+			{ 0xF24D, "Bruvcon ZERO pres .", false },
+			{ 0xF24E, "Yasa ZERO pres.", false },
+			{ 0xF24F, "GB Feed pump overtemp", false },
+			{ 0xF250, "GB Feed pump overcur", false },
+			{ 0xF251, "GB Feed pump blocked", false },
+			{ 0xF252, "GB Scav pump overtemp", false },
+			{ 0xF253, "GB Scav pump overcur", false },
+			{ 0xF254, "GB Scav pump blocked", false },
+			{ 0xF255, "Bruvcon pump overtemp", false },
+			{ 0xF256, "Bruvcon pump overcurr", false },
+			{ 0xF257, "Bruvcon pump blocked", false },
+			{ 0xF258, "YASA pump overtemp", false },
+			{ 0xF259, "YASA pump overcurrent", false },
+			{ 0xF25A, "YASA pump blocked", false },
+			{ 0xF25B, "SAS diff too high", false },
+			{ 0xF25C, "GB Feed Pump Stopped", false },
+			{ 0xF25D, "GB Scav Pump Stopped", false },
+			{ 0xF300, "LS invalid command", false },
+			{ 0xF301, "LS command no effect", false },
+			{ 0xF302, "LS critical state", false },
+			{ 0xF303, "LS panic state", false },
+			{ 0xF304, "LS EMCY received", true },
+			{ 0xF305, "Dashboard HB lost", false },
+			{ 0xF306, "LS reset failed", false },
+			{ 0xF307, "LS precharge timeout", false },
+			{ 0xF308, "LSJB lifeline cut", false },
+			{ 0xF309, "LSJB interlock cut", false },
+			{ 0xF30A, "LS cont. overcurrent", false },
+			{ 0xF30B, "LS cont. overcurrent", false },
+			{ 0xF30C, "LS cont. overcurrent", false },
+			{ 0xF30D, "LEM CAB stack 1", false },
+			{ 0xF30E, "LEM CAB stack 2", false },
+			{ 0xF30F, "Stack overcurrent", false },
+			{ 0xF310, "LS ADS1118 communic.", false },
+			{ 0xF311, "LS bus overvoltage", false },
+			{ 0xF312, "LS bus voltage range", false },
+			{ 0xF313, "LS stack overvoltage", false },
+			{ 0xF314, "LS stackvoltage range", false },
+			{ 0xF315, "LSJB overtemperature", false },
+			{ 0xF31A, "BRUSA overtemperature", false },
+			{ 0xF31B, "BRUSA setpoint range", false },
+			{ 0xF31C, "BRUSA derating", false },
+			{ 0xF31D, "MF Set.Comm Err. 0", false },
+			{ 0xF31E, "MF Set.Comm Err. 1", false },
+			{ 0xF31F, "MF Set.Comm Err. 2", false },
+			{ 0xF320, "MF Set.Comm Err. 3", false },
+			{ 0xF321, "MF Set.Comm Err. 4", false },
+			{ 0xF322, "MF Set.Comm Err. 5", false },
+			{ 0xF323, "MF Set.Comm Err. 6", false },
+			{ 0xF324, "MF Set.Comm Err. 7", false },
+			{ 0xF400, "FC invalid command", false },
+			{ 0xF401, "FC command no effect", false },
+			{ 0xF402, "FC critical state", false },
+			{ 0xF403, "FC panic state", false },
+			{ 0xF404, "FC EMCY received", true },
+			{ 0xF405, "Dashboard HB lost", false },
+			{ 0xF406, "FC reset failed", false },
+			{ 0xF407, "Purge value invalid", false },
+			{ 0xF409, "H2 sensor front fault", false },
+			{ 0xF40A, "H2 sensor rear fault", false },
+			{ 0xF40D, "FC air in overpress.", false },
+			{ 0xF40E, "No air FC in press.", false },
+			{ 0xF40F, "Air FC in press. spec", false },
+			{ 0xF410, "Air FC in overtemp.", false },
+			{ 0xF411, "Air FC in undertemp.", false },
+			{ 0xF412, "Air FC in RH too low", false },
+			{ 0xF413, "Air FC in RH out spec", false },
+			{ 0xF414, "Air FC in MF too low", false },
+			{ 0xF415, "Air FC in MF spec.", false },
+			{ 0xF416, "Rotrex oil overtemp", false },
+			{ 0xF417, "H2 FC in overpress.", false },
+			{ 0xF418, "No H2 FC in press.", false },
+			{ 0xF419, "H2 FC in press. spec.", false },
+			{ 0xF41A, "H2 FC press drop low", false },
+			{ 0xF41B, "H2 FC press drop spec", false },
+			{ 0xF41C, "H2 FC press diff high", false },
+			{ 0xF41D, "H2 FC press diff low", false },
+			{ 0xF41E, "H2 FC press diff spec", false },
+			{ 0xF41F, "H2 FC in MF out spec.", false },
+			{ 0xF420, "H2 FC in RH too low", false },
+			{ 0xF421, "H2 FC in RH out spec.", false },
+			{ 0xF422, "H2 FC in overtemp.", false },
+			{ 0xF423, "H2 FC in undertemp.", false },
+			{ 0xF424, "H2 LPB F in overpress", false },
+			{ 0xF425, "No H2 LPB F in press", false },
+			{ 0xF426, "H2 LPB R in overpress", false },
+			{ 0xF427, "No H2 LPB R in press", false },
+			{ 0xF428, "Recirc. speed too low", false },
+			{ 0xF429, "Recircsupply overtemp", false },
+			{ 0xF42A, "Castle overtemp.", false },
+			{ 0xF42B, "FC cool in overtemp.", false },
+			{ 0xF42C, "FC cool out overtemp.", false },
+			{ 0xF42D, "FC cool temp. diff.", false },
+			{ 0xF42E, "FC cool dT warning", false },
+			{ 0xF42F, "FC cool dT out of ref", false },
+			{ 0xF430, "Stack undervoltage", false },
+			{ 0xF431, "Stack voltage spec.", false },
+			{ 0xF432, "FC startup timeout", false },
+			{ 0xF433, "AMK state timeout", false },
+			{ 0xF436, "H2 conc front high", false },
+			{ 0xF437, "H2 conc rear high", false },
+			{ 0xF438, "AMK overcurrent", false },
+			{ 0xF439, "AMK invalid setpoint", false },
+			{ 0xF43A, "AMK drive fault", false },
+			{ 0xF43B, "AMK timeout", false },
+			{ 0xF43C, "AMK motor overtemp.", false },
+			{ 0xF43D, "AMK IGBT overtemp.", false },
+			{ 0xF43E, "AMK inverter overtemp", false },
+			{ 0xF43F, "AMK unexp. disable", false },
+			{ 0xF440, "AMK drive warning", false },
+			{ 0xF441, "AMK CAN timeout", false },
+			{ 0xF442, "AMK pump timeout", false },
+			{ 0xF443, "AMK pump checksum", false },
+			{ 0xF444, "FC pump timeout", false },
+			{ 0xF445, "FC pump checksum", false },
+			{ 0xF446, "FC cool under pres.", false },
+			{ 0xF447, "FC cool over pres.", false },
+			{ 0xF448, "AMK cool under pres.", false },
+			{ 0xF449, "AMK cool over pres.", false },
+			{ 0xF44A, "H2 MFM unexp. status", false },
+			{ 0xF44B, "H2 MFM warning", false },
+			{ 0xF44C, "H2 MFM timeout", false },
+			{ 0xF44D, "H2 MFM commun. failed", false },
+			{ 0xF44E, "Bleed valve overcurr.", false },
+			{ 0xF44F, "Bleed valve overcurr.", false },
+			{ 0xF450, "EMCY valve overcurr.", false },
+			{ 0xF451, "Purge valve overcurr.", false },
+			{ 0xF452, "Stack fan overcurrent", false },
+			{ 0xF453, "Tank solenoid overcur", false },
+			{ 0xF454, "Tank solenoid overcur", false },
+			{ 0xF455, "Waste pump overcurr.", false },
+			{ 0xF456, "Waste pump fuse blown", false },
+			{ 0xF457, "FC fan R1 overcurrent", false },
+			{ 0xF458, "FC fan R1 fuse blown", false },
+			{ 0xF459, "FC fan R2 overcurrent", false },
+			{ 0xF45A, "FC fan R2 fuse blown", false },
+			{ 0xF45B, "FC fan L1 overcurrent", false },
+			{ 0xF45C, "FC fan L1 fuse blown", false },
+			{ 0xF45D, "Front tank empty", false },
+			{ 0xF45E, "Front tank near empty", false },
+			{ 0xF45F, "Rear tank empty", false },
+			{ 0xF460, "Rear tank near empty", false },
+			{ 0xF461, "Tanks empty", false },
+			{ 0xF462, "Tanks near empty", false },
+			{ 0xF463, "Invalid DCDC setpoint", false },
+			{ 0xF464, "FC RECOVER FAILED", false },
+			{ 0xF465, "FC cool ZERO pres.", false },
+			{ 0xF466, "AMK cool ZERO pres.", false },
+			{ 0xF467, "FC cool pump overtemp", false },
+			{ 0xF468, "FC cool pump overcurr", false },
+			{ 0xF469, "FC cool pump blocked", false },
+			{ 0xF46A, "AMK coolpump overtemp", false },
+			{ 0xF46B, "AMK coolpump overcurr", false },
+			{ 0xF46C, "AMK coolpump blocked", false },
+			{ 0xF46D, "FC pump vicors fault", false },
+			{ 0xF46E, "FC pump vicors temp", false },
+			{ 0xF46F, "Front tank not found", false },
+			{ 0xF470, "Rear tank not found", false },
+			{ 0xF471, "Using prev. tank mass", false },
+			{ 0xF472, "Tank line pres failed", false },
+			{ 0xF473, "Using est. tank mass", false },
+			{ 0xF474, "Front tank too cold", false },
+			{ 0xF475, "Rear tank too cold", false },
+			{ 0xF476, "Front tank cold warn", false },
+			{ 0xF477, "Rear tank cold warn", false },
+			{ 0xF478, "H2 Front CAN Timeout", false },
+			{ 0xF479, "F.Tank forced close", false },
+			{ 0xF500, "System EMCY received", true },
+			{ 0xF501, "High side HB lost", false },
+			{ 0xF502, "Low side HB lost", false },
+			{ 0xF503, "PDU HB lost", false },
+			{ 0xF504, "Anode HB lost", false },
+			{ 0xF505, "Cathode HB lost", false },
+			{ 0xF506, "Rear HB lost", false },
+			{ 0xF507, "Front HB lost", false },
+			{ 0xF508, "Data acq. HB lost", false },
+			{ 0xF509, "FC invalid state", false },
+			{ 0xF50A, "Trac invalid state", false },
+			{ 0xF50B, "HS invalid state", false },
+			{ 0xF50C, "LS invalid state", false },
+			{ 0xF50D, "LV invalid state", false },
+			{ 0xF50E, "Master invalid cmd", false },
+			{ 0xF50F, "Master cmd no effect", false },
+			{ 0xF510, "Master FSM timeout", false },
+			{ 0xF511, "Master command error", false },
+			{ 0xF512, "RTC battery empty", false },
+			{ 0xF513, "No SD card", false },
+			{ 0xF514, "FAT FS error", false },
+			{ 0xF515, "Logging overrun", false },
+			{ 0xF516, "Unknown EMCY", false },
+			{ 0xF517, "Watchdog boot timeout", false },
+			{ 0xF518, "Watchdog OS timeout", false },
+			{ 0xF519, "Dash setting timeout", false },
+			{ 0xFA00, "MCP message error", true },
+			{ 0xFA01, "MCP unexpected wakeup", true },
+			{ 0xFA02, "MCP error", true },
+			{ 0xFA03, "MCP message timeout", true },
+			{ 0xFA04, "MCP SPI timeout", true },
+			{ 0xFA05, "MCP overrun", true },
+			{ 0xFA06, "MCP illegal code exec", true },
+		};
+
+		inline constexpr Properties F9_CODES[] = {
+			{ 0x0001, "SW EMCY list outdated", false },
+			{ 0x1000, "Driver: Up Command", false },
+			{ 0x1001, "Driver: Down Command", false },
+			{ 0x1002, "Logging Stopped", false },
+			{ 0x1003, "Logging Restarted", false },
+			{ 0x1004, "Somewhat Generic EMCY", false },
+			{ 0x1005, "Sensor phys lim low", false },
+			{ 0x1006, "Sensor phys lim high", false },
+			{ 0x1007, "Sensor sys lim low", false },
+			{ 0x1008, "Sensor sys lim high", false },
+			{ 0x1009, "Sensor lost", false },
+			{ 0x100A, "Actuator lost", false },
+			{ 0x100B, "Node heartbeat lost", false },
+			{ 0x1100, "MFSM invalid command", false },
+			{ 0x1101, "MFSM cmd no effect", false },
+			{ 0x1102, "MFSM state timeout", false },
+			{ 0x1103, "MFSM inv. state entry", false },
+			{ 0x1200, "LVS FSM INV. CMD", false },
+			{ 0x1201, "LVS FSM CMD NO EFT.", false },
+			{ 0x1202, "LVS FSM crit. state", false },
+			{ 0x1203, "LVS FSM inv. state", false },
+			{ 0x1300, "RESS FSM INV. CMD", false },
+			{ 0x1301, "RESS FSM CMD NO EFT.", false },
+			{ 0x1302, "RESS FSM crit. state", false },
+			{ 0x1303, "RESS FSM inv. state", false },
+			{ 0x1400, "TRAC. FSM INV. CMD", false },
+			{ 0x1401, "TRAC. FSM CMD NO EFT.", false },
+			{ 0x1402, "TRAC. FSM crit. state", false },
+			{ 0x1403, "TRAC. FSM inv. state", false },
+			{ 0x1500, "FC FSM INV. CMD", false },
+			{ 0x1501, "FC FSM CMD NO EFT.", false },
+			{ 0x1502, "FC FSM crit. state", false },
+			{ 0x1503, "FC FSM inv. state", false },
+			{ 0x2000, "Node LS sw overcur", false },
+			{ 0x2001, "Node LS hw overcur", false },
+			{ 0x2002, "Node PWM overcurrent", false },
+			{ 0x2003, "Node PWM i2t overcur", false },
+			{ 0x2004, "Node Actuator undercu", false },
+			{ 0x3000, "Node LS overvoltage", false },
+			{ 0x3001, "Node LS undervoltage", false },
+			{ 0x3002, "Node PWM overvoltage", false },
+			{ 0x3003, "Node PWM undervoltage", false },
+			{ 0x3004, "Node wrong rail volt.", false },
+			{ 0x4000, "Node overtemperature", false },
+			{ 0x4001, "Node temp warning", false },
+			{ 0x4002, "Node LS overtemp", false },
+			{ 0x4003, "Node PWM overtemp", false },
+			{ 0x4004, "Tank temp too high", false },
+			{ 0x5000, "Rotary ADC Read Fail", false },
+			{ 0x6000, "EmbOS RTOS", false },
+			{ 0x6001, "EmbOS application", false },
+			{ 0x6002, "Stack almost full", false },
+			{ 0x6003, "Background starved", false },
+			{ 0x6004, "EEPROM timeout", false },
+			{ 0x6005, "Backgrnd starved DAQ", false },
+			{ 0x6006, "ADC calibration fail", false },
+			{ 0x6007, "USB init failed", false },
+			{ 0x6008, "Node LS init lockout", false },
+			{ 0x6009, "Analog overflow", false },
+			{ 0x600A, "Analog underlow", false },
+			{ 0x600B, "Analog ADC error", false },
+			{ 0x600C, "Analog HW error", false },
+			{ 0x600D, "Analog self protect", false },
+			{ 0x600E, "DIN startup error", false },
+			{ 0x600F, "Configuration error", false },
+			{ 0x8120, "CAN error passive", false },
+			{ 0x8140, "CAN busoff", false },
+			{ 0x8141, "CAN No Message Buffer", false },
+			{ 0x8142, "CAN RX Warning", false },
+			{ 0x8143, "CAN TX Warning", false },
+			{ 0x8250, "CAN rpdo timeout", false },
+			{ 0x8260, "CAN warning", false },
+			{ 0x8280, "CAN overrun", false },
+			{ 0x82A0, "DIN Dynamic PDO error", false },
+			{ 0xF001, "BL status error", false },
+			{ 0xF002, "BL Interlock error", false },
+			{ 0xF003, "BL overcurrent error", false },
+			{ 0xF010, "Vicor PreChar UnderV", false },
+			{ 0xF011, "BL PreCharge UnderV", false },
+			{ 0xF020, "BL LPO Wrong State", false },
+			{ 0xF021, "BL LPO LV UnderVolt", false },
+			{ 0xF022, "BL LPO HV UnderVolt", false },
+			{ 0xF023, "BL MPQ Wrong State", false },
+			{ 0xF024, "BL MPQ LV UnderVolt", false },
+			{ 0xF025, "BL MPQ HV UnderVolt", false },
+			{ 0xF100, "DCDC error", false },
+			{ 0xF101, "DCDC warning", false },
+			{ 0xF102, "DCDC derating", false },
+			{ 0xF103, "DCDC soft-lock", false },
+			{ 0xF104, "DCDC LV undercurrent", false },
+			{ 0xF105, "DCDC overtemperature", false },
+			{ 0xF106, "DCDC voltage level", false },
+			{ 0xF107, "DCDC soft disabled", false },
+			{ 0xF108, "DCDC too many resets", false },
+			{ 0xF109, "DCDC rate limiting", false },
+			{ 0xF170, "RESS EXT PrepPre tout", false },
+			{ 0xF171, "RESS EXT PrepChg tout", false },
+			{ 0xF172, "RESS Ext ChgCond fail", false },
+			{ 0xF173, "RESS Ext ShtdwnAccDis", false },
+			{ 0xF174, "RESS Ext Trip Trigger", false },
+			{ 0xF180, "RESS EXT Prechrg tout", false },
+			{ 0xF181, "RESS EXT Prechrg fail", false },
+			{ 0xF182, "RESS EXT AccV RngeExc", false },
+			{ 0xF183, "RESS Ext Short NegPol", false },
+			{ 0xF184, "RESS Ext Short PosPol", false },
+			{ 0xF185, "RESS Ext HV Interlock", false },
+			{ 0xF186, "RESS Ext Relay Fail", false },
+			{ 0xF195, "Acc. undervoltage crt", false },
+			{ 0xF196, "Acc. overvoltage crt", false },
+			{ 0xF197, "Acc. undervoltage wrn", false },
+			{ 0xF198, "Acc. overvoltage wrn", false },
+			{ 0xF199, "Acc. overtemperature", false },
+			{ 0xF19A, "Acc. PEC error", false },
+			{ 0xF19B, "Acc. SPI error", false },
+			{ 0xF19C, "Acc. mux error", false },
+			{ 0xF19D, "Acc. unresponsive", false },
+			{ 0xF19E, "Acc. Balance Stopped", false },
+			{ 0xF1A0, "IMD impedance too low", false },
+			{ 0xF1A1, "IMD undervoltage", false },
+			{ 0xF1A2, "IMD bad measurement", false },
+			{ 0xF1A3, "IMD device error", false },
+			{ 0xF1A4, "IMD connection fault", false },
+			{ 0xF1A5, "IMD PWM timeout", false },
+			{ 0xF1A6, "IMD status low", false },
+			{ 0xF1A7, "IMD required but off", false },
+			{ 0xF200, "EMS protection limits", false },
+			{ 0xF201, "TP protection limits", false },
+			{ 0xF202, "SH protection limits", false },
+			{ 0xF205, "Motor Mode set retry", false },
+			{ 0xF206, "MotorEnable set retry", false },
+			{ 0xF20F, "Failed Full Startup", false },
+			{ 0xF210, "Failed to Recover", false },
+			{ 0xF211, "Failed full shutdown", false },
+			{ 0xF212, "Failed norm. shutdown", false },
+			{ 0xF250, "Motor error", false },
+			{ 0xF251, "Motor warning", false },
+			{ 0xF252, "Motor ctrlmode change", false },
+			{ 0xF253, "Motor ctrlmode set", false },
+			{ 0xF254, "Motor invalid regen", false },
+			{ 0xF256, "Motor overtemperature", false },
+			{ 0xF257, "Motor dclink overvolt", false },
+			{ 0xF258, "Motor invalid state", false },
+			{ 0xF259, "Motor sw enable error", false },
+			{ 0xF25A, "Motor enable set err", false },
+			{ 0xF260, "Motorctrl startup err", false },
+			{ 0xF261, "Motorctrl hw enbl err", false },
+			{ 0xF262, "Motorctrl aux pwr err", false },
+			{ 0xF263, "Motorctrl CAN timeout", false },
+			{ 0xF270, "Throttle signal EMCY", false },
+			{ 0xF300, "Interlock signal high", false },
+			{ 0xF301, "Current sensor error", false },
+			{ 0xF302, "RJBL overtemperature", false },
+			{ 0xF400, "Left Comp Pump Error", false },
+			{ 0xF401, "H2 conc sensor error", false },
+			{ 0xF402, "H2 conc overtemp", false },
+			{ 0xF511, "RTC time was reset", false },
+			{ 0xF512, "RTC battery empty", false },
+			{ 0xF513, "No SD card", false },
+			{ 0xF514, "FAT FS error", false },
+			{ 0xF515, "Logging overrun", false },
+			{ 0xF516, "Unknown EMCY", false },
+			{ 0xF517, "Watchdog boot timeout", false },
+			{ 0xF518, "Watchdog OS timeout", false },
+			{ 0xF51A, "DIN Connector changed", false },
+			{ 0xF520, "Lifeline fail", false },
+			{ 0xF580, "Control FC HB missed", false },
+			{ 0xF581, "Control Trc HB missed", false },
+			{ 0xF582, "Data Acq HB missed", false },
+			{ 0xF583, "Data Telem HB missed", false },
+			{ 0xF584, "Init AB HB missed", false },
+			{ 0xF585, "Init CD HB missed", false },
+			{ 0xF586, "State Mchns HB missed", false },
+			{ 0xF590, "CPS HB missed", false },
+			{ 0xF600, "comp.inv sys error 1", false },
+			{ 0xF601, "comp.inv sys error 2", false },
+			{ 0xF602, "comp.inv tpdo1 err id", false },
+			{ 0xF603, "comp.inv powermod err", false },
+			{ 0xF604, "comp.inv system error", false },
+			{ 0xF605, "comp speed setpnt err", false },
+		};
+
+	}
+}
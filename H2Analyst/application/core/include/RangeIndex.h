@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace H2A
+{
+
+	/**
+	* Statistics of a signal over a time window.
+	**/
+	struct WindowStats
+	{
+		size_t count = 0; // Number of (finite) datapoints in window
+		double min = std::numeric_limits<double>::quiet_NaN();
+		double max = std::numeric_limits<double>::quiet_NaN();
+		double mean = std::numeric_limits<double>::quiet_NaN();
+		double rms = std::numeric_limits<double>::quiet_NaN();
+		double integral = 0.0; // Trapezoidal integral between the first and last datapoint in window
+	};
+
+	/**
+	* Index of a signal that answers statistics over any time window in O(log n). The signal is split in blocks
+	* of which the count, sum, sum of squares and integral are stored as prefix sums, and of which the min and max are
+	* stored in a segment tree. Only the partial blocks at the edges of a window are read from the data itself.
+	**/
+	class RangeIndex
+	{
+		static const size_t BLOCK_SIZE = 64;
+
+		const std::vector<double>* m_Time = nullptr;
+		const std::vector<double>* m_Data = nullptr;
+		size_t m_Size = 0;
+		size_t m_Blocks = 0;
+
+		std::vector<size_t> m_Count; // Prefix sums over blocks
+		std::vector<double> m_Sum;
+		std::vector<double> m_SumSq;
+		std::vector<double> m_Integral;
+		std::vector<double> m_Min; // Segment trees over blocks
+		std::vector<double> m_Max;
+
+		double interval(size_t i) const;
+		void scan(size_t first, size_t last, WindowStats& stats, double& sumSq) const;
+		void scanIntegral(size_t first, size_t last, double& integral) const;
+
+	public:
+		void build(const std::vector<double>& time, const std::vector<double>& data);
+		void clear();
+		bool built() const { return m_Time != nullptr; };
+		bool query(double tStart, double tEnd, WindowStats& stats) const;
+
+		// Blocks
+		static size_t blockSize() { return BLOCK_SIZE; };
+		size_t blocks() const { return m_Blocks; };
+		size_t blockCount(size_t block) const { return m_Count[block + 1] - m_Count[block]; };
+		double blockMin(size_t block) const { return m_Min[m_Blocks + block]; };
+		double blockMax(size_t block) const { return m_Max[m_Blocks + block]; };
+	};
+
+}
@@ -0,0 +1,22 @@
+#include "AlignWorker.h"
+#include "Populator.h"
+
+AlignWorker::AlignWorker(const H2A::Dataset* reference, const H2A::Dataset* target, double maxLag) : QObject(),
+	m_Reference(reference),
+	m_Target(target),
+	m_MaxLag(maxLag)
+{
+}
+
+/**
+* Wait until both datasets are populated and cross-correlate them. The correction is passed as offset and drift,
+* which finished carries to the GUI thread without registering a type.
+**/
+void AlignWorker::run() {
+	PopulatorWorker::waitPopulated(m_Reference);
+	PopulatorWorker::waitPopulated(m_Target);
+
+	H2A::Alignment::Correction correction;
+	const bool success = H2A::Alignment::fromCrossCorrelation(m_Reference, m_Target, m_MaxLag, correction);
+	emit finished(success, correction.offset, correction.drift);
+}
@@ -0,0 +1,142 @@
+#include "Binning.h"
+
+/**
+* Create histogram of a single dataset over its full duration.
+*
+* @param dataset Dataset to bin. It is referenced, so it must outlive the histogram.
+* @param bins Number of bins between the minimum and maximum of the dataset.
+**/
+H2A::Binning::Histogram::Histogram(const H2A::Dataset* dataset, size_t bins) :
+	m_Datafile(dataset->datafile),
+	m_Time(dataset->rawTimeVec().data()),
+	m_X(dataset->dataVec.data()),
+	m_Size(std::min(dataset->rawTimeVec().size(), dataset->dataVec.size())),
+	m_BinsX(std::max(bins, static_cast<size_t>(1)))
+{
+	m_MaxInterval = dataset->stats.medianInterval * H2A::DatasetStats::GAP_FACTOR;
+	this->setBinRange(dataset, m_LowerX, m_UpperX);
+	m_Counts.assign(m_BinsX, 0);
+	this->setFullWindow();
+}
+
+/**
+* Create two-dimensional histogram of two datasets over their overlapping time span. The datasets are resampled
+* (linear) on a common grid at the rate of the fastest dataset.
+*
+* @param datasetX Dataset on the X axis.
+* @param datasetY Dataset on the Y axis.
+* @param binsX Number of bins between the minimum and maximum of the X dataset.
+* @param binsY Number of bins between the minimum and maximum of the Y dataset.
+**/
+H2A::Binning::Histogram::Histogram(const H2A::Dataset* datasetX, const H2A::Dataset* datasetY, size_t binsX, size_t binsY) :
+	m_BinsX(std::max(binsX, static_cast<size_t>(1))),
+	m_BinsY(std::max(binsY, static_cast<size_t>(1)))
+{
+	const double frequency = std::max(H2A::samplingFreq(datasetX), H2A::samplingFreq(datasetY));
+	H2A::resampleOnOverlap({ datasetX, datasetY }, frequency, m_GridTime, m_GridData, H2A::ResampleMode::Linear);
+	if (m_GridData.size() == 2) {
+		m_Time = m_GridTime.data();
+		m_X = m_GridData[0].data();
+		m_Y = m_GridData[1].data();
+		m_Size = m_GridTime.size();
+		m_MaxInterval = m_Size > 1 ? m_GridTime[1] - m_GridTime[0] : 0.0;
+	}
+	this->setBinRange(datasetX, m_LowerX, m_UpperX);
+	this->setBinRange(datasetY, m_LowerY, m_UpperY);
+	m_Counts.assign(m_BinsX * m_BinsY, 0);
+	this->setFullWindow();
+}
+
+/**
+* Bins span the range of a dataset, which is widened for constant datasets.
+**/
+void H2A::Binning::Histogram::setBinRange(const H2A::Dataset* dataset, double& lower, double& upper) const {
+	lower = std::isfinite(dataset->stats.min) ? dataset->stats.min : 0.0;
+	upper = std::isfinite(dataset->stats.max) ? dataset->stats.max : 1.0;
+	if (upper <= lower) {
+		lower -= 0.5;
+		upper += 0.5;
+	}
+}
+
+/**
+* Returns the index of the first datapoint at or after the given (corrected) time.
+**/
+size_t H2A::Binning::Histogram::index(double time) const {
+	if (m_Datafile != nullptr) time = m_Datafile->rawTime(time);
+	return std::lower_bound(m_Time, m_Time + m_Size, time) - m_Time;
+}
+
+/**
+* Returns the bin of a datapoint, or -1 if it is not finite.
+**/
+long H2A::Binning::Histogram::bin(size_t i) const {
+	const double x = m_X[i];
+	if (!std::isfinite(x)) return -1;
+	const size_t binX = std::min(static_cast<size_t>(std::max((x - m_LowerX) / (m_UpperX - m_LowerX), 0.0) * m_BinsX), m_BinsX - 1);
+	if (m_Y == nullptr) return static_cast<long>(binX);
+
+	const double y = m_Y[i];
+	if (!std::isfinite(y)) return -1;
+	const size_t binY = std::min(static_cast<size_t>(std::max((y - m_LowerY) / (m_UpperY - m_LowerY), 0.0) * m_BinsY), m_BinsY - 1);
+	return static_cast<long>(binX + binY * m_BinsX);
+}
+
+/**
+* Returns the weight of a datapoint in ticks: the time until the next datapoint, limited to skip gaps in the data.
+**/
+int64_t H2A::Binning::Histogram::weight(size_t i) const {
+	if (i + 1 >= m_Size) return 0;
+	return std::llround(std::min(m_Time[i + 1] - m_Time[i], m_MaxInterval) / TICK);
+}
+
+/**
+* Add (sign 1) or remove (sign -1) the datapoints [first, last) to/from the histogram. Large ranges are split in
+* chunks that are binned in parallel into partial histograms, which are summed afterwards.
+**/
+void H2A::Binning::Histogram::accumulate(size_t first, size_t last, int64_t sign) {
+	if (last <= first) return;
+
+	const size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+	const size_t nChunks = std::min((last - first + CHUNK_SIZE - 1) / CHUNK_SIZE, 4 * threads);
+	std::vector<std::vector<int64_t>> partials(nChunks);
+	std::vector<size_t> chunks(nChunks);
+	std::iota(chunks.begin(), chunks.end(), 0);
+	std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](size_t c) {
+		std::vector<int64_t>& partial = partials[c];
+		partial.assign(m_Counts.size(), 0);
+		const size_t end = first + (last - first) * (c + 1) / nChunks;
+		for (size_t i = first + (last - first) * c / nChunks; i < end; ++i) {
+			const long b = this->bin(i);
+			if (b >= 0) partial[b] += this->weight(i);
+		}
+	});
+
+	for (const auto& partial : partials)
+		for (size_t b = 0; b < m_Counts.size(); ++b) m_Counts[b] += sign * partial[b];
+}
+
+/**
+* Set the time window that is binned. Only the datapoints that enter or leave the window are (un)binned, unless
+* the new window does not overlap the current window, in which case the histogram is rebuilt.
+*
+* @param tStart Start of the window.
+* @param tEnd End of the window.
+**/
+void H2A::Binning::Histogram::setWindow(double tStart, double tEnd) {
+	const size_t first = this->index(tStart);
+	const size_t last = std::max(this->index(tEnd), first);
+
+	if (first >= m_Last || last <= m_First) {
+		std::fill(m_Counts.begin(), m_Counts.end(), 0);
+		this->accumulate(first, last, 1);
+	}
+	else {
+		if (first < m_First) this->accumulate(first, m_First, 1);
+		if (first > m_First) this->accumulate(m_First, first, -1);
+		if (last > m_Last) this->accumulate(m_Last, last, 1);
+		if (last < m_Last) this->accumulate(last, m_Last, -1);
+	}
+	m_First = first;
+	m_Last = last;
+}
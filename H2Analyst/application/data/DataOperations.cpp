@@ -1,181 +1,375 @@
 #include "DataOperations.h"
 
 /**
-* Resample dataset to given frequency.
-* 
-* @param dataset Dataset to resample.
-* @param freq Frequency to resample data to.
-* @param timeResampled Vector to store resampled time.
-* @param dataResampled Vector to store resampled data.
-**/
-void H2A::resample(const H2A::Dataset* dataset, uint16_t freq, std::vector<double>& timeResampled, std::vector<double>& dataResampled)
-{
-	double dt = 1.0 / freq;
-	std::vector<double> timeVec = dataset->timeVec();
-	float duration = timeVec.back() - timeVec.front();
-	size_t nSteps = std::floor(duration / dt);
-	std::cout << nSteps << std::endl;
-
-	// Create resampled time vector
-	std::vector<double> time(nSteps, 0.0);
-	for (size_t step = 0; step < nSteps; ++step)
-		time[step] = step * dt;
-
-	std::vector<double> data(nSteps, 0.0);
-	size_t cursor = 1; // Start at 1 to prevent errors when setting data
-	for (size_t step = 0; step < nSteps; ++ step)
-	{
-		// Set cursor to first index where time in original data is later than current resampled index
-		while (timeVec[cursor] < time[step])
-		{
-			if (cursor < timeVec.size())
-				++cursor;
-			else
-				break;
-		}
+* Determine the first and last (corrected) time of a dataset. Time vectors are ascending, so only the ends are read.
+*
+* @param dataset Dataset to get time span of.
+* @param tStart Variable to store start time in.
+* @param tEnd Variable to store end time in.
+**/
+bool H2A::timeSpan(const H2A::Dataset* dataset, double& tStart, double& tEnd)
+{
+	const size_t n = std::min(dataset->rawTimeVec().size(), dataset->dataVec.size());
+	if (n == 0) return false;
+	tStart = dataset->time(0);
+	tEnd = dataset->time(n - 1);
+	return true;
+}
 
-		// Store previous datapoint in resampled data
-		data[step] = dataset->dataVec[cursor - 1];
+/**
+* Determine the time span in which all given datasets contain data.
+*
+* @param datasets Datasets to get overlap of.
+* @param tStart Variable to store start time of overlap in.
+* @param tEnd Variable to store end time of overlap in.
+**/
+bool H2A::timeOverlap(const std::vector<const H2A::Dataset*>& datasets, double& tStart, double& tEnd)
+{
+	if (datasets.empty()) return false;
+	tStart = -std::numeric_limits<double>::infinity();
+	tEnd = std::numeric_limits<double>::infinity();
+	for (const auto& dataset : datasets) {
+		double start, end;
+		if (!H2A::timeSpan(dataset, start, end)) return false;
+		tStart = std::max(tStart, start);
+		tEnd = std::min(tEnd, end);
 	}
+	return tEnd >= tStart;
+}
 
-	timeResampled = time;
-	dataResampled = data;
+/**
+* Determine the time span in which at least one of the given datasets contains data.
+*
+* @param datasets Datasets to get time span of.
+* @param tStart Variable to store start time in.
+* @param tEnd Variable to store end time in.
+**/
+bool H2A::timeUnion(const std::vector<const H2A::Dataset*>& datasets, double& tStart, double& tEnd)
+{
+	bool found = false;
+	tStart = std::numeric_limits<double>::infinity();
+	tEnd = -std::numeric_limits<double>::infinity();
+	for (const auto& dataset : datasets) {
+		double start, end;
+		if (!H2A::timeSpan(dataset, start, end)) continue;
+		tStart = std::min(tStart, start);
+		tEnd = std::max(tEnd, end);
+		found = true;
+	}
+	return found;
 }
 
 /**
-* Resample dataset to match given time vector.
+* Create an equidistant time vector from start to end time (both included when they fall on the grid).
 *
-* @param dataset Dataset to resample.
-* @param time Time vector to resample data with (must contain ascending timestamps).
-* @param dataResampled Vector to store resampled data.
+* @param tStart First time of grid.
+* @param tEnd Last time of grid.
+* @param frequency Frequency of grid.
+* @param time Vector to store grid in.
 **/
-void H2A::resample(const H2A::Dataset* dataset, std::vector<double> time, std::vector<double>& dataResampled, bool trimTime)
+void H2A::timeGrid(double tStart, double tEnd, double frequency, std::vector<double>& time)
 {
-	// Get start and end time of dataset to be resampled for checking
-	std::vector<double> timeVec = dataset->timeVec();
-	auto minMaxTime = std::minmax_element(timeVec.begin(), timeVec.end());
-	double tStart = *minMaxTime.first;
-	double tEnd = *minMaxTime.second;
+	time.clear();
+	if (frequency <= 0.0 || tEnd < tStart) return;
+	const double dt = 1.0 / frequency;
+	time.resize(static_cast<size_t>(std::floor((tEnd - tStart) * frequency + 1e-9)) + 1);
+	for (size_t step = 0; step < time.size(); ++step)
+		time[step] = tStart + step * dt;
+}
 
-	dataResampled = std::vector<double>(time.size(), 0.0);
+/**
+* Create resampler for a dataset. Time vectors of datasets must be ascending.
+*
+* @param dataset Dataset to resample.
+* @param mode How values between datapoints are determined.
+* @param fill Value for points before the first or after the last datapoint of the dataset.
+**/
+H2A::Resampler::Resampler(const H2A::Dataset* dataset, H2A::ResampleMode mode, double fill) :
+	m_Dataset(dataset),
+	m_Mode(mode),
+	m_Fill(fill)
+{
+	m_Size = std::min(dataset->rawTimeVec().size(), dataset->dataVec.size());
+	if (m_Size > 0) {
+		m_tStart = this->sampleTime(0);
+		m_tEnd = this->sampleTime(m_Size - 1);
+	}
+}
 
-	// Check if endTime in resampled time vector is after start time of dataset. If not, there is not data to resample
-	if (time.back() <= tStart) return;
+/**
+* Resample the next chunk of the time grid. Times must be ascending and later than the times of previous chunks.
+* Long grids are processed in blocks of RESAMPLE_CHUNK_SIZE points.
+*
+* @param time Times to resample on.
+* @param n Number of times.
+* @param result Buffer of at least n values to store resampled data in.
+* @param nextTime First time of the next chunk, or NO_DATA if this chunk ends the grid. Bounds the averaging interval of the last time.
+**/
+void H2A::Resampler::next(const double* time, size_t n, double* result, double nextTime)
+{
+	if (m_Size == 0) {
+		std::fill(result, result + n, m_Fill);
+		return;
+	}
+	if (m_Size == 1) { // Nothing to interpolate between
+		for (size_t step = 0; step < n; ++step)
+			result[step] = time[step] == m_tStart ? m_Dataset->dataVec.front() : m_Fill;
+		return;
+	}
 
-	// Skip to first datapoint that is after first dataset datapoint (in time)
-	size_t step = 0;
-	while (time[step] <= tStart)
-		++step;
+	// Grid that starts halfway the dataset: jump to its start instead of walking there
+	if (std::isnan(m_PrevTime) && n > 0) this->seek(time[0]);
 
-	// Trim away unset datapoints
-	if (trimTime) {
-		dataResampled.erase(dataResampled.begin(), dataResampled.begin() + step);
-		time.erase(time.begin(), time.begin() + step);
-		step = 0;
+	for (size_t offset = 0; offset < n; offset += H2A::RESAMPLE_CHUNK_SIZE) {
+		const size_t count = std::min(H2A::RESAMPLE_CHUNK_SIZE, n - offset);
+		if (m_Mode == H2A::ResampleMode::Average)
+			this->average(time + offset, count, result + offset, offset + count < n ? time[offset + count] : nextTime);
+		else
+			this->interpolate(time + offset, count, result + offset);
+		m_PrevTime = time[offset + count - 1];
 	}
+}
 
-	// Actual resampling
-	size_t cursor = 1; // Start at 1 instead of 0 to prevent errors when setting data using '[cursor - 1]'
-	while (true)
-	{
-		if (step >= time.size()) break; // End of time vector reached
-		if (time[step] >= tEnd) break; // End of dataset datapoints reached, rest of resampled data keeps their initial values
-
-		// Set cursor to first index where time in original data is later than current resampled index
-		while (timeVec[cursor] < time[step])
-		{
-			if (cursor < timeVec.size())
-				++cursor;
-			else
-				break;
-		}
+/**
+* Move to the first datapoint at or after the given time with a binary search.
+*
+* @param time Time to move to, should not be later than the start of the averaging interval of the first resampled time.
+**/
+void H2A::Resampler::seek(double time)
+{
+	size_t lower = 0;
+	size_t upper = m_Size;
+	while (lower < upper) {
+		const size_t mid = lower + (upper - lower) / 2;
+		if (this->sampleTime(mid) < time) lower = mid + 1;
+		else upper = mid;
+	}
+	m_Cursor = lower;
+	m_Lower = lower;
+}
 
-		// Store previous datapoint in resampled data
-		dataResampled[step] = dataset->dataVec[cursor - 1];
-		++step;
+/**
+* Find for every time the number of datapoints at or before that time. This is the only part of resampling
+* that depends on the previous point, so the interpolation itself can be done in a separate (vectorizable) loop.
+*
+* @param time Times to locate.
+* @param n Number of times.
+**/
+void H2A::Resampler::locate(const double* time, size_t n)
+{
+	m_Index.resize(n);
+	for (size_t step = 0; step < n; ++step) {
+		while (m_Cursor < m_Size && this->sampleTime(m_Cursor) <= time[step])
+			++m_Cursor;
+		m_Index[step] = m_Cursor;
 	}
 }
 
-void H2A::resample(const std::vector<const H2A::Dataset*> datasets, std::vector<double>& timeResampled, std::vector<std::vector<double>>& dataResampled, uint16_t frequency)
+/**
+* Resample chunk with zero-order hold, nearest or linear interpolation.
+*
+* @param time Times to resample on.
+* @param n Number of times.
+* @param result Buffer to store resampled data in.
+**/
+void H2A::Resampler::interpolate(const double* time, size_t n, double* result)
 {
-	std::vector<double> data;
-	uint16_t freq = frequency;
+	this->locate(time, n);
+
+	const double* t = m_Dataset->rawTimeVec().data();
+	const double* data = m_Dataset->dataVec.data();
+	const size_t last = m_Size - 1;
+	const double scale = 1.0 + m_Dataset->datafile->timeDrift;
+	const double offset = m_Dataset->datafile->timeOffset;
 
-	// Check if dataset vector is OK for this function
-	if (datasets.size() == 0) return;
-	if (datasets.size() < 2)
-	{
-		if (freq == 0)
-		{
-			dataResampled.push_back(datasets.front()->dataVec);
-			return;
+	switch (m_Mode) {
+	case H2A::ResampleMode::ZeroOrderHold:
+		for (size_t step = 0; step < n; ++step) {
+			const size_t i = m_Index[step];
+			result[step] = (i == 0 || time[step] > m_tEnd) ? m_Fill : data[i - 1];
 		}
-		else
-		{
-			H2A::resample(datasets.front(), freq, timeResampled, data);
-			dataResampled.push_back(data);
+		break;
+
+	case H2A::ResampleMode::Nearest:
+		for (size_t step = 0; step < n; ++step) {
+			const size_t i = std::clamp(m_Index[step], static_cast<size_t>(1), last); // Datapoint after time (i) and before (i - 1)
+			const bool next = (t[i] * scale + offset - time[step]) < (time[step] - (t[i - 1] * scale + offset));
+			result[step] = (time[step] < m_tStart || time[step] > m_tEnd) ? m_Fill : data[next ? i : i - 1];
 		}
-		return;
-	}
+		break;
 
-	// If no frequency is passed, use the lowest frequency of the supplied datasets
-	if (freq == 0)
-	{
-		freq = H2A::samplingFreq(datasets.front());
-		for (const auto& dataset : datasets)
-		{
-			freq = std::min({ freq, H2A::samplingFreq(dataset) });
+	case H2A::ResampleMode::Linear:
+		for (size_t step = 0; step < n; ++step) {
+			const size_t i = std::clamp(m_Index[step], static_cast<size_t>(1), last);
+			const double t0 = t[i - 1] * scale + offset;
+			const double t1 = t[i] * scale + offset;
+			const double w = t1 > t0 ? std::clamp((time[step] - t0) / (t1 - t0), 0.0, 1.0) : 0.0;
+			result[step] = (time[step] < m_tStart || time[step] > m_tEnd) ? m_Fill : data[i - 1] + w * (data[i] - data[i - 1]);
 		}
+		break;
+
+	default:
+		break;
 	}
+}
 
-	// If frequency calculation failed somehow, catch if before trying to continue
-	if (freq < 1)
-	{
-		std::cout << "Error: Invalid frequency calculated... aborting resample" << std::endl;
-		return;
+/**
+* Resample chunk by averaging all datapoints in the interval around each time (box filter), which suppresses aliasing
+* when downsampling. The interval spans half the distance to the neighbouring times, and is clamped to the time itself
+* at the start and end of the grid, where there is no neighbouring time. Intervals without datapoints, which happens
+* when upsampling, are linearly interpolated.
+*
+* @param time Times to resample on.
+* @param n Number of times.
+* @param result Buffer to store resampled data in.
+* @param nextTime Time that follows the chunk, or NO_DATA at the end of the grid.
+**/
+void H2A::Resampler::average(const double* time, size_t n, double* result, double nextTime)
+{
+	const double* data = m_Dataset->dataVec.data();
+	const size_t last = m_Size - 1;
+
+	for (size_t step = 0; step < n; ++step) {
+		if (time[step] < m_tStart || time[step] > m_tEnd) {
+			result[step] = m_Fill;
+			continue;
+		}
+
+		// Interval boundaries halfway to the previous and next time, the last interval of the grid includes its end
+		const double prev = step > 0 ? time[step - 1] : m_PrevTime;
+		const double next = step + 1 < n ? time[step + 1] : nextTime;
+		const double lower = std::isnan(prev) ? time[step] : 0.5 * (prev + time[step]);
+		const double upper = std::isnan(next) ? time[step] : 0.5 * (time[step] + next);
+		const bool closed = std::isnan(next);
+
+		while (m_Lower < m_Size && this->sampleTime(m_Lower) < lower) ++m_Lower;
+		m_Cursor = std::max(m_Cursor, m_Lower);
+		while (m_Cursor < m_Size && (this->sampleTime(m_Cursor) < upper || (closed && this->sampleTime(m_Cursor) == upper))) ++m_Cursor;
+
+		if (m_Cursor > m_Lower) {
+			double sum = 0.0;
+			for (size_t i = m_Lower; i < m_Cursor; ++i) sum += data[i];
+			result[step] = sum / (m_Cursor - m_Lower);
+		}
+		else {
+			// No datapoints in interval: interpolate between the datapoints around it
+			const size_t i = std::clamp(m_Lower, static_cast<size_t>(1), last);
+			const double t0 = this->sampleTime(i - 1);
+			const double t1 = this->sampleTime(i);
+			const double w = t1 > t0 ? std::clamp((time[step] - t0) / (t1 - t0), 0.0, 1.0) : 0.0;
+			result[step] = data[i - 1] + w * (data[i] - data[i - 1]);
+		}
 	}
+}
+
+/**
+* Resample dataset on given time vector.
+*
+* @param dataset Dataset to resample.
+* @param time Time vector to resample data on (must contain ascending timestamps).
+* @param result Buffer of at least time.size() values to store resampled data in.
+* @param mode How values between datapoints are determined.
+* @param fill Value for points before the first or after the last datapoint of the dataset.
+**/
+void H2A::resample(const H2A::Dataset* dataset, const std::vector<double>& time, double* result, H2A::ResampleMode mode, double fill)
+{
+	H2A::Resampler resampler(dataset, mode, fill);
+	resampler.next(time.data(), time.size(), result);
+}
+
+/**
+* Resample dataset on given time vector. The result vector is resized to the length of the time vector.
+*
+* @param dataset Dataset to resample.
+* @param time Time vector to resample data on (must contain ascending timestamps).
+* @param result Vector to store resampled data in.
+* @param mode How values between datapoints are determined.
+* @param fill Value for points before the first or after the last datapoint of the dataset.
+**/
+void H2A::resample(const H2A::Dataset* dataset, const std::vector<double>& time, std::vector<double>& result, H2A::ResampleMode mode, double fill)
+{
+	result.resize(time.size());
+	H2A::resample(dataset, time, result.data(), mode, fill);
+}
+
+/**
+* Resample multiple datasets on the same time vector. Datasets are resampled in parallel, each into its own column buffer.
+*
+* @param datasets Datasets to resample.
+* @param time Time vector to resample data on (must contain ascending timestamps).
+* @param columns Buffers of at least time.size() values, one per dataset.
+* @param mode How values between datapoints are determined.
+* @param fill Value for points where a dataset has no data.
+**/
+void H2A::resample(const std::vector<const H2A::Dataset*>& datasets, const std::vector<double>& time, const std::vector<double*>& columns, H2A::ResampleMode mode, double fill)
+{
+	std::vector<size_t> indices(std::min(datasets.size(), columns.size()));
+	std::iota(indices.begin(), indices.end(), 0);
+	std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t i) {
+		H2A::resample(datasets[i], time, columns[i], mode, fill);
+	});
+}
 
-	// First, the dataset overlap in time is calculated.
-	// This overlap is used to generate the new timevector that will be used for resampling.
-	std::vector<double> timeVec = datasets.front()->timeVec();
-	auto minMaxTime = std::minmax_element(timeVec.begin(),timeVec.end());
-	double tStart = *minMaxTime.first;
-	double tEnd = *minMaxTime.second;
-	for (size_t i = 1; i < datasets.size(); ++ i) // First dataset used to set initial values
-	{
-		std::vector<double> timeVec = datasets[i]->timeVec();
-		minMaxTime = std::minmax_element(timeVec.begin(), timeVec.end());
-		tStart = std::max({ tStart, *minMaxTime.first });
-		tEnd = std::min({ tEnd, *minMaxTime.second });
+/**
+* Resample multiple datasets on the same time vector. One column per dataset is created, existing columns are reused.
+*
+* @param datasets Datasets to resample.
+* @param time Time vector to resample data on (must contain ascending timestamps).
+* @param columns Vector to store resampled data in.
+* @param mode How values between datapoints are determined.
+* @param fill Value for points where a dataset has no data.
+**/
+void H2A::resample(const std::vector<const H2A::Dataset*>& datasets, const std::vector<double>& time, std::vector<std::vector<double>>& columns, H2A::ResampleMode mode, double fill)
+{
+	columns.resize(datasets.size());
+	std::vector<double*> buffers(datasets.size());
+	for (size_t i = 0; i < datasets.size(); ++i) {
+		columns[i].resize(time.size());
+		buffers[i] = columns[i].data();
 	}
+	H2A::resample(datasets, time, buffers, mode, fill);
+}
+
+/**
+* Resample multiple datasets on an equidistant time vector spanning the time in which all datasets contain data.
+*
+* @param datasets Datasets to resample.
+* @param frequency Frequency to resample to. If 0, the lowest sampling frequency of the datasets is used.
+* @param time Vector to store resampled time in.
+* @param columns Vector to store resampled data in, one column per dataset.
+* @param mode How values between datapoints are determined.
+**/
+bool H2A::resampleOnOverlap(const std::vector<const H2A::Dataset*>& datasets, double frequency, std::vector<double>& time, std::vector<std::vector<double>>& columns, H2A::ResampleMode mode)
+{
+	time.clear();
+	columns.assign(datasets.size(), std::vector<double>());
 
-	// Create time vector
-	size_t nSteps = std::floor((tEnd - tStart) * freq);
-	timeResampled = std::vector<double>(nSteps);
-	double dt = 1.0 / freq;
-	for (size_t step = 0; step < nSteps; ++step)
-		timeResampled[step] = tStart + dt * step;
-	
-	for (const auto& dataset : datasets)
-	{
-		H2A::resample(dataset, timeResampled, data); // time vector has already been set by preceding code
-		dataResampled.push_back(data);
+	double tStart, tEnd;
+	if (!H2A::timeOverlap(datasets, tStart, tEnd)) return false;
+
+	// If no frequency is passed, use the lowest frequency of the supplied datasets
+	if (frequency <= 0.0) {
+		frequency = std::numeric_limits<double>::infinity();
+		for (const auto& dataset : datasets)
+			frequency = std::min(frequency, H2A::samplingFreq(dataset));
 	}
-	return;
+	if (!std::isfinite(frequency) || frequency <= 0.0) {
+		H2A::logWarning("Invalid frequency calculated... aborting resample");
+		return false;
+	}
+
+	H2A::timeGrid(tStart, tEnd, frequency, time);
+	H2A::resample(datasets, time, columns, mode);
+	return true;
 }
 
 
 /**
-* Determine sampling frequency of dataset
+* Determine sampling frequency of dataset, based on the median interval between datapoints (so gaps in the data do not lower it).
 * 
 * @param dataset Dataset to find frequency of.
 **/
-uint16_t H2A::samplingFreq(const H2A::Dataset* dataset)
+double H2A::samplingFreq(const H2A::Dataset* dataset)
 {
-	// Assuming time vector might not be monotonically increasing
-	std::vector<double> timeVec = dataset->timeVec();
-	auto minMaxTime = std::minmax_element(timeVec.begin(), timeVec.end());
-	double duration = *minMaxTime.second - *minMaxTime.first;
-	return round(timeVec.size() / duration);
+	return dataset->stats.samplingFreq() / (1.0 + dataset->datafile->timeDrift);
 }
-
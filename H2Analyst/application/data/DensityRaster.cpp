@@ -0,0 +1,93 @@
+#include "DensityRaster.h"
+
+/**
+* Create raster of XY data. The datasets are resampled (linear) on a common grid over their overlapping time span.
+*
+* @param datasets X, Y and optionally color dataset.
+**/
+H2A::DensityRaster::DensityRaster(const std::vector<const H2A::Dataset*>& datasets)
+{
+	H2A::resampleOnOverlap(datasets, 0.0, m_Time, m_Columns, H2A::ResampleMode::Linear);
+	if (m_Columns.size() < 2) m_Time.clear();
+	m_Last = m_Time.size();
+}
+
+/**
+* Only render the datapoints within a time window.
+*
+* @param tStart Start of the window.
+* @param tEnd End of the window.
+**/
+void H2A::DensityRaster::setWindow(double tStart, double tEnd)
+{
+	m_First = std::lower_bound(m_Time.begin(), m_Time.end(), tStart) - m_Time.begin();
+	m_Last = std::max(static_cast<size_t>(std::upper_bound(m_Time.begin(), m_Time.end(), tEnd) - m_Time.begin()), m_First);
+}
+
+/**
+* Aggregate the datapoints into a raster that covers the given area. Chunks of datapoints are aggregated in parallel
+* into partial rasters, which are summed afterwards.
+*
+* @param xLower Lower bound of the X axis.
+* @param xUpper Upper bound of the X axis.
+* @param yLower Lower bound of the Y axis.
+* @param yUpper Upper bound of the Y axis.
+* @param width Number of pixels along X.
+* @param height Number of pixels along Y.
+* @param cells Vector to store the raster in (row-major, first row at yLower). Pixels without datapoints are NaN.
+**/
+void H2A::DensityRaster::render(double xLower, double xUpper, double yLower, double yUpper, size_t width, size_t height, std::vector<double>& cells) const
+{
+	const size_t nCells = width * height;
+	cells.assign(nCells, std::numeric_limits<double>::quiet_NaN());
+	if (nCells == 0 || m_Last <= m_First || xUpper <= xLower || yUpper <= yLower) return;
+
+	const double* x = m_Columns[0].data();
+	const double* y = m_Columns[1].data();
+	const double* z = this->hasColor() ? m_Columns[2].data() : nullptr;
+	const double scaleX = width / (xUpper - xLower);
+	const double scaleY = height / (yUpper - yLower);
+
+	const size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+	const size_t nChunks = std::clamp((m_Last - m_First) / CHUNK_SIZE, static_cast<size_t>(1), threads);
+	std::vector<std::vector<uint32_t>> counts(nChunks);
+	std::vector<std::vector<double>> sums(z != nullptr ? nChunks : 0);
+
+	std::vector<size_t> chunks(nChunks);
+	std::iota(chunks.begin(), chunks.end(), 0);
+	std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](size_t c) {
+		std::vector<uint32_t>& count = counts[c];
+		count.assign(nCells, 0);
+		if (z != nullptr) sums[c].assign(nCells, 0.0);
+
+		const size_t end = m_First + (m_Last - m_First) * (c + 1) / nChunks;
+		for (size_t i = m_First + (m_Last - m_First) * c / nChunks; i < end; ++i) {
+			// Points outside the area (and NaN) fail these comparisons
+			const double px = (x[i] - xLower) * scaleX;
+			const double py = (y[i] - yLower) * scaleY;
+			if (!(px >= 0.0 && px < width && py >= 0.0 && py < height)) continue;
+
+			const size_t cell = static_cast<size_t>(px) + static_cast<size_t>(py) * width;
+			if (z != nullptr) {
+				if (!std::isfinite(z[i])) continue;
+				sums[c][cell] += z[i];
+			}
+			++count[cell];
+		}
+	});
+
+	// Sum partial rasters row by row in parallel
+	std::vector<size_t> rows(height);
+	std::iota(rows.begin(), rows.end(), 0);
+	std::for_each(std::execution::par, rows.begin(), rows.end(), [&](size_t row) {
+		for (size_t cell = row * width; cell < (row + 1) * width; ++cell) {
+			uint32_t count = 0;
+			double sum = 0.0;
+			for (size_t c = 0; c < nChunks; ++c) {
+				count += counts[c][cell];
+				if (z != nullptr) sum += sums[c][cell];
+			}
+			if (count > 0) cells[cell] = z != nullptr ? sum / count : count;
+		}
+	});
+}
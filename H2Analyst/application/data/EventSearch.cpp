@@ -0,0 +1,194 @@
+#include "EventSearch.h"
+
+namespace
+{
+	enum class BlockState : uint8_t { False, True, Mixed };
+
+	/**
+	* State of a level condition over a block, determined from its min and max only.
+	**/
+	BlockState blockState(const H2A::Events::Condition& condition, size_t count, size_t size, double min, double max)
+	{
+		if (count < size) return BlockState::Mixed; // Block contains non-finite values, which never meet a condition
+		switch (condition.type) {
+		case H2A::EventCondition::Above:
+			if (min > condition.lower) return BlockState::True;
+			if (max <= condition.lower) return BlockState::False;
+			break;
+		case H2A::EventCondition::Below:
+			if (max < condition.lower) return BlockState::True;
+			if (min >= condition.lower) return BlockState::False;
+			break;
+		case H2A::EventCondition::InRange:
+		case H2A::EventCondition::OutOfRange: {
+			const bool inside = min >= condition.lower && max <= condition.upper;
+			const bool outside = max < condition.lower || min > condition.upper;
+			if (inside || outside) return (inside == (condition.type == H2A::EventCondition::InRange)) ? BlockState::True : BlockState::False;
+			break;
+		}
+		case H2A::EventCondition::InSet:
+			if (std::none_of(condition.values.begin(), condition.values.end(), [&](double v) { return v >= min && v <= max; })) return BlockState::False;
+			if (min == max) return BlockState::True;
+			break;
+		default:
+			break;
+		}
+		return BlockState::Mixed;
+	}
+
+	/**
+	* Evaluate a level condition on a range of datapoints. The loops are branch-free so the compiler can vectorize them.
+	**/
+	void evaluate(const H2A::Events::Condition& condition, const double* data, size_t n, char* flags)
+	{
+		const double lower = condition.lower;
+		const double upper = condition.upper;
+		switch (condition.type) {
+		case H2A::EventCondition::Above:
+			for (size_t i = 0; i < n; ++i) flags[i] = data[i] > lower;
+			break;
+		case H2A::EventCondition::Below:
+			for (size_t i = 0; i < n; ++i) flags[i] = data[i] < lower;
+			break;
+		case H2A::EventCondition::InRange:
+			for (size_t i = 0; i < n; ++i) flags[i] = (data[i] >= lower) & (data[i] <= upper);
+			break;
+		case H2A::EventCondition::OutOfRange:
+			for (size_t i = 0; i < n; ++i) flags[i] = (data[i] < lower) | (data[i] > upper);
+			break;
+		case H2A::EventCondition::InSet:
+			std::fill(flags, flags + n, 0);
+			for (const auto& value : condition.values)
+				for (size_t i = 0; i < n; ++i) flags[i] |= data[i] == value;
+			break;
+		default:
+			std::fill(flags, flags + n, 0);
+			break;
+		}
+	}
+
+	/**
+	* Find the index ranges [first, last) in which a level condition holds. Blocks of the range index in which the
+	* condition is the same for every datapoint are skipped without reading their data.
+	**/
+	void levelRanges(const H2A::Dataset* dataset, const H2A::Events::Condition& condition, std::vector<std::pair<size_t, size_t>>& ranges)
+	{
+		const double* data = dataset->dataVec.data();
+		const size_t size = std::min(dataset->rawTimeVec().size(), dataset->dataVec.size());
+		const H2A::RangeIndex& index = dataset->index;
+		const size_t blockSize = H2A::RangeIndex::blockSize();
+		const size_t blocks = index.built() ? index.blocks() : (size + blockSize - 1) / blockSize;
+
+		bool state = false;
+		size_t start = 0;
+		std::vector<char> flags(blockSize);
+		for (size_t b = 0; b < blocks; ++b) {
+			const size_t first = b * blockSize;
+			const size_t n = std::min(blockSize, size - first);
+
+			const BlockState uniform = index.built() ? blockState(condition, index.blockCount(b), n, index.blockMin(b), index.blockMax(b)) : BlockState::Mixed;
+			if (uniform != BlockState::Mixed) {
+				const bool value = uniform == BlockState::True;
+				if (value && !state) start = first;
+				if (!value && state) ranges.push_back({ start, first });
+				state = value;
+				continue;
+			}
+
+			evaluate(condition, data + first, n, flags.data());
+			for (size_t i = 0; i < n; ++i) {
+				const bool value = flags[i];
+				if (value == state) continue;
+				if (value) start = first + i;
+				else ranges.push_back({ start, first + i });
+				state = value;
+			}
+		}
+		if (state) ranges.push_back({ start, size });
+	}
+
+	/**
+	* Find the indices at which the value of a dataset changes. Blocks with a single value equal to the previous value are skipped.
+	**/
+	void changes(const H2A::Dataset* dataset, std::vector<size_t>& indices)
+	{
+		const double* data = dataset->dataVec.data();
+		const size_t size = std::min(dataset->rawTimeVec().size(), dataset->dataVec.size());
+		const H2A::RangeIndex& index = dataset->index;
+		const size_t blockSize = H2A::RangeIndex::blockSize();
+		const size_t blocks = index.built() ? index.blocks() : (size + blockSize - 1) / blockSize;
+
+		for (size_t b = 0; b < blocks; ++b) {
+			const size_t first = b * blockSize;
+			const size_t n = std::min(blockSize, size - first);
+			if (index.built() && first > 0 && index.blockCount(b) == n && index.blockMin(b) == index.blockMax(b) && data[first - 1] == index.blockMin(b))
+				continue;
+
+			for (size_t i = std::max(first, static_cast<size_t>(1)); i < first + n; ++i)
+				if (data[i] != data[i - 1] && !(std::isnan(data[i]) && std::isnan(data[i - 1]))) indices.push_back(i);
+		}
+	}
+}
+
+/**
+* Search a dataset for the intervals in which it meets a condition.
+*
+* @param dataset Dataset to search.
+* @param condition Condition to search for.
+* @param intervals Vector to append found intervals to, in order of time.
+**/
+void H2A::Events::search(const H2A::Dataset* dataset, const Condition& condition, std::vector<Interval>& intervals)
+{
+	const size_t size = std::min(dataset->rawTimeVec().size(), dataset->dataVec.size());
+	if (size == 0) return;
+	auto time = [&](size_t i) { return dataset->time(std::min(i, size - 1)); };
+
+	if (condition.type == H2A::EventCondition::Change) {
+		std::vector<size_t> indices;
+		changes(dataset, indices);
+		for (const auto& i : indices) intervals.push_back({ dataset, time(i), time(i) });
+		return;
+	}
+
+	// Edges are the starts (rising) or ends (falling) of the intervals above the threshold
+	Condition level = condition;
+	if (condition.type == H2A::EventCondition::RisingEdge || condition.type == H2A::EventCondition::FallingEdge)
+		level.type = H2A::EventCondition::Above;
+
+	std::vector<std::pair<size_t, size_t>> ranges;
+	levelRanges(dataset, level, ranges);
+	for (const auto& [first, last] : ranges) {
+		switch (condition.type) {
+		case H2A::EventCondition::RisingEdge:
+			if (first > 0) intervals.push_back({ dataset, time(first), time(first) });
+			break;
+		case H2A::EventCondition::FallingEdge:
+			if (last < size) intervals.push_back({ dataset, time(last), time(last) });
+			break;
+		default:
+			intervals.push_back({ dataset, time(first), time(last) });
+			break;
+		}
+	}
+}
+
+/**
+* Search multiple datasets in parallel for the intervals in which they meet a condition.
+*
+* @param datasets Datasets to search.
+* @param condition Condition to search for.
+* @param intervals Vector to store found intervals in, in order of start time.
+**/
+void H2A::Events::search(const std::vector<const H2A::Dataset*>& datasets, const Condition& condition, std::vector<Interval>& intervals)
+{
+	std::vector<std::vector<Interval>> results(datasets.size());
+	std::vector<size_t> indices(datasets.size());
+	std::iota(indices.begin(), indices.end(), 0);
+	std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t i) {
+		H2A::Events::search(datasets[i], condition, results[i]);
+	});
+
+	intervals.clear();
+	for (const auto& result : results) intervals.insert(intervals.end(), result.begin(), result.end());
+	std::stable_sort(intervals.begin(), intervals.end(), [](const Interval& a, const Interval& b) { return a.tStart < b.tStart; });
+}
@@ -0,0 +1,403 @@
+#include "Expression.h"
+
+/**
+* Recursive descent parser that emits the instructions of the formula in postfix order.
+**/
+struct H2A::Expression::Parser
+{
+	const std::string& text;
+	const Lookup& lookup;
+	Expression& expression;
+	size_t pos = 0;
+	std::string error;
+
+	Parser(const std::string& text, const Lookup& lookup, Expression& expression) : text(text), lookup(lookup), expression(expression) {}
+
+	void skipSpace() { while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos; }
+
+	bool accept(const std::string& token) {
+		skipSpace();
+		if (text.compare(pos, token.size(), token) != 0) return false;
+		pos += token.size();
+		return true;
+	}
+
+	bool fail(const std::string& message) {
+		if (error.empty()) error = message + " (at position " + std::to_string(pos + 1) + ")";
+		return false;
+	}
+
+	void emit(Op op, double value = 0.0, size_t input = 0) { expression.m_Program.push_back({ op, input, value }); }
+
+	bool parseExpression() { return parseOr(); }
+
+	bool parseOr() {
+		if (!parseAnd()) return false;
+		while (accept("||")) {
+			if (!parseAnd()) return false;
+			emit(Op::Or);
+		}
+		return true;
+	}
+
+	bool parseAnd() {
+		if (!parseComparison()) return false;
+		while (accept("&&")) {
+			if (!parseComparison()) return false;
+			emit(Op::And);
+		}
+		return true;
+	}
+
+	bool parseComparison() {
+		if (!parseSum()) return false;
+		const std::vector<std::pair<std::string, Op>> operators = {
+			{ "<=", Op::Le }, { ">=", Op::Ge }, { "==", Op::Eq }, { "!=", Op::Ne }, { "<", Op::Lt }, { ">", Op::Gt } };
+		for (const auto& [token, op] : operators) {
+			if (!accept(token)) continue;
+			if (!parseSum()) return false;
+			emit(op);
+			break;
+		}
+		return true;
+	}
+
+	bool parseSum() {
+		if (!parseProduct()) return false;
+		while (true) {
+			Op op;
+			if (accept("+")) op = Op::Add;
+			else if (accept("-")) op = Op::Sub;
+			else return true;
+			if (!parseProduct()) return false;
+			emit(op);
+		}
+	}
+
+	bool parseProduct() {
+		if (!parseUnary()) return false;
+		while (true) {
+			Op op;
+			if (accept("*")) op = Op::Mul;
+			else if (accept("/")) op = Op::Div;
+			else return true;
+			if (!parseUnary()) return false;
+			emit(op);
+		}
+	}
+
+	bool parseUnary() {
+		if (accept("-")) {
+			if (!parseUnary()) return false;
+			emit(Op::Neg);
+			return true;
+		}
+		skipSpace();
+		if (pos < text.size() && text[pos] == '!' && text.compare(pos, 2, "!=") != 0) {
+			++pos;
+			if (!parseUnary()) return false;
+			emit(Op::Not);
+			return true;
+		}
+		return parsePower();
+	}
+
+	bool parsePower() {
+		if (!parsePrimary()) return false;
+		if (accept("^")) {
+			if (!parseUnary()) return false; // Right associative
+			emit(Op::Pow);
+		}
+		return true;
+	}
+
+	bool parsePrimary() {
+		skipSpace();
+		if (pos >= text.size()) return fail("Unexpected end of formula");
+
+		// Parentheses
+		if (accept("(")) {
+			if (!parseExpression()) return false;
+			return accept(")") || fail("Expected ')'");
+		}
+
+		// Dataset
+		if (accept("[")) {
+			size_t end = text.find(']', pos);
+			if (end == std::string::npos) return fail("Expected ']'");
+			std::string name = text.substr(pos, end - pos);
+			const H2A::Dataset* dataset = lookup(name);
+			if (dataset == nullptr) return fail("Unknown dataset '" + name + "'");
+			pos = end + 1;
+
+			auto& inputs = expression.m_Inputs;
+			auto input = std::find(inputs.begin(), inputs.end(), dataset);
+			if (input == inputs.end()) input = inputs.insert(inputs.end(), dataset);
+			emit(Op::Input, 0.0, input - inputs.begin());
+			return true;
+		}
+
+		// Number
+		if (std::isdigit(static_cast<unsigned char>(text[pos])) || text[pos] == '.') {
+			// Parsed independent of the locale, so the decimal separator is always '.'
+			double value;
+			const auto parsed = std::from_chars(text.data() + pos, text.data() + text.size(), value);
+			if (parsed.ec != std::errc()) return fail("Invalid number");
+			pos = parsed.ptr - text.data();
+			emit(Op::Const, value);
+			return true;
+		}
+
+		// Identifier: time, constant or function
+		if (!std::isalpha(static_cast<unsigned char>(text[pos]))) return fail(std::string("Unexpected character '") + text[pos] + "'");
+		size_t start = pos;
+		while (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '_')) ++pos;
+		std::string name = text.substr(start, pos - start);
+
+		if (name == "t") { emit(Op::Time); return true; }
+		if (name == "pi") { emit(Op::Const, 3.14159265358979323846); return true; }
+		return parseFunction(name);
+	}
+
+	bool parseFunction(const std::string& name) {
+		struct Function { Op op; size_t arguments; bool window; };
+		static const std::vector<std::pair<std::string, Function>> functions = {
+			{ "abs", { Op::Abs, 1, false } }, { "sqrt", { Op::Sqrt, 1, false } }, { "exp", { Op::Exp, 1, false } },
+			{ "log", { Op::Log, 1, false } }, { "sin", { Op::Sin, 1, false } }, { "cos", { Op::Cos, 1, false } },
+			{ "min", { Op::Min, 2, false } }, { "max", { Op::Max, 2, false } }, { "if", { Op::If, 3, false } },
+			{ "der", { Op::Der, 1, false } }, { "int", { Op::Int, 1, false } },
+			{ "movmean", { Op::MovMean, 2, true } }, { "movmin", { Op::MovMin, 2, true } }, { "movmax", { Op::MovMax, 2, true } },
+		};
+		auto function = std::find_if(functions.begin(), functions.end(), [&](const auto& f) { return f.first == name; });
+		if (function == functions.end()) return fail("Unknown function '" + name + "'");
+		const Function& f = function->second;
+
+		if (!accept("(")) return fail("Expected '(' after " + name);
+		for (size_t i = 0; i < f.arguments; ++i) {
+			if (i > 0 && !accept(",")) return fail("Expected ',' in " + name);
+			size_t first = expression.m_Program.size();
+			if (!parseExpression()) return false;
+
+			// Window length of rolling functions must be a constant
+			if (f.window && i == 1) {
+				if (expression.m_Program.size() != first + 1 || expression.m_Program.back().op != Op::Const || expression.m_Program.back().value <= 0.0)
+					return fail("Window of " + name + " must be a positive number of seconds");
+				double window = expression.m_Program.back().value;
+				expression.m_Program.pop_back();
+				if (!accept(")")) return fail("Expected ')'");
+				emit(f.op, window);
+				return true;
+			}
+		}
+		if (!accept(")")) return fail("Expected ')'");
+		emit(f.op);
+		return true;
+	}
+};
+
+/**
+* Compile a formula.
+*
+* @param formula Formula to compile.
+* @param lookup Function that returns the dataset with the given name (or nullptr if there is none).
+* @param error String to store error message in if compilation fails.
+**/
+std::shared_ptr<H2A::Expression> H2A::Expression::compile(const std::string& formula, const Lookup& lookup, std::string& error)
+{
+	auto expression = std::make_shared<Expression>();
+	expression->m_Formula = formula;
+
+	Parser parser(formula, lookup, *expression);
+	bool ok = parser.parseExpression();
+	parser.skipSpace();
+	if (ok && parser.pos < formula.size()) ok = parser.fail("Unexpected '" + formula.substr(parser.pos) + "'");
+	if (!ok) {
+		error = parser.error;
+		return nullptr;
+	}
+	if (expression->m_Inputs.empty()) {
+		error = "Formula does not use any dataset";
+		return nullptr;
+	}
+	return expression;
+}
+
+/**
+* Evaluate the formula. The inputs are resampled (linear) to a common timebase that spans the time in which all inputs
+* contain data, at the rate of the fastest input. Resampling and execution is done in chunks.
+* The inputs must be populated.
+*
+* @param time Vector to store time in.
+* @param data Vector to store result in.
+**/
+bool H2A::Expression::evaluate(std::vector<double>& time, std::vector<double>& data) const
+{
+	double tStart, tEnd;
+	if (!H2A::timeOverlap(m_Inputs, tStart, tEnd)) return false;
+
+	double frequency = 0.0;
+	for (const auto& input : m_Inputs)
+		frequency = std::max(frequency, H2A::samplingFreq(input));
+	if (frequency <= 0.0) return false;
+
+	H2A::timeGrid(tStart, tEnd, frequency, time);
+	data.resize(time.size());
+
+	std::vector<H2A::Resampler> resamplers;
+	for (const auto& input : m_Inputs)
+		resamplers.emplace_back(input, H2A::ResampleMode::Linear);
+	std::vector<std::vector<double>> inputs(m_Inputs.size(), std::vector<double>(H2A::RESAMPLE_CHUNK_SIZE));
+	std::vector<size_t> indices(m_Inputs.size());
+	std::iota(indices.begin(), indices.end(), 0);
+
+	std::vector<State> states(m_Program.size());
+	for (size_t i = 0; i < m_Program.size(); ++i)
+		states[i].window = std::max(static_cast<size_t>(std::round(m_Program[i].value * frequency)), static_cast<size_t>(1));
+
+	for (size_t offset = 0; offset < time.size(); offset += H2A::RESAMPLE_CHUNK_SIZE) {
+		const size_t n = std::min(H2A::RESAMPLE_CHUNK_SIZE, time.size() - offset);
+		std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t i) {
+			resamplers[i].next(time.data() + offset, n, inputs[i].data());
+		});
+		this->execute(time.data() + offset, n, inputs, states, data.data() + offset);
+	}
+	return true;
+}
+
+/**
+* Execute the program on a chunk. Every instruction processes the whole chunk at once, with a stack of chunk buffers.
+*
+* @param time Time of chunk.
+* @param n Number of points in chunk.
+* @param inputs Resampled inputs of chunk.
+* @param states States of the instructions, carried between chunks.
+* @param result Buffer to store result in.
+**/
+void H2A::Expression::execute(const double* time, size_t n, const std::vector<std::vector<double>>& inputs, std::vector<State>& states, double* result) const
+{
+	std::vector<std::vector<double>> stack;
+	stack.reserve(8);
+
+	auto unary = [&](auto f) {
+		double* a = stack.back().data();
+		for (size_t i = 0; i < n; ++i) a[i] = f(a[i]);
+	};
+	auto binary = [&](auto f) {
+		std::vector<double> b = std::move(stack.back());
+		stack.pop_back();
+		double* a = stack.back().data();
+		for (size_t i = 0; i < n; ++i) a[i] = f(a[i], b[i]);
+	};
+
+	for (size_t k = 0; k < m_Program.size(); ++k) {
+		const Instruction& instruction = m_Program[k];
+		State& state = states[k];
+
+		switch (instruction.op) {
+		case Op::Input: stack.emplace_back(inputs[instruction.input].begin(), inputs[instruction.input].begin() + n); break;
+		case Op::Const: stack.emplace_back(n, instruction.value); break;
+		case Op::Time: stack.emplace_back(time, time + n); break;
+
+		case Op::Neg: unary([](double a) { return -a; }); break;
+		case Op::Not: unary([](double a) { return a == 0.0 ? 1.0 : 0.0; }); break;
+		case Op::Abs: unary([](double a) { return std::abs(a); }); break;
+		case Op::Sqrt: unary([](double a) { return std::sqrt(a); }); break;
+		case Op::Exp: unary([](double a) { return std::exp(a); }); break;
+		case Op::Log: unary([](double a) { return std::log(a); }); break;
+		case Op::Sin: unary([](double a) { return std::sin(a); }); break;
+		case Op::Cos: unary([](double a) { return std::cos(a); }); break;
+
+		case Op::Add: binary([](double a, double b) { return a + b; }); break;
+		case Op::Sub: binary([](double a, double b) { return a - b; }); break;
+		case Op::Mul: binary([](double a, double b) { return a * b; }); break;
+		case Op::Div: binary([](double a, double b) { return a / b; }); break;
+		case Op::Pow: binary([](double a, double b) { return std::pow(a, b); }); break;
+		case Op::Lt: binary([](double a, double b) { return a < b ? 1.0 : 0.0; }); break;
+		case Op::Gt: binary([](double a, double b) { return a > b ? 1.0 : 0.0; }); break;
+		case Op::Le: binary([](double a, double b) { return a <= b ? 1.0 : 0.0; }); break;
+		case Op::Ge: binary([](double a, double b) { return a >= b ? 1.0 : 0.0; }); break;
+		case Op::Eq: binary([](double a, double b) { return a == b ? 1.0 : 0.0; }); break;
+		case Op::Ne: binary([](double a, double b) { return a != b ? 1.0 : 0.0; }); break;
+		case Op::And: binary([](double a, double b) { return (a != 0.0 && b != 0.0) ? 1.0 : 0.0; }); break;
+		case Op::Or: binary([](double a, double b) { return (a != 0.0 || b != 0.0) ? 1.0 : 0.0; }); break;
+		case Op::Min: binary([](double a, double b) { return std::min(a, b); }); break;
+		case Op::Max: binary([](double a, double b) { return std::max(a, b); }); break;
+
+		case Op::If: {
+			std::vector<double> otherwise = std::move(stack.back());
+			stack.pop_back();
+			std::vector<double> then = std::move(stack.back());
+			stack.pop_back();
+			double* c = stack.back().data();
+			for (size_t i = 0; i < n; ++i) c[i] = c[i] != 0.0 ? then[i] : otherwise[i];
+			break;
+		}
+
+		case Op::Der: {
+			double* a = stack.back().data();
+			for (size_t i = 0; i < n; ++i) {
+				double value = a[i];
+				a[i] = (value - state.prevValue) / (time[i] - state.prevTime); // NaN for the first point
+				state.prevValue = value;
+				state.prevTime = time[i];
+			}
+			break;
+		}
+
+		case Op::Int: {
+			double* a = stack.back().data();
+			for (size_t i = 0; i < n; ++i) {
+				double value = a[i];
+				if (!std::isnan(state.prevTime) && std::isfinite(value) && std::isfinite(state.prevValue))
+					state.sum += 0.5 * (value + state.prevValue) * (time[i] - state.prevTime);
+				state.prevValue = value;
+				state.prevTime = time[i];
+				a[i] = state.sum;
+			}
+			break;
+		}
+
+		case Op::MovMean: {
+			double* a = stack.back().data();
+			// Mean of the finite values in the window, so a NaN (e.g. the first point of der) only affects its own point
+			for (size_t i = 0; i < n; ++i) {
+				state.values.push_back(a[i]);
+				if (std::isfinite(a[i])) {
+					state.sum += a[i];
+					++state.count;
+				}
+				if (state.values.size() > state.window) {
+					if (std::isfinite(state.values.front())) {
+						state.sum -= state.values.front();
+						--state.count;
+					}
+					state.values.pop_front();
+				}
+				a[i] = state.count > 0 ? state.sum / state.count : std::numeric_limits<double>::quiet_NaN();
+			}
+			break;
+		}
+
+		case Op::MovMin:
+		case Op::MovMax: {
+			// Monotonic queue of the candidates for the extreme value of the window. NaN values are skipped, as they cannot
+			// be compared, so the result is only NaN if the window has no other values
+			const bool isMin = instruction.op == Op::MovMin;
+			double* a = stack.back().data();
+			for (size_t i = 0; i < n; ++i, ++state.index) {
+				if (!std::isnan(a[i])) {
+					while (!state.extremes.empty() && (isMin ? state.extremes.back().second >= a[i] : state.extremes.back().second <= a[i]))
+						state.extremes.pop_back();
+					state.extremes.push_back({ state.index, a[i] });
+				}
+				while (!state.extremes.empty() && state.extremes.front().first + state.window <= state.index)
+					state.extremes.pop_front();
+				a[i] = state.extremes.empty() ? std::numeric_limits<double>::quiet_NaN() : state.extremes.front().second;
+			}
+			break;
+		}
+		}
+	}
+
+	std::copy(stack.back().begin(), stack.back().end(), result);
+}
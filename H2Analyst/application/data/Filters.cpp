@@ -0,0 +1,173 @@
+#include "Filters.h"
+
+/**
+* Create a filter.
+*
+* @param settings Type and parameter of the filter.
+* @param sampleRate Sample rate [Hz] of the signal, used to convert the parameter to samples.
+**/
+H2A::Filters::Filter::Filter(const Settings& settings, double sampleRate) :
+	m_Settings(settings)
+{
+	const double rate = sampleRate > 0.0 ? sampleRate : 1.0;
+
+	switch (m_Settings.type) {
+	case H2A::FilterType::MovingAverage:
+	case H2A::FilterType::Median:
+		m_Window = std::max(static_cast<size_t>(std::round(m_Settings.parameter * rate)), static_cast<size_t>(1));
+		if (m_Settings.type == H2A::FilterType::Median) m_Window = std::min(m_Window, MAX_MEDIAN_WINDOW);
+		m_Ring.reserve(m_Window);
+		m_Sorted.reserve(m_Window);
+		break;
+
+	case H2A::FilterType::LowPass:
+	case H2A::FilterType::HighPass: {
+		// Bilinear transform of 2nd order Butterworth filter, cutoff is kept below Nyquist
+		const double cutoff = std::clamp(m_Settings.parameter, 1e-6 * rate, 0.45 * rate);
+		const double k = std::tan(3.14159265358979323846 * cutoff / rate);
+		const double norm = 1.0 / (1.0 + std::sqrt(2.0) * k + k * k);
+		if (m_Settings.type == H2A::FilterType::LowPass) {
+			m_B[0] = k * k * norm;
+			m_B[1] = 2.0 * m_B[0];
+			m_B[2] = m_B[0];
+		}
+		else {
+			m_B[0] = norm;
+			m_B[1] = -2.0 * norm;
+			m_B[2] = norm;
+		}
+		m_A[1] = 2.0 * (k * k - 1.0) * norm;
+		m_A[2] = (1.0 - std::sqrt(2.0) * k + k * k) * norm;
+		break;
+	}
+
+	default:
+		break;
+	}
+}
+
+/**
+* Filter the next block of the signal. Non-finite values are passed through without affecting the filter state.
+*
+* @param time Time of the datapoints.
+* @param in Input values.
+* @param n Number of datapoints.
+* @param out Buffer to store filtered values in (can be the same as in).
+**/
+void H2A::Filters::Filter::process(const double* time, const double* in, size_t n, double* out)
+{
+	switch (m_Settings.type) {
+	case H2A::FilterType::MovingAverage:
+		for (size_t i = 0; i < n; ++i) {
+			const double value = in[i];
+			if (!std::isfinite(value)) { out[i] = value; continue; }
+			if (m_Ring.size() < m_Window) m_Ring.push_back(value);
+			else {
+				m_Sum -= m_Ring[m_RingPos];
+				m_Ring[m_RingPos] = value;
+				m_RingPos = (m_RingPos + 1) % m_Window;
+			}
+			m_Sum += value;
+			out[i] = m_Sum / m_Ring.size();
+		}
+		break;
+
+	case H2A::FilterType::Median:
+		// Sorted copy of the window, of which the oldest value is replaced by the newest value
+		for (size_t i = 0; i < n; ++i) {
+			const double value = in[i];
+			if (!std::isfinite(value)) { out[i] = value; continue; }
+			if (m_Ring.size() < m_Window) m_Ring.push_back(value);
+			else {
+				m_Sorted.erase(std::lower_bound(m_Sorted.begin(), m_Sorted.end(), m_Ring[m_RingPos]));
+				m_Ring[m_RingPos] = value;
+				m_RingPos = (m_RingPos + 1) % m_Window;
+			}
+			m_Sorted.insert(std::upper_bound(m_Sorted.begin(), m_Sorted.end(), value), value);
+			const size_t mid = m_Sorted.size() / 2;
+			out[i] = m_Sorted.size() % 2 ? m_Sorted[mid] : 0.5 * (m_Sorted[mid - 1] + m_Sorted[mid]);
+		}
+		break;
+
+	case H2A::FilterType::Exponential:
+		// Smoothing factor follows from the actual time step, so it also works for irregularly sampled signals
+		for (size_t i = 0; i < n; ++i) {
+			const double value = in[i];
+			if (!std::isfinite(value)) { out[i] = value; continue; }
+			if (!m_Initialized) {
+				m_Y[0] = value;
+				m_Initialized = true;
+			}
+			else {
+				const double alpha = 1.0 - std::exp(-(time[i] - m_PrevTime) / m_Settings.parameter);
+				m_Y[0] += alpha * (value - m_Y[0]);
+			}
+			m_PrevTime = time[i];
+			out[i] = m_Y[0];
+		}
+		break;
+
+	case H2A::FilterType::LowPass:
+	case H2A::FilterType::HighPass:
+		for (size_t i = 0; i < n; ++i) {
+			const double value = in[i];
+			if (!std::isfinite(value)) { out[i] = value; continue; }
+			if (!m_Initialized) {
+				// Start in steady state to avoid a transient at the start of the signal
+				m_X[0] = m_X[1] = value;
+				m_Y[0] = m_Y[1] = m_Settings.type == H2A::FilterType::LowPass ? value : 0.0;
+				m_Initialized = true;
+			}
+			const double y = m_B[0] * value + m_B[1] * m_X[0] + m_B[2] * m_X[1] - m_A[1] * m_Y[0] - m_A[2] * m_Y[1];
+			m_X[1] = m_X[0];
+			m_X[0] = value;
+			m_Y[1] = m_Y[0];
+			m_Y[0] = y;
+			out[i] = y;
+		}
+		break;
+
+	default:
+		if (out != in) std::copy(in, in + n, out);
+		break;
+	}
+}
+
+/**
+* Filter a dataset in cache-sized blocks.
+*
+* @param dataset Dataset to filter.
+* @param settings Type and parameter of the filter.
+* @param result Buffer of dataVec.size() values to store filtered data in.
+**/
+void H2A::Filters::apply(const H2A::Dataset* dataset, const Settings& settings, double* result)
+{
+	const std::vector<double>& time = dataset->rawTimeVec();
+	const std::vector<double>& data = dataset->dataVec;
+	const size_t size = std::min(time.size(), data.size());
+
+	Filter filter(settings, H2A::samplingFreq(dataset));
+	for (size_t offset = 0; offset < size; offset += H2A::RESAMPLE_CHUNK_SIZE) {
+		const size_t n = std::min(H2A::RESAMPLE_CHUNK_SIZE, size - offset);
+		filter.process(time.data() + offset, data.data() + offset, n, result + offset);
+	}
+	std::copy(data.begin() + size, data.end(), result + size);
+}
+
+/**
+* Filter multiple datasets in parallel.
+*
+* @param datasets Datasets to filter.
+* @param settings Type and parameter of the filter.
+* @param results Vector to store filtered data in, one column per dataset.
+**/
+void H2A::Filters::apply(const std::vector<const H2A::Dataset*>& datasets, const Settings& settings, std::vector<std::vector<double>>& results)
+{
+	results.resize(datasets.size());
+	std::vector<size_t> indices(datasets.size());
+	std::iota(indices.begin(), indices.end(), 0);
+	std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t i) {
+		results[i].resize(datasets[i]->dataVec.size());
+		H2A::Filters::apply(datasets[i], settings, results[i].data());
+	});
+}
@@ -76,6 +76,9 @@ void Populator::startNextDataset()
 }
 
 
+QMutex PopulatorWorker::s_PopulatedMutex;
+QWaitCondition PopulatorWorker::s_Populated;
+
 /**
 * Worker thread that does the actual population for a single dataset.
 * 
@@ -89,6 +92,12 @@ m_ds(dataset)
 * Function that is executed when the worker is started.
 **/
 void PopulatorWorker::run() {
+	if (m_ds->expression) {
+		this->evaluate();
+		emit finished(m_ds);
+		return;
+	}
+
 	// Find indices of messages that match the ID of this dataset
 	arma::uvec mess_cols = arma::find(*(m_ds->datafile->message_ids) == m_ds->id);
 	arma::uvec mess_rows(m_ds->length);
@@ -106,6 +115,7 @@ void PopulatorWorker::run() {
 	// Data vector
 	m_ds->dataVec = std::vector<double>(messages.n_cols);
 	m_ds->byteVec = std::vector<uint64_t>(messages.n_cols);
+	H2A::DatasetStats stats;
 	uint64_t temp_val;
 	for (size_t col = 0; col < messages.n_cols; ++ col) {
 		// Combine bytes of message into single temporary variable using bitwise operations
@@ -187,13 +197,58 @@ void PopulatorWorker::run() {
 		// Apply scaling and offset to data
 		m_ds->dataVec[col] *= m_ds->scale;
 		m_ds->dataVec[col] += m_ds->offset;
+		stats.add(m_ds->dataVec[col]);
 	}
+	stats.finish(m_ds->rawTimeVec());
+	m_ds->stats = stats;
+	m_ds->buildIndex();
 
 	m_ds->populated = true;
 	m_ds->mutex.unlock();
+	PopulatorWorker::notifyPopulated();
 	
 	//std::cout << "Finished population of " << m_ds->name << std::endl;
 	
 	emit finished(m_ds);
 }
 
+
+/**
+* Populates a derived dataset by evaluating its formula, once all datasets it is computed from are populated.
+**/
+void PopulatorWorker::evaluate() {
+	for (const auto& input : m_ds->expression->inputs())
+		PopulatorWorker::waitPopulated(input);
+
+	std::vector<double> time, data;
+	if (!m_ds->expression->evaluate(time, data))
+		H2A::logWarning("Failed to evaluate " + m_ds->name + ": its datasets do not overlap in time");
+
+	m_ds->mutex.lock();
+	m_ds->setTimeVec(std::move(time));
+	m_ds->dataVec = std::move(data);
+	m_ds->byteVec = std::vector<uint64_t>(m_ds->dataVec.size());
+	m_ds->computeStats();
+	m_ds->buildIndex();
+	m_ds->populated = true;
+	m_ds->mutex.unlock();
+	PopulatorWorker::notifyPopulated();
+}
+
+/**
+* Wake the threads that wait for a dataset to be populated. Called after the populated flag of a dataset is set.
+**/
+void PopulatorWorker::notifyPopulated() {
+	QMutexLocker lock(&s_PopulatedMutex);
+	s_Populated.wakeAll();
+}
+
+/**
+* Block until a dataset is populated, without polling.
+*
+* @param dataset Dataset to wait for.
+**/
+void PopulatorWorker::waitPopulated(const H2A::Dataset* dataset) {
+	QMutexLocker lock(&s_PopulatedMutex);
+	while (!dataset->populated) s_Populated.wait(&s_PopulatedMutex);
+}
@@ -0,0 +1,148 @@
+#include "Spectral.h"
+
+namespace
+{
+	// Everything a cached spectrum depends on
+	struct CacheKey {
+		const H2A::Dataset* dataset;
+		size_t size;
+		double timeOffset;
+		double timeDrift;
+		double tStart;
+		double tEnd;
+		size_t segmentSize;
+		double overlap;
+		bool spectrogram;
+
+		bool operator==(const CacheKey& other) const {
+			return dataset == other.dataset && size == other.size && timeOffset == other.timeOffset && timeDrift == other.timeDrift &&
+				tStart == other.tStart && tEnd == other.tEnd && segmentSize == other.segmentSize && overlap == other.overlap && spectrogram == other.spectrogram;
+		}
+	};
+
+	std::mutex cacheMutex;
+	std::list<std::pair<CacheKey, std::shared_ptr<const H2A::Spectral::Result>>> cache; // Most recently used first
+}
+
+/**
+* Estimate the power spectral density of a dataset within a time window with the Welch method. The dataset is
+* resampled (linear) at its sampling frequency, split into overlapping segments with a Hann window, and the
+* periodograms of the segments are averaged. Segments are processed in parallel, in groups of consecutive segments
+* that also form the columns of the spectrogram.
+*
+* @param dataset Dataset to compute spectrum of.
+* @param tStart Start of time window, limited to the data of the dataset.
+* @param tEnd End of time window, limited to the data of the dataset.
+* @param settings Segment size, overlap and whether to compute the spectrogram.
+* @param result Object to store spectrum in.
+**/
+bool H2A::Spectral::welch(const H2A::Dataset* dataset, double tStart, double tEnd, const Settings& settings, Result& result)
+{
+	double dataStart, dataEnd;
+	if (!H2A::timeSpan(dataset, dataStart, dataEnd)) return false;
+	tStart = std::max(tStart, dataStart);
+	tEnd = std::min(tEnd, dataEnd);
+
+	const double fs = H2A::samplingFreq(dataset);
+	if (fs <= 0.0 || tEnd <= tStart) return false;
+	const double dt = 1.0 / fs;
+	const size_t nSamples = static_cast<size_t>((tEnd - tStart) * fs) + 1;
+	if (nSamples < MIN_SEGMENT_SIZE) return false;
+
+	// Segment size is a power of two that fits in the window
+	size_t segment = MIN_SEGMENT_SIZE;
+	while (2 * segment <= std::min(std::max(settings.segmentSize, MIN_SEGMENT_SIZE), nSamples)) segment *= 2;
+	const size_t hop = std::max(static_cast<size_t>(std::round(segment * (1.0 - std::clamp(settings.overlap, 0.0, 0.95)))), static_cast<size_t>(1));
+	const size_t nSegments = (nSamples - segment) / hop + 1;
+	const size_t nBins = segment / 2 + 1;
+
+	// Hann window, scaled so the sum of the one-sided spectrum equals the variance of the signal
+	arma::vec window(segment);
+	for (size_t i = 0; i < segment; ++i) window(i) = 0.5 - 0.5 * std::cos(2.0 * arma::datum::pi * i / (segment - 1));
+	const double scale = 1.0 / (fs * arma::dot(window, window));
+
+	const size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+	const size_t nGroups = std::min(nSegments, settings.spectrogram ? MAX_COLUMNS : 4 * threads);
+	arma::mat groups(nBins, nGroups, arma::fill::zeros);
+	std::vector<size_t> counts(nGroups, 0);
+
+	std::vector<size_t> indices(nGroups);
+	std::iota(indices.begin(), indices.end(), 0);
+	std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t g) {
+		std::vector<double> time(segment);
+		std::vector<double> data;
+		for (size_t s = g * nSegments / nGroups; s < (g + 1) * nSegments / nGroups; ++s) {
+			const double t0 = tStart + s * hop * dt;
+			for (size_t i = 0; i < segment; ++i) time[i] = t0 + i * dt;
+			H2A::resample(dataset, time, data, H2A::ResampleMode::Linear, 0.0);
+
+			arma::vec x(data.data(), segment);
+			x -= arma::mean(x);
+			x %= window;
+			const arma::cx_vec spectrum = arma::fft(x);
+			groups.col(g) += arma::square(arma::abs(spectrum.head(nBins)));
+			++counts[g];
+		}
+	});
+
+	// Bins other than DC and Nyquist also contain the power of the negative frequencies
+	groups *= scale;
+	if (nBins > 2) groups.rows(1, nBins - 2) *= 2.0;
+
+	result.samplingFreq = fs;
+	result.tStart = tStart;
+	result.tEnd = tEnd;
+	result.frequency.resize(nBins);
+	for (size_t i = 0; i < nBins; ++i) result.frequency[i] = i * fs / segment;
+
+	arma::vec psd(nBins, arma::fill::zeros);
+	for (size_t g = 0; g < nGroups; ++g) psd += groups.col(g);
+	psd /= nSegments;
+	result.psd.assign(psd.begin(), psd.end());
+
+	result.time.clear();
+	result.spectrogram.reset();
+	if (settings.spectrogram) {
+		for (size_t g = 0; g < nGroups; ++g) {
+			groups.col(g) /= std::max(counts[g], static_cast<size_t>(1));
+			const double center = 0.5 * (g * nSegments / nGroups + (g + 1) * nSegments / nGroups - 1);
+			result.time.push_back(tStart + (center * hop + 0.5 * segment) * dt);
+		}
+		result.spectrogram = std::move(groups);
+	}
+	return true;
+}
+
+/**
+* Spectrum of a dataset within a time window. Spectra are cached, so switching back and forth between views or
+* replotting does not recompute them. Returns nullptr if the window does not contain enough data.
+*
+* @param dataset Dataset to compute spectrum of.
+* @param tStart Start of time window.
+* @param tEnd End of time window.
+* @param settings Segment size, overlap and whether to compute the spectrogram.
+**/
+std::shared_ptr<const H2A::Spectral::Result> H2A::Spectral::compute(const H2A::Dataset* dataset, double tStart, double tEnd, const Settings& settings)
+{
+	double dataStart, dataEnd;
+	if (!H2A::timeSpan(dataset, dataStart, dataEnd)) return nullptr;
+	const CacheKey key{ dataset, dataset->dataVec.size(), dataset->datafile->timeOffset, dataset->datafile->timeDrift,
+		std::max(tStart, dataStart), std::min(tEnd, dataEnd), settings.segmentSize, settings.overlap, settings.spectrogram };
+
+	{
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		auto it = std::find_if(cache.begin(), cache.end(), [&](const auto& entry) { return entry.first == key; });
+		if (it != cache.end()) {
+			cache.splice(cache.begin(), cache, it);
+			return it->second;
+		}
+	}
+
+	auto result = std::make_shared<Result>();
+	if (!H2A::Spectral::welch(dataset, key.tStart, key.tEnd, settings, *result)) return nullptr;
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	cache.emplace_front(key, result);
+	if (cache.size() > CACHE_SIZE) cache.pop_back();
+	return result;
+}
@@ -0,0 +1,25 @@
+#include "SpectrumWorker.h"
+
+SpectrumWorker::SpectrumWorker(const std::vector<const H2A::Dataset*>& datasets, double tStart, double tEnd, const H2A::Spectral::Settings& settings, const std::shared_ptr<Spectra>& spectra) : QObject(),
+	m_Datasets(datasets),
+	m_Start(tStart),
+	m_End(tEnd),
+	m_Settings(settings),
+	m_Spectra(spectra)
+{
+}
+
+/**
+* Compute the spectrum of every dataset, or only the spectrogram of the first dataset when the settings ask for it.
+**/
+void SpectrumWorker::run() {
+	m_Spectra->assign(m_Datasets.size(), nullptr);
+	if (m_Settings.spectrogram) {
+		if (!m_Datasets.empty()) m_Spectra->front() = H2A::Spectral::compute(m_Datasets.front(), m_Start, m_End, m_Settings);
+	}
+	else {
+		for (size_t i = 0; i < m_Datasets.size(); ++i)
+			(*m_Spectra)[i] = H2A::Spectral::compute(m_Datasets[i], m_Start, m_End, m_Settings);
+	}
+	emit finished();
+}
@@ -0,0 +1,166 @@
+#include "TimeAlignment.h"
+
+/**
+* Combines the current time correction of a datafile with a residual correction that is estimated on its corrected timebase.
+*
+* @param datafile Datafile with the current time correction.
+* @param residual Correction on top of the current correction.
+**/
+H2A::Alignment::Correction H2A::Alignment::compose(const H2A::Datafile* datafile, const Correction& residual) {
+	Correction correction;
+	correction.drift = (1.0 + datafile->timeDrift) * (1.0 + residual.drift) - 1.0;
+	correction.offset = datafile->timeOffset * (1.0 + residual.drift) + residual.offset;
+	return correction;
+}
+
+/**
+* Least squares fit of a linear correction through a set of lags.
+* With a single lag only the offset can be determined.
+*
+* @param lags Pairs of (time, lag) where lag is the shift that has to be added at that time.
+**/
+H2A::Alignment::Correction H2A::Alignment::fitLags(const std::vector<std::pair<double, double>>& lags) {
+	Correction correction;
+	if (lags.empty()) return correction;
+
+	double meanT = 0.0;
+	double meanLag = 0.0;
+	for (const auto& [t, lag] : lags) {
+		meanT += t;
+		meanLag += lag;
+	}
+	meanT /= lags.size();
+	meanLag /= lags.size();
+
+	double covariance = 0.0;
+	double variance = 0.0;
+	for (const auto& [t, lag] : lags) {
+		covariance += (t - meanT) * (lag - meanLag);
+		variance += (t - meanT) * (t - meanT);
+	}
+
+	correction.drift = (variance > 0.0) ? covariance / variance : 0.0;
+	correction.offset = meanLag - correction.drift * meanT;
+	return correction;
+}
+
+/**
+* Determine the time correction of a datafile from manually placed anchor events.
+*
+* @param datafile Datafile to determine the correction of.
+* @param anchors Pairs of (time of the event in the datafile as currently shown, time the event should be at).
+* @param correction Object to store the resulting correction in.
+**/
+bool H2A::Alignment::fromAnchors(const H2A::Datafile* datafile, const std::vector<std::pair<double, double>>& anchors, Correction& correction) {
+	if (anchors.empty()) return false;
+
+	std::vector<std::pair<double, double>> lags;
+	for (const auto& [current, desired] : anchors)
+		lags.push_back({ current, desired - current });
+
+	correction = H2A::Alignment::compose(datafile, H2A::Alignment::fitLags(lags));
+	return true;
+}
+
+/**
+* Determine the time correction of the datafile of the target dataset, by cross-correlating it with a reference dataset that
+* contains the same signal. The overlapping time span is split into windows and the lag is estimated in each window, after
+* which a linear fit through the lags gives the offset and drift.
+*
+* @param reference Dataset on the reference timebase.
+* @param target Dataset of which the datafile is corrected.
+* @param maxLag Largest lag [s] that is searched for.
+* @param correction Object to store the resulting correction in.
+**/
+bool H2A::Alignment::fromCrossCorrelation(const H2A::Dataset* reference, const H2A::Dataset* target, double maxLag, Correction& correction) {
+	if (reference->rawTimeVec().size() < 2 || target->rawTimeVec().size() < 2) return false;
+
+	// Time span in which both datasets contain data (on the current timebase)
+	const double tStart = std::max(reference->time(0), target->time(0));
+	const double tEnd = std::min(reference->time(reference->rawTimeVec().size() - 1), target->time(target->rawTimeVec().size() - 1));
+	if (tEnd - tStart <= 2.0 * maxLag) return false;
+
+	// Both datasets are resampled on a common grid with the rate of the slowest dataset
+	const double rate = std::min({ H2A::samplingFreq(reference), H2A::samplingFreq(target), H2A::Alignment::MAX_CORRELATION_RATE });
+	if (rate <= 0.0) return false;
+	const double dt = 1.0 / rate;
+
+	const size_t nWindows = std::clamp(static_cast<size_t>((tEnd - tStart) / H2A::Alignment::MIN_WINDOW_DURATION), static_cast<size_t>(1), H2A::Alignment::MAX_WINDOWS);
+	const double windowDuration = (tEnd - tStart) / nWindows;
+
+	// Estimate the lag in every window in parallel
+	std::vector<double> lags(nWindows, 0.0);
+	std::vector<char> found(nWindows, false); // Not vector<bool>, which can not be written from multiple threads
+	std::vector<size_t> windows(nWindows);
+	std::iota(windows.begin(), windows.end(), 0);
+	std::for_each(std::execution::par, windows.begin(), windows.end(), [&](size_t w) {
+		const double wStart = tStart + w * windowDuration;
+		std::vector<double> time(static_cast<size_t>(windowDuration * rate));
+		for (size_t i = 0; i < time.size(); ++i) time[i] = wStart + i * dt;
+		if (time.size() < 2) return;
+
+		std::vector<double> referenceData, targetData;
+		H2A::resample(reference, time, referenceData);
+		H2A::resample(target, time, targetData);
+
+		double lag;
+		found[w] = H2A::Alignment::estimateLag(referenceData, targetData, dt, maxLag, lag);
+		lags[w] = lag;
+	});
+
+	std::vector<std::pair<double, double>> windowLags;
+	for (size_t w = 0; w < nWindows; ++w)
+		if (found[w]) windowLags.push_back({ tStart + (w + 0.5) * windowDuration, lags[w] });
+	if (windowLags.empty()) return false;
+
+	correction = H2A::Alignment::compose(target->datafile, H2A::Alignment::fitLags(windowLags));
+	return true;
+}
+
+/**
+* Estimate the lag between two equally sampled signals using FFT-based cross-correlation.
+* The peak of the cross-correlation is interpolated with a parabola to get a resolution finer than the sample time.
+*
+* @param reference Reference signal.
+* @param target Target signal, sampled at the same times as the reference.
+* @param dt Sample time of the signals.
+* @param maxLag Largest lag [s] that is searched for.
+* @param lag Lag [s] that has to be added to the target time to align it with the reference.
+**/
+bool H2A::Alignment::estimateLag(const std::vector<double>& reference, const std::vector<double>& target, double dt, double maxLag, double& lag) {
+	lag = 0.0;
+	const size_t n = std::min(reference.size(), target.size());
+	if (n < 4) return false;
+
+	arma::vec x(reference.data(), n);
+	arma::vec y(target.data(), n);
+	x -= arma::mean(x);
+	y -= arma::mean(y);
+	const double norm = std::sqrt(arma::dot(x, x) * arma::dot(y, y));
+	if (norm <= 0.0) return false; // Constant signal, nothing to correlate
+
+	// Zero-pad to avoid circular wrap-around of the correlation
+	size_t nfft = 1;
+	while (nfft < 2 * n) nfft <<= 1;
+	arma::cx_vec spectrum = arma::fft(x, nfft) % arma::conj(arma::fft(y, nfft));
+	arma::vec correlation = arma::real(arma::ifft(spectrum));
+
+	// Search the peak within the allowed lags. Index k means reference(t + k*dt) matches target(t), negative lags wrap around.
+	const long maxK = std::min(static_cast<long>(maxLag / dt), static_cast<long>(n) - 2);
+	auto at = [&](long k) { return correlation(static_cast<arma::uword>((k + static_cast<long>(nfft)) % static_cast<long>(nfft))); };
+	long peak = 0;
+	for (long k = -maxK; k <= maxK; ++k)
+		if (at(k) > at(peak)) peak = k;
+	if (at(peak) <= 0.0) return false;
+
+	double delta = 0.0;
+	if (peak > -maxK && peak < maxK) {
+		const double left = at(peak - 1);
+		const double right = at(peak + 1);
+		const double denominator = left - 2.0 * at(peak) + right;
+		if (denominator < 0.0) delta = 0.5 * (left - right) / denominator;
+	}
+
+	lag = (peak + delta) * dt;
+	return true;
+}
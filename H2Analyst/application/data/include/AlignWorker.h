@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QObject>
+#include <QThread>
+
+#include "DataStructures.h"
+#include "TimeAlignment.h"
+
+
+/**
+* Estimates the time correction of the datafile of a target dataset by cross-correlating it with a reference dataset,
+* in a separate thread. Both datasets are populated first, which the worker waits for.
+**/
+class AlignWorker
+	: public QObject
+{
+
+	Q_OBJECT
+
+	const H2A::Dataset* m_Reference;
+	const H2A::Dataset* m_Target;
+	double m_MaxLag;
+
+public:
+	AlignWorker(const H2A::Dataset* reference, const H2A::Dataset* target, double maxLag);
+
+public slots:
+	void run();
+
+signals:
+	void finished(bool success, double offset, double drift);
+
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <execution>
+#include <thread>
+#include <cmath>
+#include <cstdint>
+
+#include "DataStructures.h"
+#include "DataOperations.h"
+
+
+namespace H2A
+{
+	namespace Binning
+	{
+
+		const size_t CHUNK_SIZE = 65536; // Number of datapoints binned by one thread into its own partial histogram
+		const double TICK = 1.0e-9; // Resolution [s] of the time in the bins
+
+		/**
+		* Histogram of one dataset, or two-dimensional histogram of two datasets, over a time window. Every datapoint
+		* is weighted with the time until the next datapoint, so bins contain the time [s] spent at their values.
+		* When the time window changes, only the datapoints that entered or left the window are (un)binned. Bins hold the
+		* time as an integer number of ticks, so unbinning exactly cancels binning and an emptied bin is exactly zero.
+		**/
+		class Histogram
+		{
+			// Signal(s): for one dataset its own vectors are referenced, for two datasets they are resampled on a common grid
+			const H2A::Datafile* m_Datafile = nullptr; // Time correction of referenced time vector, nullptr if time is corrected already
+			const double* m_Time = nullptr;
+			const double* m_X = nullptr;
+			const double* m_Y = nullptr;
+			size_t m_Size = 0;
+			double m_MaxInterval = 0.0; // Longest interval a datapoint is weighted with, longer intervals are gaps
+			std::vector<double> m_GridTime;
+			std::vector<std::vector<double>> m_GridData;
+
+			// Bins
+			size_t m_BinsX = 1;
+			size_t m_BinsY = 1;
+			double m_LowerX = 0.0, m_UpperX = 1.0;
+			double m_LowerY = 0.0, m_UpperY = 1.0;
+			std::vector<int64_t> m_Counts; // Ticks per bin, row-major: index = x + y * binsX
+
+			// Window of datapoints [first, last) that is binned
+			size_t m_First = 0;
+			size_t m_Last = 0;
+
+			void setBinRange(const H2A::Dataset* dataset, double& lower, double& upper) const;
+			size_t index(double time) const;
+			long bin(size_t i) const;
+			int64_t weight(size_t i) const;
+			void accumulate(size_t first, size_t last, int64_t sign);
+
+		public:
+			Histogram(const H2A::Dataset* dataset, size_t bins);
+			Histogram(const H2A::Dataset* datasetX, const H2A::Dataset* datasetY, size_t binsX, size_t binsY);
+
+			void setWindow(double tStart, double tEnd);
+			void setFullWindow() { this->setWindow(-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()); };
+
+			size_t binsX() const { return m_BinsX; };
+			size_t binsY() const { return m_BinsY; };
+			double lowerX() const { return m_LowerX; };
+			double upperX() const { return m_UpperX; };
+			double lowerY() const { return m_LowerY; };
+			double upperY() const { return m_UpperY; };
+			double count(size_t x, size_t y = 0) const { return static_cast<double>(m_Counts[x + y * m_BinsX]) * TICK; };
+			double binCenterX(size_t x) const { return m_LowerX + (x + 0.5) * (m_UpperX - m_LowerX) / m_BinsX; };
+			double binCenterY(size_t y) const { return m_LowerY + (y + 0.5) * (m_UpperY - m_LowerY) / m_BinsY; };
+		};
+
+	}
+}
@@ -1,15 +1,60 @@
 #pragma once
 
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <execution>
+#include <limits>
+#include <cmath>
+
 #include "DataStructures.h"
+#include "Namespace.h"
 
 
 namespace H2A
 {
+	const double NO_DATA = std::numeric_limits<double>::quiet_NaN(); // Value of resampled points where a dataset has no data
+
+	bool timeSpan(const H2A::Dataset* dataset, double& tStart, double& tEnd);
+	bool timeOverlap(const std::vector<const H2A::Dataset*>& datasets, double& tStart, double& tEnd);
+	bool timeUnion(const std::vector<const H2A::Dataset*>& datasets, double& tStart, double& tEnd);
+	void timeGrid(double tStart, double tEnd, double frequency, std::vector<double>& time);
+
+	/**
+	* Resamples a single dataset on a time grid that is passed in consecutive chunks. The position in the dataset
+	* is kept between chunks, so the whole dataset and grid are walked through only once.
+	**/
+	class Resampler
+	{
+		const H2A::Dataset* m_Dataset;
+		H2A::ResampleMode m_Mode;
+		double m_Fill;
+
+		size_t m_Size;
+		double m_tStart;
+		double m_tEnd;
+		size_t m_Cursor = 0; // Number of datapoints at or before the last resampled time
+		size_t m_Lower = 0; // First datapoint in averaging interval of the last resampled time
+		double m_PrevTime = H2A::NO_DATA; // Last resampled time of previous chunk
+		std::vector<size_t> m_Index;
+
+		double sampleTime(size_t i) const { return m_Dataset->datafile->correctTime(m_Dataset->rawTimeVec()[i]); };
+		void seek(double time);
+		void locate(const double* time, size_t n);
+		void interpolate(const double* time, size_t n, double* result);
+		void average(const double* time, size_t n, double* result, double nextTime);
+
+	public:
+		Resampler(const H2A::Dataset* dataset, H2A::ResampleMode mode = H2A::ResampleMode::ZeroOrderHold, double fill = H2A::NO_DATA);
+		void next(const double* time, size_t n, double* result, double nextTime = H2A::NO_DATA);
+	};
 
-	void resample(const H2A::Dataset* dataset, uint16_t freq, std::vector<double>& timeResult, std::vector<double>& dataResult);
-	void resample(const H2A::Dataset* dataset, std::vector<double> time, std::vector<double>& dataResampled, bool trimTime = true);
-	void resample(const std::vector<const H2A::Dataset*> datasets, std::vector<double>& timeResampled, std::vector<std::vector<double>>& dataResampled, uint16_t frequency = 0);
+	void resample(const H2A::Dataset* dataset, const std::vector<double>& time, double* result, H2A::ResampleMode mode = H2A::ResampleMode::ZeroOrderHold, double fill = NO_DATA);
+	void resample(const H2A::Dataset* dataset, const std::vector<double>& time, std::vector<double>& result, H2A::ResampleMode mode = H2A::ResampleMode::ZeroOrderHold, double fill = NO_DATA);
+	void resample(const std::vector<const H2A::Dataset*>& datasets, const std::vector<double>& time, const std::vector<double*>& columns, H2A::ResampleMode mode = H2A::ResampleMode::ZeroOrderHold, double fill = NO_DATA);
+	void resample(const std::vector<const H2A::Dataset*>& datasets, const std::vector<double>& time, std::vector<std::vector<double>>& columns, H2A::ResampleMode mode = H2A::ResampleMode::ZeroOrderHold, double fill = NO_DATA);
+	bool resampleOnOverlap(const std::vector<const H2A::Dataset*>& datasets, double frequency, std::vector<double>& time, std::vector<std::vector<double>>& columns, H2A::ResampleMode mode = H2A::ResampleMode::ZeroOrderHold);
 
-	uint16_t samplingFreq(const H2A::Dataset* dataset);
+	double samplingFreq(const H2A::Dataset* dataset);
 
-}
\ No newline at end of file
+}
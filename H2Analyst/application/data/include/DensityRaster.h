@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <execution>
+#include <thread>
+#include <limits>
+#include <cmath>
+
+#include "DataStructures.h"
+#include "DataOperations.h"
+
+
+namespace H2A
+{
+
+	/**
+	* Renders XY data as a raster: the datapoints are aggregated per pixel, instead of drawn one by one, which keeps
+	* drawing time independent of the number of datapoints. A pixel contains the number of datapoints in it, or the
+	* mean value of a third (color) dataset over those datapoints.
+	**/
+	class DensityRaster
+	{
+		static const size_t CHUNK_SIZE = 1 << 20; // Least number of datapoints that is aggregated by a single thread
+
+		std::vector<double> m_Time;
+		std::vector<std::vector<double>> m_Columns; // X, Y and optionally color, resampled on a common grid
+		size_t m_First = 0;
+		size_t m_Last = 0;
+
+	public:
+		DensityRaster(const std::vector<const H2A::Dataset*>& datasets);
+
+		size_t size() const { return m_Time.size(); };
+		bool hasColor() const { return m_Columns.size() > 2; };
+		void setWindow(double tStart, double tEnd);
+		void render(double xLower, double xUpper, double yLower, double yUpper, size_t width, size_t height, std::vector<double>& cells) const;
+	};
+
+}
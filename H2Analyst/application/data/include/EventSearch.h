@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <execution>
+#include <cmath>
+
+#include "DataStructures.h"
+#include "RangeIndex.h"
+#include "Namespace.h"
+
+
+namespace H2A
+{
+	namespace Events
+	{
+
+		/**
+		* Condition to search for. Single threshold conditions (above, below and edges) use the lower bound as threshold.
+		**/
+		struct Condition {
+			H2A::EventCondition type = H2A::EventCondition::Above;
+			double lower = 0.0;
+			double upper = 0.0;
+			std::vector<double> values; // Values of InSet condition
+		};
+
+		/**
+		* Interval in which a dataset meets a condition, from the first datapoint that meets it up to the first datapoint
+		* that does not. Edges and changes are instants, with equal start and end.
+		**/
+		struct Interval {
+			const H2A::Dataset* dataset = nullptr;
+			double tStart = 0.0;
+			double tEnd = 0.0;
+		};
+
+		void search(const H2A::Dataset* dataset, const Condition& condition, std::vector<Interval>& intervals);
+		void search(const std::vector<const H2A::Dataset*>& datasets, const Condition& condition, std::vector<Interval>& intervals);
+
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <memory>
+#include <deque>
+#include <algorithm>
+#include <numeric>
+#include <execution>
+#include <cmath>
+#include <cctype>
+#include <charconv>
+
+#include "DataStructures.h"
+#include "DataOperations.h"
+
+
+namespace H2A
+{
+
+	/**
+	* Formula over datasets that is compiled into a list of vectorized operations. The formula is evaluated on a common
+	* timebase of its input datasets, in chunks, so it can be used to compute derived datasets of any size.
+	*
+	* Syntax:
+	*   [Dataset name]                 Input dataset, resampled (linear) to the common timebase
+	*   t                              Time
+	*   + - * / ^                      Arithmetic
+	*   < > <= >= == != && || !        Comparisons and logic (1 for true, 0 for false)
+	*   abs sqrt exp log sin cos       Element-wise functions
+	*   min(a, b) max(a, b) if(c, a, b)
+	*   der(x) int(x)                  Time derivative and cumulative (trapezoidal) integral
+	*   movmean(x, s) movmin(x, s) movmax(x, s)  Trailing rolling window of s seconds
+	**/
+	class Expression
+	{
+
+	public:
+		using Lookup = std::function<const H2A::Dataset* (const std::string& name)>;
+
+	private:
+		enum class Op : uint8_t {
+			Input, Const, Time,
+			Neg, Not, Add, Sub, Mul, Div, Pow, Lt, Gt, Le, Ge, Eq, Ne, And, Or,
+			Abs, Sqrt, Exp, Log, Sin, Cos, Min, Max, If,
+			Der, Int, MovMean, MovMin, MovMax,
+		};
+
+		struct Instruction {
+			Op op;
+			size_t input = 0; // Index of input dataset (Input)
+			double value = 0.0; // Constant value (Const) or window length in seconds (MovMean, MovMin, MovMax)
+		};
+
+		// State of stateful operations that is carried from one chunk to the next
+		struct State {
+			double prevTime = std::numeric_limits<double>::quiet_NaN();
+			double prevValue = std::numeric_limits<double>::quiet_NaN();
+			double sum = 0.0;
+			size_t count = 0; // Number of finite values in the window (MovMean)
+			size_t window = 1;
+			size_t index = 0;
+			std::deque<double> values;
+			std::deque<std::pair<size_t, double>> extremes;
+		};
+
+		std::string m_Formula;
+		std::vector<const H2A::Dataset*> m_Inputs;
+		std::vector<Instruction> m_Program;
+
+		// Parser
+		struct Parser;
+
+		void execute(const double* time, size_t n, const std::vector<std::vector<double>>& inputs, std::vector<State>& states, double* result) const;
+
+	public:
+		static std::shared_ptr<Expression> compile(const std::string& formula, const Lookup& lookup, std::string& error);
+
+		const std::string& formula() const { return m_Formula; };
+		const std::vector<const H2A::Dataset*>& inputs() const { return m_Inputs; };
+		bool evaluate(std::vector<double>& time, std::vector<double>& data) const;
+	};
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <execution>
+#include <limits>
+#include <cmath>
+
+#include "DataStructures.h"
+#include "DataOperations.h"
+#include "Namespace.h"
+
+
+namespace H2A
+{
+	namespace Filters
+	{
+
+		const size_t MAX_MEDIAN_WINDOW = 1001; // Largest median window [samples], the median filter is O(window) per sample
+
+		/**
+		* Filter type with its parameter: the window [s] of a moving average or median, the time constant [s] of
+		* exponential smoothing, or the cutoff frequency [Hz] of a (2nd order Butterworth) low or high-pass filter.
+		**/
+		struct Settings {
+			H2A::FilterType type = H2A::FilterType::None;
+			double parameter = 1.0;
+		};
+
+		/**
+		* Causal filter that processes a signal in consecutive blocks, keeping its state between blocks.
+		**/
+		class Filter
+		{
+			Settings m_Settings;
+
+			// Moving average and median
+			size_t m_Window = 1;
+			std::vector<double> m_Ring;
+			size_t m_RingPos = 0;
+			double m_Sum = 0.0;
+			std::vector<double> m_Sorted;
+
+			// Exponential smoothing
+			double m_PrevTime = std::numeric_limits<double>::quiet_NaN();
+
+			// Butterworth biquad
+			double m_B[3] = { 1.0, 0.0, 0.0 };
+			double m_A[3] = { 1.0, 0.0, 0.0 };
+			double m_X[2] = { 0.0, 0.0 };
+			double m_Y[2] = { 0.0, 0.0 };
+			bool m_Initialized = false;
+
+		public:
+			Filter(const Settings& settings, double sampleRate);
+			void process(const double* time, const double* in, size_t n, double* out);
+		};
+
+		void apply(const H2A::Dataset* dataset, const Settings& settings, double* result);
+		void apply(const std::vector<const H2A::Dataset*>& datasets, const Settings& settings, std::vector<std::vector<double>>& results);
+
+	}
+}
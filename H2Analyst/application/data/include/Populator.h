@@ -5,11 +5,15 @@
 #include <QObject>
 #include <QRunnable>
 #include <QMutex>
+#include <QWaitCondition>
 #include <QThreadPool>
+#include <QThread>
 
 #include <armadillo>
 
 #include "DataStructures.h"
+#include "Expression.h"
+#include "Namespace.h"
 
 
 class Populator :
@@ -43,8 +47,16 @@ class PopulatorWorker
 
 	H2A::Dataset* m_ds;
 
+	static QMutex s_PopulatedMutex;
+	static QWaitCondition s_Populated; // Woken whenever a dataset is populated
+
+	void evaluate();
+
 public:
 	PopulatorWorker(H2A::Dataset* dataset);
+
+	static void notifyPopulated();
+	static void waitPopulated(const H2A::Dataset* dataset);
 	
 public slots:
 	void run();
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include <numeric>
+#include <execution>
+#include <cmath>
+
+#include <armadillo>
+
+#include "DataStructures.h"
+#include "DataOperations.h"
+
+
+namespace H2A
+{
+	namespace Spectral
+	{
+
+		const size_t MIN_SEGMENT_SIZE = 16; // Shortest segment [samples] a spectrum is computed of
+		const size_t MAX_COLUMNS = 1000; // Largest number of spectrogram columns, consecutive segments are averaged into one column
+		const size_t CACHE_SIZE = 32; // Number of spectra that are kept in the cache
+
+		/**
+		* Parameters of the Welch method: segment length [samples] and fraction of overlap between segments.
+		**/
+		struct Settings {
+			size_t segmentSize = 4096;
+			double overlap = 0.5;
+			bool spectrogram = false;
+		};
+
+		/**
+		* One-sided power spectral density [unit^2/Hz] and optionally the spectrogram, of which every column is the
+		* averaged spectrum of consecutive segments around the given time.
+		**/
+		struct Result {
+			double samplingFreq = 0.0;
+			double tStart = 0.0;
+			double tEnd = 0.0;
+			std::vector<double> frequency;
+			std::vector<double> psd;
+			std::vector<double> time;
+			arma::mat spectrogram; // Frequency x time
+		};
+
+		bool welch(const H2A::Dataset* dataset, double tStart, double tEnd, const Settings& settings, Result& result);
+		std::shared_ptr<const Result> compute(const H2A::Dataset* dataset, double tStart, double tEnd, const Settings& settings);
+
+	}
+}
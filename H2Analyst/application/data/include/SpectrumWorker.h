@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <QObject>
+#include <QThread>
+
+#include "DataStructures.h"
+#include "Spectral.h"
+
+
+/**
+* Computes the spectra (Welch method) of datasets, or the spectrogram of the first dataset, in a separate thread.
+* The results are stored in the given list, in the order of the datasets, which is complete once finished is emitted.
+**/
+class SpectrumWorker
+	: public QObject
+{
+
+	Q_OBJECT
+
+public:
+	using Spectra = std::vector<std::shared_ptr<const H2A::Spectral::Result>>;
+
+private:
+	std::vector<const H2A::Dataset*> m_Datasets;
+	double m_Start;
+	double m_End;
+	H2A::Spectral::Settings m_Settings;
+	std::shared_ptr<Spectra> m_Spectra;
+
+public:
+	SpectrumWorker(const std::vector<const H2A::Dataset*>& datasets, double tStart, double tEnd, const H2A::Spectral::Settings& settings, const std::shared_ptr<Spectra>& spectra);
+
+public slots:
+	void run();
+
+signals:
+	void finished();
+
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <numeric>
+#include <execution>
+#include <cmath>
+
+#include <armadillo>
+
+#include "DataStructures.h"
+#include "DataOperations.h"
+
+
+namespace H2A
+{
+	namespace Alignment
+	{
+
+		const double MAX_CORRELATION_RATE = 2000.0; // Highest rate [Hz] that signals are resampled to for cross-correlation
+		const double MIN_WINDOW_DURATION = 60.0; // Shortest window [s] used to estimate a single lag
+		const size_t MAX_WINDOWS = 16; // Maximum number of windows used to estimate drift
+
+		/**
+		* Linear time correction: corrected time = time * (1 + drift) + offset.
+		**/
+		struct Correction {
+			double offset = 0.0;
+			double drift = 0.0;
+		};
+
+		Correction compose(const H2A::Datafile* datafile, const Correction& residual);
+		Correction fitLags(const std::vector<std::pair<double, double>>& lags);
+
+		bool fromAnchors(const H2A::Datafile* datafile, const std::vector<std::pair<double, double>>& anchors, Correction& correction);
+		bool fromCrossCorrelation(const H2A::Dataset* reference, const H2A::Dataset* target, double maxLag, Correction& correction);
+
+		bool estimateLag(const std::vector<double>& reference, const std::vector<double>& target, double dt, double maxLag, double& lag);
+
+	}
+}
@@ -0,0 +1,334 @@
+#include "ArrowWriter.h"
+
+namespace
+{
+	/**
+	* Minimal FlatBuffers builder, used for the metadata of the Arrow format. Like the official builder, the buffer is built
+	* back to front, so objects are created before the objects that refer to them. The bytes are stored reversed and the
+	* buffer is reversed when it is finished. Objects are identified by the distance from their start to the end of the buffer.
+	**/
+	class FlatBufferBuilder
+	{
+		std::vector<uint8_t> m_Reversed;
+		size_t m_MinAlign = 1;
+		uint32_t m_TableStart = 0;
+		std::vector<std::pair<uint16_t, uint32_t>> m_Fields; // Id and position of the fields of the table that is being built
+
+		// Pad the buffer such that it is aligned to size after prepending additional bytes
+		void align(size_t size, size_t additional = 0) {
+			m_MinAlign = std::max(m_MinAlign, size);
+			const size_t padding = (~(m_Reversed.size() + additional) + 1) & (size - 1);
+			m_Reversed.insert(m_Reversed.end(), padding, 0);
+		}
+
+		// Prepend a little-endian scalar or struct
+		template <typename T>
+		void push(const T& value) {
+			uint8_t bytes[sizeof(T)];
+			std::memcpy(bytes, &value, sizeof(T));
+			for (size_t i = sizeof(T); i > 0; --i) m_Reversed.push_back(bytes[i - 1]);
+		}
+
+		// Offset from an offset field that is prepended next, to an object
+		uint32_t relative(uint32_t object) const { return static_cast<uint32_t>(m_Reversed.size() + sizeof(uint32_t) - object); }
+
+	public:
+		uint32_t size() const { return static_cast<uint32_t>(m_Reversed.size()); };
+
+		uint32_t createString(const std::string& string) {
+			this->align(sizeof(uint32_t), string.size() + 1);
+			m_Reversed.push_back(0);
+			m_Reversed.insert(m_Reversed.end(), string.rbegin(), string.rend());
+			this->push<uint32_t>(static_cast<uint32_t>(string.size()));
+			return this->size();
+		}
+
+		// Vector of scalars or structs
+		template <typename T>
+		uint32_t createVector(const std::vector<T>& elements, size_t alignment = sizeof(T)) {
+			this->align(sizeof(uint32_t), elements.size() * sizeof(T));
+			this->align(alignment, elements.size() * sizeof(T));
+			for (auto it = elements.rbegin(); it != elements.rend(); ++it) this->push(*it);
+			this->push<uint32_t>(static_cast<uint32_t>(elements.size()));
+			return this->size();
+		}
+
+		// Vector of tables or strings
+		uint32_t createVectorOfObjects(const std::vector<uint32_t>& objects) {
+			this->align(sizeof(uint32_t), objects.size() * sizeof(uint32_t));
+			for (auto it = objects.rbegin(); it != objects.rend(); ++it) this->push<uint32_t>(this->relative(*it));
+			this->push<uint32_t>(static_cast<uint32_t>(objects.size()));
+			return this->size();
+		}
+
+		// Objects that are referred to by the table should be created before the table is started
+		void startTable() {
+			m_Fields.clear();
+			m_TableStart = this->size();
+		}
+
+		template <typename T>
+		void addScalar(uint16_t field, T value) {
+			this->align(sizeof(T));
+			this->push(value);
+			m_Fields.push_back({ field, this->size() });
+		}
+
+		void addObject(uint16_t field, uint32_t object) {
+			this->align(sizeof(uint32_t));
+			this->push<uint32_t>(this->relative(object));
+			m_Fields.push_back({ field, this->size() });
+		}
+
+		uint32_t endTable() {
+			this->align(sizeof(int32_t));
+			this->push<int32_t>(0); // Offset to the vtable, which is filled in when the vtable is written
+			const uint32_t table = this->size();
+
+			// The vtable contains its own size, the size of the table and the position of every field in the table
+			uint16_t nFields = 0;
+			for (const auto& [field, position] : m_Fields) nFields = std::max<uint16_t>(nFields, field + 1);
+			std::vector<uint16_t> vtable(2 + nFields, 0);
+			vtable[0] = static_cast<uint16_t>(vtable.size() * sizeof(uint16_t));
+			vtable[1] = static_cast<uint16_t>(table - m_TableStart);
+			for (const auto& [field, position] : m_Fields) vtable[2 + field] = static_cast<uint16_t>(table - position);
+			for (auto it = vtable.rbegin(); it != vtable.rend(); ++it) this->push(*it);
+
+			uint8_t bytes[sizeof(int32_t)];
+			const int32_t offset = static_cast<int32_t>(this->size() - table);
+			std::memcpy(bytes, &offset, sizeof(int32_t));
+			for (size_t k = 0; k < sizeof(int32_t); ++k) m_Reversed[table - 1 - k] = bytes[k];
+			return table;
+		}
+
+		std::vector<uint8_t> finish(uint32_t root) {
+			this->align(m_MinAlign, sizeof(uint32_t));
+			this->push<uint32_t>(this->relative(root));
+			return std::vector<uint8_t>(m_Reversed.rbegin(), m_Reversed.rend());
+		}
+	};
+
+	// Constants of the Arrow format (Schema.fbs, Message.fbs and File.fbs)
+	const int16_t METADATA_VERSION = 4; // V5
+	const uint8_t TYPE_INT = 2, TYPE_FLOATING_POINT = 3, TYPE_UTF8 = 5;
+	const int16_t PRECISION_DOUBLE = 2;
+	const uint8_t HEADER_SCHEMA = 1, HEADER_DICTIONARY_BATCH = 2, HEADER_RECORD_BATCH = 3;
+	const uint32_t CONTINUATION = 0xFFFFFFFF;
+	const char MAGIC[8] = { 'A', 'R', 'R', 'O', 'W', '1', 0, 0 };
+	const size_t ALIGNMENT = 8;
+
+	struct FieldNode { int64_t length; int64_t nullCount; };
+	struct BufferLocation { int64_t offset; int64_t length; };
+
+	size_t padded(size_t size) { return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; }
+
+	// Vector of key-value pairs, the metadata of a field or schema
+	uint32_t createMetadata(FlatBufferBuilder& fbb, const H2A::Export::ArrowWriter::Metadata& metadata) {
+		std::vector<uint32_t> keyValues;
+		for (const auto& [key, value] : metadata) {
+			const uint32_t keyString = fbb.createString(key);
+			const uint32_t valueString = fbb.createString(value);
+			fbb.startTable();
+			fbb.addObject(0, keyString);
+			fbb.addObject(1, valueString);
+			keyValues.push_back(fbb.endTable());
+		}
+		return fbb.createVectorOfObjects(keyValues);
+	}
+
+	uint32_t createSchema(FlatBufferBuilder& fbb, const std::vector<H2A::Export::ArrowWriter::Column>& columns, const H2A::Export::ArrowWriter::Metadata& metadata) {
+		std::vector<uint32_t> fields;
+		for (const auto& column : columns) {
+			const uint32_t name = fbb.createString(column.name);
+
+			const uint32_t fieldMetadata = createMetadata(fbb, column.metadata);
+			const uint32_t children = fbb.createVectorOfObjects({});
+
+			// Dictionary-encoded columns have the type of the dictionary (strings) and int32 indices
+			const bool dictionary = column.type == H2A::Export::ArrowWriter::Type::Dictionary;
+			uint32_t encoding = 0;
+			if (dictionary) {
+				fbb.startTable();
+				fbb.addScalar<int32_t>(0, 32);
+				fbb.addScalar<uint8_t>(1, true);
+				const uint32_t indexType = fbb.endTable();
+				fbb.startTable();
+				fbb.addScalar<int64_t>(0, 0);
+				fbb.addObject(1, indexType);
+				encoding = fbb.endTable();
+			}
+			fbb.startTable();
+			if (!dictionary) fbb.addScalar<int16_t>(0, PRECISION_DOUBLE);
+			const uint32_t type = fbb.endTable();
+
+			fbb.startTable();
+			fbb.addObject(0, name);
+			fbb.addScalar<uint8_t>(1, column.nullable);
+			fbb.addScalar<uint8_t>(2, dictionary ? TYPE_UTF8 : TYPE_FLOATING_POINT);
+			fbb.addObject(3, type);
+			if (dictionary) fbb.addObject(4, encoding);
+			fbb.addObject(5, children);
+			if (!column.metadata.empty()) fbb.addObject(6, fieldMetadata);
+			fields.push_back(fbb.endTable());
+		}
+		const uint32_t fieldVector = fbb.createVectorOfObjects(fields);
+		const uint32_t schemaMetadata = createMetadata(fbb, metadata);
+
+		fbb.startTable();
+		fbb.addScalar<int16_t>(0, 0); // Little endian
+		fbb.addObject(1, fieldVector);
+		if (!metadata.empty()) fbb.addObject(2, schemaMetadata);
+		return fbb.endTable();
+	}
+
+	uint32_t createRecordBatch(FlatBufferBuilder& fbb, int64_t length, const std::vector<FieldNode>& nodes, const std::vector<BufferLocation>& buffers) {
+		const uint32_t nodeVector = fbb.createVector(nodes, ALIGNMENT);
+		const uint32_t bufferVector = fbb.createVector(buffers, ALIGNMENT);
+		fbb.startTable();
+		fbb.addScalar<int64_t>(0, length);
+		fbb.addObject(1, nodeVector);
+		fbb.addObject(2, bufferVector);
+		return fbb.endTable();
+	}
+
+	std::vector<uint8_t> createMessage(FlatBufferBuilder& fbb, uint8_t headerType, uint32_t header, int64_t bodyLength) {
+		fbb.startTable();
+		fbb.addScalar<int16_t>(0, METADATA_VERSION);
+		fbb.addScalar<uint8_t>(1, headerType);
+		fbb.addObject(2, header);
+		fbb.addScalar<int64_t>(3, bodyLength);
+		return fbb.finish(fbb.endTable());
+	}
+}
+
+/**
+* Create an Arrow file and write its schema, and the dictionary if any of the columns is dictionary-encoded.
+*
+* @param filename Filename of the created file.
+* @param columns Columns of the table.
+* @param dictionary Strings that the indices of dictionary-encoded columns refer to.
+* @param metadata Key-value pairs that describe the whole table.
+**/
+H2A::Export::ArrowWriter::ArrowWriter(const std::string& filename, const std::vector<Column>& columns, const std::vector<std::string>& dictionary, const Metadata& metadata) :
+	m_File(filename, std::ios::binary),
+	m_Columns(columns),
+	m_Metadata(metadata)
+{
+	if (!m_File.is_open()) return;
+	this->write(MAGIC, sizeof(MAGIC));
+
+	FlatBufferBuilder fbb;
+	const uint32_t schema = createSchema(fbb, m_Columns, m_Metadata);
+	this->writeMessage(createMessage(fbb, HEADER_SCHEMA, schema, 0), 0);
+
+	if (std::any_of(m_Columns.begin(), m_Columns.end(), [](const Column& column) { return column.type == Type::Dictionary; }))
+		this->writeDictionary(dictionary);
+}
+
+void H2A::Export::ArrowWriter::write(const void* data, size_t size) {
+	m_File.write(static_cast<const char*>(data), size);
+	m_Position += size;
+}
+
+void H2A::Export::ArrowWriter::pad(size_t size) {
+	const char zeros[ALIGNMENT] = {};
+	this->write(zeros, padded(size) - size);
+}
+
+/**
+* Write the metadata of a message, which is followed by its body.
+**/
+H2A::Export::ArrowWriter::Block H2A::Export::ArrowWriter::writeMessage(const std::vector<uint8_t>& metadata, int64_t bodyLength) {
+	Block block = { m_Position, static_cast<int32_t>(2 * sizeof(int32_t) + padded(metadata.size())), 0, bodyLength };
+	const int32_t length = static_cast<int32_t>(padded(metadata.size()));
+	this->write(&CONTINUATION, sizeof(CONTINUATION));
+	this->write(&length, sizeof(length));
+	this->write(metadata.data(), metadata.size());
+	this->pad(metadata.size());
+	return block;
+}
+
+void H2A::Export::ArrowWriter::writeDictionary(const std::vector<std::string>& dictionary) {
+	std::vector<int32_t> offsets = { 0 };
+	std::string data;
+	for (const auto& string : dictionary) {
+		data += string;
+		offsets.push_back(static_cast<int32_t>(data.size()));
+	}
+	const size_t offsetsLength = offsets.size() * sizeof(int32_t);
+
+	FlatBufferBuilder fbb;
+	const std::vector<BufferLocation> buffers = { { 0, 0 }, { 0, static_cast<int64_t>(offsetsLength) }, { static_cast<int64_t>(padded(offsetsLength)), static_cast<int64_t>(data.size()) } };
+	const int64_t bodyLength = padded(offsetsLength) + padded(data.size());
+	const uint32_t batch = createRecordBatch(fbb, dictionary.size(), { { static_cast<int64_t>(dictionary.size()), 0 } }, buffers);
+	fbb.startTable();
+	fbb.addScalar<int64_t>(0, 0);
+	fbb.addObject(1, batch);
+	const uint32_t header = fbb.endTable();
+
+	m_Dictionaries.push_back(this->writeMessage(createMessage(fbb, HEADER_DICTIONARY_BATCH, header, bodyLength), bodyLength));
+	this->write(offsets.data(), offsetsLength);
+	this->pad(offsetsLength);
+	this->write(data.data(), data.size());
+	this->pad(data.size());
+}
+
+/**
+* Write a record batch, which contains the next rows of all columns.
+*
+* @param length Number of rows in the batch.
+* @param arrays Contents of the columns, in the order of the columns in the schema.
+**/
+void H2A::Export::ArrowWriter::writeBatch(size_t length, const std::vector<Array>& arrays) {
+	std::vector<FieldNode> nodes;
+	std::vector<BufferLocation> buffers;
+	int64_t bodyLength = 0;
+	for (size_t k = 0; k < m_Columns.size(); ++k) {
+		const size_t validityLength = arrays[k].validity ? (length + 7) / 8 : 0;
+		const size_t valuesLength = length * (m_Columns[k].type == Type::Dictionary ? sizeof(int32_t) : sizeof(double));
+		nodes.push_back({ static_cast<int64_t>(length), static_cast<int64_t>(arrays[k].nullCount) });
+		buffers.push_back({ bodyLength, static_cast<int64_t>(validityLength) });
+		bodyLength += padded(validityLength);
+		buffers.push_back({ bodyLength, static_cast<int64_t>(valuesLength) });
+		bodyLength += padded(valuesLength);
+	}
+
+	FlatBufferBuilder fbb;
+	const uint32_t batch = createRecordBatch(fbb, length, nodes, buffers);
+	m_RecordBatches.push_back(this->writeMessage(createMessage(fbb, HEADER_RECORD_BATCH, batch, bodyLength), bodyLength));
+
+	for (size_t k = 0; k < m_Columns.size(); ++k) {
+		if (arrays[k].validity) {
+			this->write(arrays[k].validity, buffers[2 * k].length);
+			this->pad(buffers[2 * k].length);
+		}
+		this->write(arrays[k].values, buffers[2 * k + 1].length);
+		this->pad(buffers[2 * k + 1].length);
+	}
+}
+
+/**
+* Write the end of the stream and the footer, which contains the location of all batches so the file can be read randomly.
+**/
+bool H2A::Export::ArrowWriter::close() {
+	const uint32_t endOfStream[2] = { CONTINUATION, 0 };
+	this->write(endOfStream, sizeof(endOfStream));
+
+	FlatBufferBuilder fbb;
+	const uint32_t schema = createSchema(fbb, m_Columns, m_Metadata);
+	const uint32_t dictionaries = fbb.createVector(m_Dictionaries, ALIGNMENT);
+	const uint32_t recordBatches = fbb.createVector(m_RecordBatches, ALIGNMENT);
+	fbb.startTable();
+	fbb.addScalar<int16_t>(0, METADATA_VERSION);
+	fbb.addObject(1, schema);
+	fbb.addObject(2, dictionaries);
+	fbb.addObject(3, recordBatches);
+	const std::vector<uint8_t> footer = fbb.finish(fbb.endTable());
+
+	const int32_t footerLength = static_cast<int32_t>(footer.size());
+	this->write(footer.data(), footer.size());
+	this->write(&footerLength, sizeof(footerLength));
+	this->write(MAGIC, 6);
+	m_File.close();
+	return !m_File.fail();
+}
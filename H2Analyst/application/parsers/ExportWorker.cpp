@@ -0,0 +1,26 @@
+#include "ExportWorker.h"
+
+ExportWorker::ExportWorker(const std::vector<const H2A::Dataset*>& datasets, const std::string& filename, const H2A::Export::Settings& settings) : QObject(),
+	m_Datasets(datasets),
+	m_Filename(filename),
+	m_Settings(settings)
+{
+}
+
+/**
+* Export the datasets. Progress is only emitted when the percentage changes, so the GUI thread is not flooded with events.
+* The cancel slot is called directly from the GUI thread, since the event loop of this thread is blocked while exporting.
+* When the export fails, finished carries the reason.
+**/
+void ExportWorker::run() {
+	int percentage = -1;
+	std::string error;
+	const bool success = H2A::Export::write(m_Datasets, m_Filename, m_Settings, [&](double fraction) {
+		if (static_cast<int>(fraction * 100) != percentage) {
+			percentage = static_cast<int>(fraction * 100);
+			emit progress(percentage);
+		}
+		return !m_Canceled;
+	}, &error);
+	emit finished(success, QString::fromStdString(error));
+}
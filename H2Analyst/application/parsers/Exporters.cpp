@@ -1,60 +1,869 @@
 #include "Exporters.h"
 
+namespace
+{
+	/**
+	* Append a value to a buffer, as the shortest representation that reads back to the same value or with a fixed
+	* number of significant digits.
+	**/
+	inline char* format(char* out, double value, int precision) {
+		if (precision < 0) return std::to_chars(out, out + H2A::Export::MAX_CELL_LENGTH, value).ptr;
+		return std::to_chars(out, out + H2A::Export::MAX_CELL_LENGTH, value, std::chars_format::general, std::min(precision, H2A::Export::MAX_PRECISION)).ptr;
+	}
+
+	/**
+	* Formats blocks of rows in parallel parts, and writes every block to the file while the next block is formatted.
+	**/
+	class BlockWriter
+	{
+		std::ofstream& m_File;
+		const size_t m_Parts;
+		std::vector<size_t> m_Indices;
+		std::vector<std::string> m_Texts[2]; // Block that is formatted and block that is being written
+		size_t m_Current = 0;
+		std::future<void> m_Writing;
+
+	public:
+		BlockWriter(std::ofstream& file) : m_File(file), m_Parts(std::max(std::thread::hardware_concurrency(), 1u)), m_Indices(m_Parts) {
+			std::iota(m_Indices.begin(), m_Indices.end(), 0);
+		}
+		~BlockWriter() { this->finish(); }
+
+		/**
+		* Format and write a block of rows.
+		*
+		* @param n Number of rows in the block.
+		* @param maxRowLength Upper bound of the length of a formatted row.
+		* @param formatRow Function (row, out) that formats a row to the buffer at out and returns the end of the row.
+		**/
+		template <typename Format>
+		void write(size_t n, size_t maxRowLength, const Format& formatRow) {
+			std::vector<std::string>& text = m_Texts[m_Current];
+			text.resize(m_Parts);
+			std::for_each(std::execution::par, m_Indices.begin(), m_Indices.end(), [&](size_t part) {
+				const size_t first = n * part / m_Parts;
+				const size_t last = n * (part + 1) / m_Parts;
+				text[part].resize((last - first) * maxRowLength);
+				char* out = text[part].data();
+				for (size_t row = first; row < last; ++row) out = formatRow(row, out);
+				text[part].resize(out - text[part].data());
+			});
+
+			this->finish();
+			m_Writing = std::async(std::launch::async, [this, &text]() {
+				for (const auto& part : text) m_File.write(part.data(), part.size());
+			});
+			m_Current ^= 1;
+		}
+
+		// Wait until the last block is written
+		void finish() { if (m_Writing.valid()) m_Writing.get(); }
+	};
+
+	/**
+	* Range [first, last) of the samples of a dataset within a time window, found by binary search on its time vector.
+	*
+	* @param dataset Dataset to find the samples of.
+	* @param tStart Start of the window (corrected time).
+	* @param tEnd End of the window (corrected time).
+	**/
+	std::pair<size_t, size_t> sampleRange(const H2A::Dataset* dataset, double tStart, double tEnd) {
+		const std::vector<double>& time = dataset->rawTimeVec();
+		const auto end = time.begin() + std::min(time.size(), dataset->dataVec.size());
+		const auto first = std::lower_bound(time.begin(), end, dataset->datafile->rawTime(tStart));
+		const auto last = std::upper_bound(first, end, dataset->datafile->rawTime(tEnd));
+		return { first - time.begin(), last - time.begin() };
+	}
+
+	/**
+	* Streaming k-way merge of the time vectors of datasets within a time window, which yields their samples in order of (corrected) time.
+	**/
+	class SampleMerge
+	{
+	public:
+		struct Sample {
+			double time;
+			size_t dataset;
+			size_t index;
+			bool operator>(const Sample& other) const { return time > other.time || (time == other.time && dataset > other.dataset); };
+		};
+
+	private:
+		const std::vector<const H2A::Dataset*>& m_Datasets;
+		std::vector<size_t> m_Ends;
+		std::vector<Sample> m_Heap;
+
+		void push(size_t dataset, size_t index) {
+			m_Heap.push_back({ m_Datasets[dataset]->time(index), dataset, index });
+			std::push_heap(m_Heap.begin(), m_Heap.end(), std::greater<Sample>());
+		}
+
+	public:
+		SampleMerge(const std::vector<const H2A::Dataset*>& datasets, double tStart, double tEnd) : m_Datasets(datasets) {
+			for (size_t k = 0; k < datasets.size(); ++k) {
+				const auto [first, last] = sampleRange(datasets[k], tStart, tEnd);
+				m_Ends.push_back(last);
+				if (first < last) this->push(k, first);
+			}
+		}
+
+		bool empty() const { return m_Heap.empty(); };
+		const Sample& next() const { return m_Heap.front(); };
+
+		Sample pop() {
+			std::pop_heap(m_Heap.begin(), m_Heap.end(), std::greater<Sample>());
+			const Sample sample = m_Heap.back();
+			m_Heap.pop_back();
+			if (sample.index + 1 < m_Ends[sample.dataset]) this->push(sample.dataset, sample.index + 1);
+			return sample;
+		}
+	};
+
+	/**
+	* Samples of datasets within a time window, of one dataset after the other, in the same form as those of SampleMerge.
+	**/
+	class SampleSequence
+	{
+		const std::vector<const H2A::Dataset*>& m_Datasets;
+		std::vector<std::pair<size_t, size_t>> m_Ranges;
+		size_t m_Dataset = 0;
+		size_t m_Index = 0;
+
+		// Move to the next dataset with samples left, if the current one has none
+		void skipEmpty() {
+			while (m_Dataset < m_Ranges.size() && m_Index >= m_Ranges[m_Dataset].second)
+				if (++m_Dataset < m_Ranges.size()) m_Index = m_Ranges[m_Dataset].first;
+		}
+
+	public:
+		SampleSequence(const std::vector<const H2A::Dataset*>& datasets, double tStart, double tEnd) : m_Datasets(datasets) {
+			for (const auto& dataset : datasets) m_Ranges.push_back(sampleRange(dataset, tStart, tEnd));
+			if (!m_Ranges.empty()) m_Index = m_Ranges.front().first;
+			this->skipEmpty();
+		}
+
+		bool empty() const { return m_Dataset >= m_Ranges.size(); };
+
+		SampleMerge::Sample pop() {
+			const SampleMerge::Sample sample = { m_Datasets[m_Dataset]->time(m_Index), m_Dataset, m_Index };
+			++m_Index;
+			this->skipEmpty();
+			return sample;
+		}
+	};
+
+	/**
+	* Escape a string to be used in JSON.
+	**/
+	std::string jsonString(const std::string& text) {
+		std::string escaped = "\"";
+		for (const char c : text) {
+			if (c == '"' || c == '\\') escaped += '\\';
+			if (static_cast<unsigned char>(c) < 0x20) escaped += ' ';
+			else escaped += c;
+		}
+		return escaped + "\"";
+	}
+
+	/**
+	* Schema metadata of a table in which the datasets are rows (long formats): the definition of every dataset as a JSON object,
+	* keyed by the name of the dataset, as the column metadata of a table with a column per dataset cannot hold it.
+	**/
+	H2A::Export::ArrowWriter::Metadata signalMetadata(const std::vector<const H2A::Dataset*>& datasets) {
+		H2A::Export::ArrowWriter::Metadata metadata;
+		for (const auto& dataset : datasets) {
+			std::string json = "{\"unit\": " + jsonString(dataset->unit) + ", \"quantity\": " + jsonString(dataset->quantity) + ", \"uid\": " + std::to_string(dataset->uid);
+			if (dataset->datafile) json += ", \"datafile\": " + jsonString(dataset->datafile->name);
+			metadata.push_back({ dataset->name, json + "}" });
+		}
+		return metadata;
+	}
+
+	/**
+	* Arrow column of a dataset, with the definition of the dataset as metadata.
+	**/
+	H2A::Export::ArrowWriter::Column arrowColumn(const H2A::Dataset* dataset, bool nullable) {
+		H2A::Export::ArrowWriter::Column column;
+		column.name = dataset->name;
+		column.nullable = nullable;
+		column.metadata = { { "unit", dataset->unit }, { "quantity", dataset->quantity }, { "uid", std::to_string(dataset->uid) } };
+		if (dataset->datafile) column.metadata.push_back({ "datafile", dataset->datafile->name });
+		return column;
+	}
+
+	/**
+	* Valid and unique MATLAB variable name for a dataset: alphanumeric characters and underscores, starting with a letter.
+	**/
+	std::string variableName(const std::string& name, std::set<std::string>& used) {
+		std::string variable;
+		for (const char c : name) variable += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+		if (variable.empty() || !std::isalpha(static_cast<unsigned char>(variable.front()))) variable = "x" + variable;
+		variable = variable.substr(0, 58);
+		const std::string base = variable;
+		for (size_t i = 2; used.count(variable); ++i) variable = base + "_" + std::to_string(i);
+		used.insert(variable);
+		return variable;
+	}
+
+	size_t sampleCount(const std::vector<const H2A::Dataset*>& datasets, double tStart, double tEnd) {
+		size_t count = 0;
+		for (const auto& dataset : datasets) {
+			const auto [first, last] = sampleRange(dataset, tStart, tEnd);
+			count += last - first;
+		}
+		return count;
+	}
+
+	/**
+	* Start time and number of rows of the grid of a resampled export, which covers the datasets within the time window.
+	**/
+	size_t gridRows(const std::vector<const H2A::Dataset*>& datasets, const H2A::Export::Settings& settings, double& tStart) {
+		double tEnd = -1.0;
+		tStart = 0.0;
+		H2A::timeUnion(datasets, tStart, tEnd);
+		tStart = std::max(tStart, settings.tStart);
+		tEnd = std::min(tEnd, settings.tEnd);
+		if (tEnd < tStart) return 0;
+		return static_cast<size_t>(std::floor((tEnd - tStart) * settings.resamplingFreq + 1e-9)) + 1;
+	}
+
+	/**
+	* Resamples datasets block by block on the grid of a resampled export. The resamplers keep their position between blocks
+	* and get the first time of the next block, so averaging intervals at block boundaries are the same as within a block.
+	**/
+	class GridResampler
+	{
+		std::vector<H2A::Resampler> m_Resamplers;
+		std::vector<size_t> m_Indices;
+		const double m_tStart;
+		const double m_Frequency;
+		const size_t m_Rows;
+
+		double gridTime(size_t row) const { return m_tStart + row / m_Frequency; };
+
+	public:
+		GridResampler(const std::vector<const H2A::Dataset*>& datasets, const H2A::Export::Settings& settings, double tStart, size_t rows) :
+			m_Indices(datasets.size()), m_tStart(tStart), m_Frequency(settings.resamplingFreq), m_Rows(rows)
+		{
+			for (const auto& dataset : datasets) m_Resamplers.emplace_back(dataset, settings.mode, 0.0);
+			std::iota(m_Indices.begin(), m_Indices.end(), 0);
+		}
+
+		/**
+		* Resample the block of n rows that starts at the given row, blocks must be resampled in order.
+		*
+		* @param first First row of the block.
+		* @param n Number of rows in the block.
+		* @param time Vector to store the time of the rows in.
+		* @param columns Vector to store the resampled data in, one column per dataset.
+		**/
+		void block(size_t first, size_t n, std::vector<double>& time, std::vector<std::vector<double>>& columns) {
+			time.resize(n);
+			for (size_t step = 0; step < n; ++step) time[step] = this->gridTime(first + step);
+			const double nextTime = first + n < m_Rows ? this->gridTime(first + n) : H2A::NO_DATA;
+
+			columns.resize(m_Resamplers.size());
+			for (auto& column : columns) column.resize(n);
+			std::for_each(std::execution::par, m_Indices.begin(), m_Indices.end(), [&](size_t i) {
+				m_Resamplers[i].next(time.data(), n, columns[i].data(), nextTime);
+			});
+		}
+	};
+
+	/**
+	* Report why an export failed, to the log and to the caller, which can show it to the user.
+	**/
+	bool fail(std::string* error, const std::string& reason) {
+		H2A::logWarning("Export failed: " + reason);
+		if (error) *error = reason;
+		return false;
+	}
+
+	/**
+	* Open a file for export and write the header line to it.
+	**/
+	bool open(std::ofstream& file, const std::string& filename, const std::string& header, std::string* error) {
+		file.open(filename, std::ios::binary);
+		if (!file.is_open()) return fail(error, "Could not open " + filename + " for writing.");
+		file << header << "\n";
+		return true;
+	}
+
+	/**
+	* Close an exported file. The partially written file is removed when the export was canceled.
+	**/
+	bool close(std::ofstream& file, const std::string& filename, bool canceled, std::string* error) {
+		file.close();
+		if (canceled) {
+			std::remove(filename.c_str());
+			return false;
+		}
+		if (file.fail()) return fail(error, "Could not write " + filename + ".");
+		return true;
+	}
+}
+
+/**
+* Export datasets to a file in the format and layout of the settings. In the IntCanLog format, the datafile of the first
+* dataset is exported.
+*
+* @param datasets Datasets to export.
+* @param filename Filename of the created file.
+* @param settings Settings of the export.
+* @param progress Function that is called after every block with the exported fraction, which can cancel the export.
+* @param error Set to the reason of a failed export, if given.
+**/
+bool H2A::Export::write(const std::vector<const H2A::Dataset*> datasets, const std::string filename, const Settings& settings, const Progress& progress, std::string* error) {
+	if (datasets.empty()) return fail(error, "No datasets to export.");
+	if (settings.format == H2A::ExportFormat::Arrow) return H2A::Export::Arrow(datasets, filename, settings, progress, error);
+	if (settings.format == H2A::ExportFormat::MAT) return H2A::Export::MAT(datasets, filename, settings, progress, error);
+	if (settings.format == H2A::ExportFormat::IntCanLog) return H2A::Export::IntCanLog(datasets.front()->datafile, filename, settings, progress, error);
+
+	switch (settings.layout) {
+	case H2A::ExportLayout::EventTable:
+		return H2A::Export::CSVEvents(datasets, filename, settings, progress, error);
+	case H2A::ExportLayout::LongFormat:
+	case H2A::ExportLayout::PerSignal:
+		return H2A::Export::CSVLong(datasets, filename, settings, progress, error);
+	default:
+		return H2A::Export::CSV(datasets, filename, settings, progress, error);
+	}
+}
+
 /**
-* CSV export function. Creates a file with given filename and exports the given datasets to it. Optionally, the data is resampled to a given frequency before exporting.
+* CSV export function. Creates a file with given filename and exports the given datasets to it, resampled to the frequency
+* and with the resampling method of the settings. Averaging prevents aliasing when data is exported at a lower frequency
+* than it was logged at. The data is resampled and formatted in blocks, so memory use does not depend on the length of
+* the export. Every block is formatted in parallel, while the previous block is written to the file.
 *
 * @param datasets Datasets to export.
 * @param filename Filename of the created file.
-* @param resamplingFreq Frequency to resample all data to before exporting.
+* @param settings Settings of the export.
+* @param progress Function that is called after every block with the exported fraction, which can cancel the export.
+* @param error Set to the reason of a failed export, if given.
 **/
-void H2A::Export::CSV(const std::vector<const H2A::Dataset*> datasets, const std::string filename, const uint16_t resamplingFreq) {
+bool H2A::Export::CSV(const std::vector<const H2A::Dataset*> datasets, const std::string filename, const Settings& settings, const Progress& progress, std::string* error) {
 
-	std::cout << "Exporting " << datasets.size() << " datasets to CSV format... ";
+	H2A::logInfo("Exporting " + std::to_string(datasets.size()) + " datasets to CSV format");
 
-	std::ofstream file(filename);
+	std::string header = "time";
+	for (const auto& dataset : datasets) header += "," + dataset->name;
+	std::ofstream file;
+	if (settings.resamplingFreq <= 0.0) return fail(error, "The resampling frequency must be positive.");
+	if (!open(file, filename, header, error)) return false;
 
-	// Write header to file
-	file << "time,";
-	for (const auto& dataset : datasets) {
-		file << dataset->name;
-		if (dataset != datasets.back()) file << ",";
+	// Determine time span of the export, the time grid itself is created per block
+	double tStart;
+	const size_t rows = gridRows(datasets, settings, tStart);
+	const int precision = settings.precision;
+
+	GridResampler resampler(datasets, settings, tStart, rows);
+	std::vector<double> time;
+	std::vector<std::vector<double>> columns;
+	bool canceled = false;
+	{
+		BlockWriter writer(file);
+		for (size_t block = 0; block < rows && !canceled; block += BLOCK_ROWS) {
+			const size_t n = std::min(BLOCK_ROWS, rows - block);
+			resampler.block(block, n, time, columns);
+
+			writer.write(n, (columns.size() + 1) * (MAX_CELL_LENGTH + 1), [&](size_t row, char* out) {
+				out = format(out, time[row], precision);
+				for (const auto& column : columns) {
+					*out++ = ',';
+					out = format(out, column[row], precision);
+				}
+				*out++ = '\n';
+				return out;
+			});
+
+			if (progress) canceled = !progress(static_cast<double>(block + n) / rows);
+		}
+	}
+	return close(file, filename, canceled, error);
+}
+
+/**
+* CSV export function that writes the datasets at their native timestamps, without resampling. Every row contains one of the
+* timestamps of any of the datasets, with the values of the datasets that have a sample at that time and empty cells for the
+* others. Rows are created by merging the time vectors of the datasets, so memory use does not depend on the length of the export.
+*
+* @param datasets Datasets to export.
+* @param filename Filename of the created file.
+* @param settings Settings of the export.
+* @param progress Function that is called after every block with the exported fraction, which can cancel the export.
+* @param error Set to the reason of a failed export, if given.
+**/
+bool H2A::Export::CSVEvents(const std::vector<const H2A::Dataset*> datasets, const std::string filename, const Settings& settings, const Progress& progress, std::string* error) {
+
+	H2A::logInfo("Exporting " + std::to_string(datasets.size()) + " datasets to CSV event table");
+
+	std::string header = "time";
+	for (const auto& dataset : datasets) header += "," + dataset->name;
+	std::ofstream file;
+	if (!open(file, filename, header, error)) return false;
+
+	const size_t NONE = std::numeric_limits<size_t>::max();
+	const size_t nColumns = datasets.size();
+	const int precision = settings.precision;
+	const size_t total = sampleCount(datasets, settings.tStart, settings.tEnd);
+	SampleMerge merge(datasets, settings.tStart, settings.tEnd);
+	std::vector<double> time(BLOCK_ROWS);
+	std::vector<size_t> cells(BLOCK_ROWS * nColumns); // Sample index per row and dataset
+	size_t exported = 0;
+	bool canceled = false;
+	{
+		BlockWriter writer(file);
+		while (!merge.empty() && !canceled) {
+			std::fill(cells.begin(), cells.end(), NONE);
+			size_t n = 0;
+			for (; n < BLOCK_ROWS && !merge.empty(); ++n) {
+				// All samples at the same time end up in one row, unless a dataset has multiple samples at that time
+				time[n] = merge.next().time;
+				size_t* row = &cells[n * nColumns];
+				while (!merge.empty() && merge.next().time == time[n] && row[merge.next().dataset] == NONE) {
+					const auto sample = merge.pop();
+					row[sample.dataset] = sample.index;
+					++exported;
+				}
+			}
+
+			writer.write(n, (nColumns + 1) * (MAX_CELL_LENGTH + 1), [&](size_t row, char* out) {
+				out = format(out, time[row], precision);
+				for (size_t k = 0; k < nColumns; ++k) {
+					*out++ = ',';
+					const size_t index = cells[row * nColumns + k];
+					if (index != NONE) out = format(out, datasets[k]->dataVec[index], precision);
+				}
+				*out++ = '\n';
+				return out;
+			});
+
+			if (progress) canceled = !progress(static_cast<double>(exported) / total);
+		}
+	}
+	return close(file, filename, canceled, error);
+}
+
+/**
+* CSV export function that writes every sample of the datasets as a (time, signal, value) row, in order of time, or in the
+* per signal layout with the samples of one dataset after the other. The size of the file is proportional to the number of
+* samples, regardless of how the sampling rates of the datasets differ.
+*
+* @param datasets Datasets to export.
+* @param filename Filename of the created file.
+* @param settings Settings of the export.
+* @param progress Function that is called after every block with the exported fraction, which can cancel the export.
+* @param error Set to the reason of a failed export, if given.
+**/
+bool H2A::Export::CSVLong(const std::vector<const H2A::Dataset*> datasets, const std::string filename, const Settings& settings, const Progress& progress, std::string* error) {
+
+	H2A::logInfo("Exporting " + std::to_string(datasets.size()) + " datasets to long format CSV");
+
+	std::ofstream file;
+	if (!open(file, filename, "time,signal,value", error)) return false;
+
+	size_t maxNameLength = 0;
+	for (const auto& dataset : datasets) maxNameLength = std::max(maxNameLength, dataset->name.size());
+
+	const int precision = settings.precision;
+	const size_t total = sampleCount(datasets, settings.tStart, settings.tEnd);
+	const bool perSignal = settings.layout == H2A::ExportLayout::PerSignal;
+	SampleMerge merge(datasets, settings.tStart, settings.tEnd);
+	SampleSequence sequence(datasets, settings.tStart, settings.tEnd);
+	auto empty = [&]() { return perSignal ? sequence.empty() : merge.empty(); };
+	std::vector<SampleMerge::Sample> samples(BLOCK_ROWS);
+	size_t exported = 0;
+	bool canceled = false;
+	{
+		BlockWriter writer(file);
+		while (!empty() && !canceled) {
+			size_t n = 0;
+			for (; n < BLOCK_ROWS && !empty(); ++n) samples[n] = perSignal ? sequence.pop() : merge.pop();
+			exported += n;
+
+			writer.write(n, 3 * (MAX_CELL_LENGTH + 1) + maxNameLength, [&](size_t row, char* out) {
+				const auto& sample = samples[row];
+				const std::string& name = datasets[sample.dataset]->name;
+				out = format(out, sample.time, precision);
+				*out++ = ',';
+				out = std::copy(name.begin(), name.end(), out);
+				*out++ = ',';
+				out = format(out, datasets[sample.dataset]->dataVec[sample.index], precision);
+				*out++ = '\n';
+				return out;
+			});
+
+			if (progress) canceled = !progress(static_cast<double>(exported) / total);
+		}
+	}
+	return close(file, filename, canceled, error);
+}
+
+/**
+* Export function to the Arrow IPC file format (Feather v2), which can be read by pandas and Polars without parsing and can
+* be memory-mapped. Every dataset is stored as a float64 column with its unit, quantity and uid as metadata.
+* The layouts are the same as those of the CSV exports:
+*   Resampled    Time column and a column per dataset, resampled to a given frequency.
+*   EventTable   Native timestamps of all datasets, with nulls for the datasets without a sample at that time.
+*   LongFormat   Time, signal (dictionary-encoded) and value columns, with the samples of all datasets in order of time.
+*   PerSignal    The columns of the long format, with the samples of one dataset after the other. The values are written from
+*                the datasets without copying them, as are the times when the datafile has no time correction.
+* In the long and per signal layouts the unit, quantity, uid and datafile of every dataset are schema metadata, keyed by signal.
+*
+* @param datasets Datasets to export.
+* @param filename Filename of the created file.
+* @param settings Settings of the export.
+* @param progress Function that is called after every batch with the exported fraction, which can cancel the export.
+* @param error Set to the reason of a failed export, if given.
+**/
+bool H2A::Export::Arrow(const std::vector<const H2A::Dataset*> datasets, const std::string filename, const Settings& settings, const Progress& progress, std::string* error) {
+
+	H2A::logInfo("Exporting " + std::to_string(datasets.size()) + " datasets to Arrow format");
+
+	using Column = H2A::Export::ArrowWriter::Column;
+	using Array = H2A::Export::ArrowWriter::Array;
+	const H2A::ExportLayout layout = settings.layout;
+	const Column timeColumn = { "time", H2A::Export::ArrowWriter::Type::Float64, false, { { "unit", "s" } } };
+
+	std::vector<Column> columns = { timeColumn };
+	std::vector<std::string> dictionary;
+	H2A::Export::ArrowWriter::Metadata metadata;
+	if (layout == H2A::ExportLayout::LongFormat || layout == H2A::ExportLayout::PerSignal) {
+		columns.push_back({ "signal", H2A::Export::ArrowWriter::Type::Dictionary });
+		columns.push_back({ "value" });
+		for (const auto& dataset : datasets) dictionary.push_back(dataset->name);
+		metadata = signalMetadata(datasets);
+	}
+	else {
+		for (const auto& dataset : datasets) columns.push_back(arrowColumn(dataset, layout == H2A::ExportLayout::EventTable));
+	}
+
+	if (layout == H2A::ExportLayout::Resampled && settings.resamplingFreq <= 0.0) return fail(error, "The resampling frequency must be positive.");
+	H2A::Export::ArrowWriter writer(filename, columns, dictionary, metadata);
+	if (!writer.isOpen()) return fail(error, "Could not open " + filename + " for writing.");
+
+	bool canceled = false;
+	std::vector<double> time;
+	std::vector<Array> arrays(columns.size());
+	switch (layout) {
+	case H2A::ExportLayout::Resampled: {
+		double tStart;
+		const size_t rows = gridRows(datasets, settings, tStart);
+
+		GridResampler resampler(datasets, settings, tStart, rows);
+		std::vector<std::vector<double>> values;
+		for (size_t block = 0; block < rows && !canceled; block += BLOCK_ROWS) {
+			const size_t n = std::min(BLOCK_ROWS, rows - block);
+			resampler.block(block, n, time, values);
+
+			arrays[0].values = time.data();
+			for (size_t k = 0; k < values.size(); ++k) arrays[k + 1].values = values[k].data();
+			writer.writeBatch(n, arrays);
+
+			if (progress) canceled = !progress(static_cast<double>(block + n) / rows);
+		}
+		break;
+	}
+	case H2A::ExportLayout::EventTable: {
+		const size_t total = sampleCount(datasets, settings.tStart, settings.tEnd);
+		SampleMerge merge(datasets, settings.tStart, settings.tEnd);
+		std::vector<std::vector<double>> values(datasets.size(), std::vector<double>(BLOCK_ROWS));
+		std::vector<std::vector<uint8_t>> validity(datasets.size(), std::vector<uint8_t>(BLOCK_ROWS / 8 + 1));
+		time.resize(BLOCK_ROWS);
+		size_t exported = 0;
+		while (!merge.empty() && !canceled) {
+			for (auto& bitmap : validity) std::fill(bitmap.begin(), bitmap.end(), 0);
+			size_t n = 0;
+			for (; n < BLOCK_ROWS && !merge.empty(); ++n) {
+				time[n] = merge.next().time;
+				while (!merge.empty() && merge.next().time == time[n] && !(validity[merge.next().dataset][n / 8] & (1 << (n % 8)))) {
+					const auto sample = merge.pop();
+					values[sample.dataset][n] = datasets[sample.dataset]->dataVec[sample.index];
+					validity[sample.dataset][n / 8] |= 1 << (n % 8);
+					++exported;
+				}
+			}
+
+			arrays[0].values = time.data();
+			for (size_t k = 0; k < datasets.size(); ++k) {
+				size_t valid = 0;
+				for (size_t row = 0; row < n; ++row) valid += (validity[k][row / 8] >> (row % 8)) & 1;
+				arrays[k + 1] = { values[k].data(), validity[k].data(), n - valid };
+			}
+			writer.writeBatch(n, arrays);
+
+			if (progress) canceled = !progress(static_cast<double>(exported) / total);
+		}
+		break;
+	}
+	case H2A::ExportLayout::LongFormat: {
+		const size_t total = sampleCount(datasets, settings.tStart, settings.tEnd);
+		SampleMerge merge(datasets, settings.tStart, settings.tEnd);
+		std::vector<int32_t> signal(BLOCK_ROWS);
+		std::vector<double> values(BLOCK_ROWS);
+		time.resize(BLOCK_ROWS);
+		size_t exported = 0;
+		while (!merge.empty() && !canceled) {
+			size_t n = 0;
+			for (; n < BLOCK_ROWS && !merge.empty(); ++n) {
+				const auto sample = merge.pop();
+				time[n] = sample.time;
+				signal[n] = static_cast<int32_t>(sample.dataset);
+				values[n] = datasets[sample.dataset]->dataVec[sample.index];
+			}
+
+			arrays[0].values = time.data();
+			arrays[1].values = signal.data();
+			arrays[2].values = values.data();
+			writer.writeBatch(n, arrays);
+
+			exported += n;
+			if (progress) canceled = !progress(static_cast<double>(exported) / total);
+		}
+		break;
+	}
+	case H2A::ExportLayout::PerSignal: {
+		const size_t total = sampleCount(datasets, settings.tStart, settings.tEnd);
+		std::vector<int32_t> signal;
+		size_t exported = 0;
+		for (size_t k = 0; k < datasets.size() && !canceled; ++k) {
+			const H2A::Dataset* dataset = datasets[k];
+			const auto [first, last] = sampleRange(dataset, settings.tStart, settings.tEnd);
+			const bool corrected = dataset->datafile->timeOffset != 0.0 || dataset->datafile->timeDrift != 0.0;
+			for (size_t start = first; start < last && !canceled; start += BLOCK_ROWS) {
+				const size_t n = std::min(BLOCK_ROWS, last - start);
+				if (corrected) {
+					time.resize(n);
+					for (size_t i = 0; i < n; ++i) time[i] = dataset->time(start + i);
+				}
+				signal.assign(n, static_cast<int32_t>(k));
+
+				arrays[0].values = corrected ? time.data() : dataset->rawTimeVec().data() + start;
+				arrays[1].values = signal.data();
+				arrays[2].values = dataset->dataVec.data() + start;
+				writer.writeBatch(n, arrays);
+
+				exported += n;
+				if (progress) canceled = !progress(static_cast<double>(exported) / total);
+			}
+		}
+		break;
+	}
+	}
+
+	const bool success = writer.close();
+	if (canceled) {
+		std::remove(filename.c_str());
+		return false;
 	}
-	file << "\n";
+	if (!success) return fail(error, "Could not write " + filename + ".");
+	return true;
+}
+
+/**
+* Export function to a MAT-file, which contains a struct for every dataset with its time and data vectors at their native
+* timestamps (within the time window of the settings), and its unit, quantity, uid and datafile. Variables are named after
+* the datasets. Uncompressed variables are written in chunks, compressed variables are assembled in memory one at a time.
+*
+* @param datasets Datasets to export.
+* @param filename Filename of the created file.
+* @param settings Settings of the export.
+* @param progress Function that is called after every chunk with the exported fraction, which can cancel the export.
+* @param error Set to the reason of a failed export, if given.
+**/
+bool H2A::Export::MAT(const std::vector<const H2A::Dataset*> datasets, const std::string filename, const Settings& settings, const Progress& progress, std::string* error) {
+
+	H2A::logInfo("Exporting " + std::to_string(datasets.size()) + " datasets to MAT format");
 
-	// Determine time span of datasets and create resampled time vector
-	std::vector<double> timeVec = datasets.front()->timeVec();
-	double tStart = timeVec.front();
-	double tEnd = timeVec.back();
+	using Array = H2A::Export::MatWriter::Array;
+	H2A::Export::MatWriter writer(filename);
+	if (!writer.isOpen()) return fail(error, "Could not open " + filename + " for writing.");
+
+	const double total = 2.0 * sizeof(double) * sampleCount(datasets, settings.tStart, settings.tEnd);
+	double written = 0.0;
+	bool canceled = false;
+	bool success = true;
+	std::set<std::string> names;
 	for (const auto& dataset : datasets) {
-		std::vector<double> timeVec = dataset->timeVec();
-		auto minMaxTime = std::minmax_element(timeVec.begin(), timeVec.end());
-		tStart = std::min({ tStart, *minMaxTime.first });
-		tEnd = std::max({ tEnd, *minMaxTime.second });
-	}
-
-	// Create time vector
-	double duration = tEnd - tStart;
-	std::vector<double> time(duration * resamplingFreq);
-	for (size_t i = 0; i < time.size(); ++i)
-		time[i] = tStart + i * (1.0 / resamplingFreq);
-
-	// Resample data
-	std::vector<std::vector<double>> resampledData;
-	for (size_t i = 0; i < datasets.size(); ++i)
-		resampledData.push_back(std::vector<double>(time.size()));
-	for (size_t i = 0; i < datasets.size(); ++i)
-		H2A::resample(datasets[i], time, resampledData[i], false);
-
-	// Write data to file
-	for (size_t time_i = 0; time_i < time.size(); ++ time_i) {
-		file << time[time_i] << ",";
-		for (size_t dataset_i = 0; dataset_i < datasets.size(); ++ dataset_i) {
-			file << resampledData[dataset_i][time_i];
-			if (dataset_i != datasets.size() - 1) file << ",";
-		}
-		file << "\n";
-	}
-	file.close();
-	
-	std::cout << "done" << std::endl;
-}
\ No newline at end of file
+		const auto [first, last] = sampleRange(dataset, settings.tStart, settings.tEnd);
+
+		Array time;
+		time.rows = static_cast<uint32_t>(last - first);
+		time.cols = 1;
+		time.size = (last - first) * sizeof(double);
+		time.produce = [&, first = first, last = last](const H2A::Export::MatWriter::Output& output) {
+			std::vector<double> chunk;
+			for (size_t start = first; start < last; start += BLOCK_ROWS) {
+				chunk.resize(std::min(BLOCK_ROWS, last - start));
+				for (size_t i = 0; i < chunk.size(); ++i) chunk[i] = dataset->time(start + i);
+				if (!output(chunk.data(), chunk.size() * sizeof(double))) return false;
+			}
+			return true;
+		};
+
+		Array data = time;
+		data.produce = [&, first = first, last = last](const H2A::Export::MatWriter::Output& output) {
+			for (size_t start = first; start < last; start += BLOCK_ROWS)
+				if (!output(dataset->dataVec.data() + start, std::min(BLOCK_ROWS, last - start) * sizeof(double))) return false;
+			return true;
+		};
+
+		const Array structure = Array::structure({
+			{ "time", time },
+			{ "data", data },
+			{ "unit", Array::text(dataset->unit) },
+			{ "quantity", Array::text(dataset->quantity) },
+			{ "uid", Array::matrix(MatWriter::mxUINT32_CLASS, MatWriter::miUINT32, std::vector<uint32_t>{ dataset->uid }) },
+			{ "datafile", Array::text(dataset->datafile->name) },
+		});
+		const std::string name = variableName(dataset->name, names);
+		if (settings.compress && !MatWriter::compressible(structure, name)) {
+			writer.close();
+			std::remove(filename.c_str());
+			return fail(error, dataset->name + " is too large to compress. Export it uncompressed.");
+		}
+		success = writer.write(name, structure, settings.compress, [&](size_t bytes) {
+			written += bytes;
+			canceled = progress && !progress(std::min(written / total, 1.0));
+			return !canceled;
+		});
+		if (!success) break;
+	}
+
+	success = writer.close() && success;
+	if (!success) {
+		std::remove(filename.c_str());
+		return canceled ? false : fail(error, "Could not write " + filename + ".");
+	}
+	return true;
+}
+
+/**
+* Export function to a MAT-file in the format of the logs of the car (startTime, datasets and messages), which can be loaded
+* again by the IntCanLog parser. Used to save merged, aligned or trimmed datafiles: the messages within the time window of the
+* settings are written on the corrected timebase, with the start time moved to the first message and shifted by the time
+* correction on top of the start time offset, so the log is aligned again when it is loaded with its time vectors aligned.
+* Message intervals are stored in milliseconds as 16-bit integers, so longer gaps (e.g. between merged logs) are bridged
+* with empty messages.
+* Uncompressed, the message table is written in chunks. Compressed, it is assembled in memory before it is written.
+*
+* @param datafile Datafile to export.
+* @param filename Filename of the created file.
+* @param settings Settings of the export.
+* @param progress Function that is called after every chunk with the exported fraction, which can cancel the export.
+* @param error Set to the reason of a failed export, if given.
+**/
+bool H2A::Export::IntCanLog(const H2A::Datafile* datafile, const std::string filename, const Settings& settings, const Progress& progress, std::string* error) {
+
+	H2A::logInfo("Exporting " + datafile->name + " to IntCanLog format");
+
+	using Array = H2A::Export::MatWriter::Array;
+	using MatWriter = H2A::Export::MatWriter;
+
+	if (datafile->message_time == nullptr || datafile->message_ids == nullptr || datafile->messages == nullptr) {
+		return fail(error, datafile->name + " has no messages, only logs of the car can be exported as a log.");
+	}
+
+	// Messages within the time window
+	const arma::Row<double>& messageTime = *datafile->message_time;
+	const size_t first = std::lower_bound(messageTime.begin(), messageTime.end(), datafile->rawTime(settings.tStart)) - messageTime.begin();
+	const size_t last = std::upper_bound(messageTime.begin() + first, messageTime.end(), datafile->rawTime(settings.tEnd)) - messageTime.begin();
+	if (first == last) {
+		return fail(error, datafile->name + " has no messages in the time range.");
+	}
+
+	// Message times in milliseconds since the start time of the datafile, with the drift correction applied
+	auto milliseconds = [&](size_t col) { return std::llround(messageTime[col] * (1.0 + datafile->timeDrift) * 1000.0); };
+	size_t fillers = 0;
+	for (size_t col = first + 1; col < last; ++col)
+		fillers += static_cast<size_t>(std::max<int64_t>(milliseconds(col) - milliseconds(col - 1) - 1, 0) / MAX_MESSAGE_INTERVAL);
+
+	// Rows: ID (2 bytes), time since previous message (2 bytes) and message data
+	const size_t dataRows = datafile->messages->n_rows;
+	Array messages;
+	messages.arrayClass = MatWriter::mxUINT8_CLASS;
+	messages.type = MatWriter::miUINT8;
+	messages.rows = static_cast<uint32_t>(4 + dataRows);
+	messages.cols = static_cast<uint32_t>(last - first + fillers);
+	messages.size = static_cast<size_t>(messages.rows) * (last - first + fillers);
+	messages.produce = [&](const MatWriter::Output& output) {
+		const size_t CHUNK_COLUMNS = 65536;
+		std::vector<uint8_t> chunk;
+		chunk.reserve(CHUNK_COLUMNS * (4 + dataRows));
+		auto append = [&](uint16_t id, int16_t interval, const uint8_t* data) {
+			const uint8_t header[4] = { static_cast<uint8_t>(id & 0xFF), static_cast<uint8_t>(id >> 8), static_cast<uint8_t>(interval & 0xFF), static_cast<uint8_t>((interval >> 8) & 0xFF) };
+			chunk.insert(chunk.end(), header, header + 4);
+			if (data) chunk.insert(chunk.end(), data, data + dataRows);
+			else chunk.insert(chunk.end(), dataRows, 0);
+		};
+
+		int64_t previous = milliseconds(first);
+		for (size_t col = first; col < last; ++col) {
+			const int64_t time = milliseconds(col);
+			while (time - previous > MAX_MESSAGE_INTERVAL) {
+				append(FILLER_MESSAGE_ID, static_cast<int16_t>(MAX_MESSAGE_INTERVAL), nullptr);
+				previous += MAX_MESSAGE_INTERVAL;
+			}
+			append(datafile->message_ids->at(col), static_cast<int16_t>(std::max<int64_t>(time - previous, std::numeric_limits<int16_t>::min())), datafile->messages->colptr(col));
+			previous = time;
+
+			if (chunk.size() >= CHUNK_COLUMNS * (4 + dataRows)) {
+				if (!output(chunk.data(), chunk.size())) return false;
+				chunk.clear();
+			}
+		}
+		return chunk.empty() || output(chunk.data(), chunk.size());
+	};
+
+	// Definitions of the datasets, in the fields that are read by the parser
+	Array datasets;
+	datasets.arrayClass = MatWriter::mxSTRUCT_CLASS;
+	datasets.rows = 1;
+	datasets.cols = 0;
+	datasets.fieldNames = { "id", "name", "uid", "quantity", "unit", "length", "byteOffset", "datatype", "offset", "scale" };
+	for (const auto& dataset : datafile->datasets) {
+		if (dataset->expression) continue; // Derived datasets are not decoded from messages
+		datasets.cols++;
+		datasets.fields.push_back(Array::matrix(MatWriter::mxUINT16_CLASS, MatWriter::miUINT16, std::vector<uint16_t>{ dataset->id }));
+		datasets.fields.push_back(Array::text(dataset->name));
+		datasets.fields.push_back(Array::matrix(MatWriter::mxUINT32_CLASS, MatWriter::miUINT32, std::vector<uint32_t>{ dataset->uid }));
+		datasets.fields.push_back(Array::text(dataset->quantity));
+		datasets.fields.push_back(Array::text(dataset->unit));
+		datasets.fields.push_back(Array::matrix(MatWriter::mxUINT8_CLASS, MatWriter::miUINT8, std::vector<uint8_t>{ dataset->length }));
+		datasets.fields.push_back(Array::matrix(MatWriter::mxUINT8_CLASS, MatWriter::miUINT8, std::vector<uint8_t>{ dataset->byteOffset }));
+		datasets.fields.push_back(Array::matrix(MatWriter::mxUINT8_CLASS, MatWriter::miUINT8, std::vector<uint8_t>{ static_cast<uint8_t>(dataset->datatype) }));
+		datasets.fields.push_back(Array::matrix(MatWriter::mxSINGLE_CLASS, MatWriter::miSINGLE, std::vector<float>{ dataset->offset }));
+		datasets.fields.push_back(Array::matrix(MatWriter::mxSINGLE_CLASS, MatWriter::miSINGLE, std::vector<float>{ dataset->scale }));
+	}
+
+	// The start time is moved to the first exported message. The offset from aligning on start times is derived again from the
+	// start time when the log is loaded, so only the correction on top of it (e.g. from aligning on a signal) is added to it
+	const int64_t userOffset = std::llround((datafile->timeOffset - datafile->startOffset) * 1000.0);
+	const Timestamp startTime = datafile->startTime + boost::posix_time::milliseconds(userOffset + milliseconds(first));
+	Array start = Array::matrix(MatWriter::mxUINT16_CLASS, MatWriter::miUINT16, startTime.get());
+	std::swap(start.rows, start.cols);
+
+	if (settings.compress && !MatWriter::compressible(messages, "messages"))
+		return fail(error, "The messages of " + datafile->name + " are too large to compress. Export them uncompressed.");
+
+	H2A::Export::MatWriter writer(filename);
+	const double total = static_cast<double>(messages.size);
+	double written = 0.0;
+	bool canceled = false;
+	const bool success = writer.isOpen() &&
+		writer.write("startTime", start, settings.compress) &&
+		writer.write("datasets", datasets, settings.compress) &&
+		writer.write("messages", messages, settings.compress, [&](size_t bytes) {
+			written += bytes;
+			canceled = progress && !progress(std::min(written / total, 1.0));
+			return !canceled;
+		}) &&
+		writer.close();
+
+	if (!success) {
+		std::remove(filename.c_str());
+		return canceled ? false : fail(error, "Could not write " + filename + ".");
+	}
+	return true;
+}
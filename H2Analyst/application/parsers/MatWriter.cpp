@@ -0,0 +1,161 @@
+#include "MatWriter.h"
+
+namespace
+{
+	/**
+	* Write a data element: tag, data and padding to a multiple of 8 bytes.
+	**/
+	bool writeElement(const H2A::Export::MatWriter::Output& output, uint32_t type, const void* data, size_t size) {
+		const uint32_t tag[2] = { type, static_cast<uint32_t>(size) };
+		const char padding[8] = {};
+		return output(tag, sizeof(tag)) && (size == 0 || output(data, size)) && ((size % 8) == 0 || output(padding, 8 - size % 8));
+	}
+}
+
+/**
+* Character array, of which the characters are stored as UTF-8 (as in the logs of the car).
+**/
+H2A::Export::MatWriter::Array H2A::Export::MatWriter::Array::text(const std::string& text) {
+	Array array;
+	array.arrayClass = mxCHAR_CLASS;
+	array.type = miUTF8;
+	array.rows = 1;
+	array.cols = static_cast<uint32_t>(text.size());
+	array.data.assign(text.begin(), text.end());
+	array.size = text.size();
+	return array;
+}
+
+/**
+* 1x1 struct with the given fields.
+**/
+H2A::Export::MatWriter::Array H2A::Export::MatWriter::Array::structure(const std::vector<std::pair<std::string, Array>>& fields) {
+	Array array;
+	array.arrayClass = mxSTRUCT_CLASS;
+	array.rows = 1;
+	array.cols = 1;
+	for (const auto& [name, field] : fields) {
+		array.fieldNames.push_back(name);
+		array.fields.push_back(field);
+	}
+	return array;
+}
+
+/**
+* Create a MAT-file and write its header.
+*
+* @param filename Filename of the created file.
+**/
+H2A::Export::MatWriter::MatWriter(const std::string& filename) : m_File(filename, std::ios::binary) {
+	if (!m_File.is_open()) return;
+
+	char header[128];
+	std::memset(header, ' ', 116);
+	const std::string text = "MATLAB 5.0 MAT-file, created by H2Analyst";
+	std::memcpy(header, text.data(), text.size());
+	std::memset(header + 116, 0, 8); // No subsystem data
+	const uint16_t version = 0x0100;
+	std::memcpy(header + 124, &version, sizeof(version));
+	header[126] = 'I'; // Little endian
+	header[127] = 'M';
+	m_File.write(header, sizeof(header));
+}
+
+/**
+* Size of the contents of a matrix element, without its tag.
+*
+* @param array Array to compute the size of.
+* @param name Name of the array, which is empty for fields of a struct.
+**/
+size_t H2A::Export::MatWriter::contentSize(const Array& array, const std::string& name) {
+	size_t size = 16 + 16 + 8 + padded(name.size()); // Flags, dimensions and name
+	if (array.arrayClass == mxSTRUCT_CLASS) {
+		size += 16 + 8 + padded(FIELD_NAME_LENGTH * array.fieldNames.size());
+		for (const auto& field : array.fields) size += 8 + contentSize(field, "");
+	}
+	else {
+		size += 8 + padded(array.size);
+	}
+	return size;
+}
+
+/**
+* Write a matrix element, including the elements of the fields of a struct.
+*
+* @param output Function that receives the written data.
+* @param array Array to write.
+* @param name Name of the array, which is empty for fields of a struct.
+**/
+bool H2A::Export::MatWriter::writeMatrix(const Output& output, const Array& array, const std::string& name) {
+	const uint32_t tag[2] = { miMATRIX, static_cast<uint32_t>(contentSize(array, name)) };
+	const uint32_t flags[2] = { array.arrayClass, 0 };
+	const int32_t dimensions[2] = { static_cast<int32_t>(array.rows), static_cast<int32_t>(array.cols) };
+	if (!output(tag, sizeof(tag)) ||
+		!writeElement(output, miUINT32, flags, sizeof(flags)) ||
+		!writeElement(output, miINT32, dimensions, sizeof(dimensions)) ||
+		!writeElement(output, miINT8, name.data(), name.size()))
+		return false;
+
+	if (array.arrayClass == mxSTRUCT_CLASS) {
+		std::vector<char> fieldNames(FIELD_NAME_LENGTH * array.fieldNames.size(), 0);
+		for (size_t i = 0; i < array.fieldNames.size(); ++i)
+			std::memcpy(&fieldNames[i * FIELD_NAME_LENGTH], array.fieldNames[i].data(), std::min<size_t>(array.fieldNames[i].size(), FIELD_NAME_LENGTH - 1));
+		if (!writeElement(output, miINT32, &FIELD_NAME_LENGTH, sizeof(FIELD_NAME_LENGTH)) ||
+			!writeElement(output, miINT8, fieldNames.data(), fieldNames.size()))
+			return false;
+		for (const auto& field : array.fields)
+			if (!writeMatrix(output, field, "")) return false;
+		return true;
+	}
+
+	if (!array.produce) return writeElement(output, array.type, array.data.data(), array.size);
+
+	const uint32_t dataTag[2] = { array.type, static_cast<uint32_t>(array.size) };
+	const char padding[8] = {};
+	return output(dataTag, sizeof(dataTag)) && array.produce(output) && ((array.size % 8) == 0 || output(padding, 8 - array.size % 8));
+}
+
+/**
+* Write a variable to the file.
+*
+* @param name Name of the variable.
+* @param array Value of the variable.
+* @param compress Compress the variable, which is then assembled in memory before it is written. Fails if it is not compressible.
+* @param progress Function that is called with the number of bytes after every chunk of (uncompressed) data, which can stop writing.
+**/
+bool H2A::Export::MatWriter::write(const std::string& name, const Array& array, bool compress, const std::function<bool(size_t bytes)>& progress) {
+	if (m_Stopped || contentSize(array, name) > std::numeric_limits<uint32_t>::max()) return false; // Elements are limited to 4 GB
+
+	if (!compress) {
+		return writeMatrix([&](const void* data, size_t size) {
+			m_File.write(static_cast<const char*>(data), size);
+			m_Stopped = m_File.fail() || (progress && !progress(size));
+			return !m_Stopped;
+			}, array, name);
+	}
+
+	if (!compressible(array, name)) return false;
+
+	QByteArray buffer;
+	buffer.reserve(static_cast<qsizetype>(variableSize(array, name)));
+	const bool complete = writeMatrix([&](const void* data, size_t size) {
+		buffer.append(static_cast<const char*>(data), static_cast<qsizetype>(size));
+		m_Stopped = progress && !progress(size);
+		return !m_Stopped;
+		}, array, name);
+	if (!complete) return false;
+
+	// qCompress prepends the uncompressed size to the zlib stream, which is not part of the MAT format
+	const QByteArray compressed = qCompress(buffer).mid(4);
+	buffer.clear();
+	if (compressed.isEmpty() || static_cast<size_t>(compressed.size()) > std::numeric_limits<uint32_t>::max()) return false;
+	const uint32_t tag[2] = { miCOMPRESSED, static_cast<uint32_t>(compressed.size()) };
+	m_File.write(reinterpret_cast<const char*>(tag), sizeof(tag));
+	m_File.write(compressed.constData(), compressed.size());
+	return !m_File.fail();
+}
+
+bool H2A::Export::MatWriter::close() {
+	m_File.close();
+	return !m_File.fail() && !m_Stopped;
+}
@@ -340,12 +340,35 @@ void H2A::Parsers::IntCanLog(const std::string& filename, H2A::Datafile* datafil
 		// Evaluate element type and size
 		Tag tag = ReadTag(buffer, byte_swap);
 		if (tag.small) throw std::runtime_error("Unexpected tag read (compressed format)");
-		if (tag.type != 14) throw std::runtime_error("Unexpected tag read (expected type 14)");
 
-		// Read struct described by tag
-		delete[] buffer;
-		buffer = new char[tag.size];
-		CopyBytes(data, buffer, cursor, tag.size);
+		// Compressed element (as written by the MAT exporter): zlib stream of a complete element, including its tag
+		if (tag.type == 15) {
+			if (cursor + tag.size > filesize) throw std::runtime_error("Unexpected end of file");
+			// qUncompress expects the uncompressed size in front of the stream, which is only used as initial buffer size
+			const uint32_t size_hint = static_cast<uint32_t>(std::min<uint64_t>(static_cast<uint64_t>(tag.size) * 8, 1ull << 30));
+			QByteArray compressed;
+			compressed.reserve(static_cast<qsizetype>(tag.size) + 4);
+			for (int shift = 24; shift >= 0; shift -= 8) compressed.append(static_cast<char>((size_hint >> shift) & 0xFF));
+			compressed.append(&data[cursor], static_cast<qsizetype>(tag.size));
+			cursor += tag.size;
+			const QByteArray element = qUncompress(compressed);
+			if (element.size() < 8) throw std::runtime_error("Failed to decompress element");
+
+			tag = ReadTag(const_cast<char*>(element.constData()), byte_swap);
+			if (tag.type != 14) throw std::runtime_error("Unexpected tag read (expected type 14)");
+			if (static_cast<size_t>(element.size()) < 8 + static_cast<size_t>(tag.size)) throw std::runtime_error("Unexpected end of compressed element");
+			delete[] buffer;
+			buffer = new char[tag.size];
+			memcpy(buffer, element.constData() + 8, tag.size);
+		}
+		else {
+			if (tag.type != 14) throw std::runtime_error("Unexpected tag read (expected type 14)");
+
+			// Read struct described by tag
+			delete[] buffer;
+			buffer = new char[tag.size];
+			CopyBytes(data, buffer, cursor, tag.size);
+		}
 		
 		subcursor = 0;
 		std::vector<uint32_t> flags = ReadElement<uint32_t>(buffer, subcursor, byte_swap);
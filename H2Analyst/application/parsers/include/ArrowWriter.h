@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
+namespace H2A
+{
+	namespace Export
+	{
+
+		/**
+		* Writer of the Arrow IPC file format (Feather v2), which can be read (memory-mapped) by pyarrow, pandas and Polars.
+		* Only the parts of the format that are needed for the exports are implemented: float64 columns, optionally with
+		* nulls, and int32 columns that are dictionary-encoded with a single dictionary of strings.
+		* The buffers of a record batch are written to the file as they are, so the vectors of a dataset can be passed without
+		* copying them.
+		**/
+		class ArrowWriter
+		{
+
+		public:
+			enum class Type : uint8_t { Float64, Dictionary };
+			using Metadata = std::vector<std::pair<std::string, std::string>>;
+
+			struct Column {
+				std::string name;
+				Type type = Type::Float64;
+				bool nullable = false;
+				Metadata metadata;
+			};
+
+			// Contents of a column in a record batch. Validity is a bitmap (bit set for valid values) or null when there are no nulls.
+			struct Array {
+				const void* values = nullptr;
+				const uint8_t* validity = nullptr;
+				size_t nullCount = 0;
+			};
+
+		private:
+			// Location of a message in the file, which is listed in the footer. The struct is copied to the footer byte by byte,
+			// so its alignment padding is an explicit member that is zero
+			struct Block {
+				int64_t offset;
+				int32_t metadataLength;
+				int32_t padding;
+				int64_t bodyLength;
+			};
+
+			std::ofstream m_File;
+			std::vector<Column> m_Columns;
+			Metadata m_Metadata; // Metadata of the schema, which is repeated in the footer
+			std::vector<Block> m_Dictionaries;
+			std::vector<Block> m_RecordBatches;
+			int64_t m_Position = 0;
+
+			void write(const void* data, size_t size);
+			void pad(size_t size);
+			Block writeMessage(const std::vector<uint8_t>& metadata, int64_t bodyLength);
+			void writeDictionary(const std::vector<std::string>& dictionary);
+
+		public:
+			ArrowWriter(const std::string& filename, const std::vector<Column>& columns, const std::vector<std::string>& dictionary = {}, const Metadata& metadata = {});
+
+			bool isOpen() const { return m_File.is_open(); };
+			void writeBatch(size_t length, const std::vector<Array>& arrays);
+			bool close();
+		};
+
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <atomic>
+
+#include <QObject>
+#include <QThread>
+#include <QString>
+
+#include "Exporters.h"
+
+
+/**
+* Runs an export in one of the export formats and layouts in a separate thread, reporting its progress and allowing it to be canceled.
+**/
+class ExportWorker
+	: public QObject
+{
+
+	Q_OBJECT
+
+	std::vector<const H2A::Dataset*> m_Datasets;
+	std::string m_Filename;
+	H2A::Export::Settings m_Settings;
+	std::atomic<bool> m_Canceled = false;
+
+public:
+	ExportWorker(const std::vector<const H2A::Dataset*>& datasets, const std::string& filename, const H2A::Export::Settings& settings);
+
+public slots:
+	void run();
+	void cancel() { m_Canceled = true; };
+
+signals:
+	void progress(int percentage);
+	void finished(bool success, const QString& error);
+
+};
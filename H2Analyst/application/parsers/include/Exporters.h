@@ -2,18 +2,61 @@
 
 #include "DataStructures.h"
 #include "DataOperations.h"
+#include "ArrowWriter.h"
+#include "MatWriter.h"
 
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <vector>
+#include <functional>
+#include <future>
+#include <thread>
+#include <charconv>
+#include <numeric>
+#include <execution>
+#include <cstdio>
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <cctype>
+#include <cmath>
 
 namespace H2A
 {
 	namespace Export
 	{
 
-		void CSV(const std::vector<const H2A::Dataset*> datasets, const std::string filename, const uint16_t resamplingFreq = 10);
+		const size_t BLOCK_ROWS = 8 * H2A::RESAMPLE_CHUNK_SIZE; // Number of rows resampled and formatted at once
+		const size_t MAX_CELL_LENGTH = 32; // Longest formatted value (shortest round-trip double is at most 24 characters)
+		const int MAX_PRECISION = 17; // Most significant digits of a fixed precision, which a double holds and which fit in MAX_CELL_LENGTH
+		const int64_t MAX_MESSAGE_INTERVAL = 32767; // Largest interval [ms] between messages in a car log, longer gaps are filled with empty messages
+		const uint16_t FILLER_MESSAGE_ID = 0xFFFF; // ID of the empty messages, which is not a valid CAN ID
+
+		// Called with the exported fraction, returns false to cancel the export
+		using Progress = std::function<bool(double fraction)>;
+
+		/**
+		* Settings of an export. The time window is on the corrected timebase, the resampling settings only apply to the resampled layout.
+		**/
+		struct Settings {
+			H2A::ExportFormat format = H2A::ExportFormat::CSV;
+			H2A::ExportLayout layout = H2A::ExportLayout::Resampled;
+			double resamplingFreq = 10.0;
+			H2A::ResampleMode mode = H2A::ResampleMode::Average;
+			int precision = -1; // Significant digits in CSV, -1 for the shortest representation that reads back to the same value
+			double tStart = -std::numeric_limits<double>::infinity();
+			double tEnd = std::numeric_limits<double>::infinity();
+			bool compress = false; // Compress the variables of MAT-files
+		};
+
+		bool write(const std::vector<const H2A::Dataset*> datasets, const std::string filename, const Settings& settings, const Progress& progress = nullptr, std::string* error = nullptr);
+		bool CSV(const std::vector<const H2A::Dataset*> datasets, const std::string filename, const Settings& settings, const Progress& progress = nullptr, std::string* error = nullptr);
+		bool CSVEvents(const std::vector<const H2A::Dataset*> datasets, const std::string filename, const Settings& settings, const Progress& progress = nullptr, std::string* error = nullptr);
+		bool CSVLong(const std::vector<const H2A::Dataset*> datasets, const std::string filename, const Settings& settings, const Progress& progress = nullptr, std::string* error = nullptr);
+		bool Arrow(const std::vector<const H2A::Dataset*> datasets, const std::string filename, const Settings& settings, const Progress& progress = nullptr, std::string* error = nullptr);
+		bool MAT(const std::vector<const H2A::Dataset*> datasets, const std::string filename, const Settings& settings, const Progress& progress = nullptr, std::string* error = nullptr);
+		bool IntCanLog(const H2A::Datafile* datafile, const std::string filename, const Settings& settings, const Progress& progress = nullptr, std::string* error = nullptr);
 
 	}
 }
-
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <functional>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include <QByteArray>
+
+namespace H2A
+{
+	namespace Export
+	{
+
+		/**
+		* Writer of level 5 MAT-files, which can be read by MATLAB and (in the layout of the car logs) by the IntCanLog parser.
+		* Variables are written uncompressed or compressed (miCOMPRESSED). Uncompressed variables are streamed: the size of every
+		* element is computed up front and the data of large matrices is produced in chunks while writing. Compressed variables
+		* are assembled in memory, one variable at a time, and compressed as a whole.
+		**/
+		class MatWriter
+		{
+
+		public:
+			enum DataType : uint32_t { miINT8 = 1, miUINT8 = 2, miINT16 = 3, miUINT16 = 4, miINT32 = 5, miUINT32 = 6, miSINGLE = 7, miDOUBLE = 9, miMATRIX = 14, miCOMPRESSED = 15, miUTF8 = 16 };
+			enum ArrayClass : uint8_t { mxSTRUCT_CLASS = 2, mxCHAR_CLASS = 4, mxDOUBLE_CLASS = 6, mxSINGLE_CLASS = 7, mxUINT8_CLASS = 9, mxUINT16_CLASS = 11, mxUINT32_CLASS = 13 };
+
+			static constexpr uint32_t FIELD_NAME_LENGTH = 32; // Length of the field names of structs, the IntCanLog parser expects 32
+			static constexpr size_t MAX_COMPRESS_SIZE = 0x7F000000; // Compressed variables are assembled in a QByteArray, which Qt 5 limits to 2 GB
+
+			// Receives data while a variable is written, returns false to stop writing
+			using Output = std::function<bool(const void* data, size_t size)>;
+
+			/**
+			* Array in a MAT-file: a numeric or char matrix, or a struct of which the fields are arrays themselves.
+			* The data of a small matrix is stored in the array, the data of a large matrix is produced when it is written.
+			**/
+			struct Array {
+				ArrayClass arrayClass = mxDOUBLE_CLASS;
+				DataType type = miDOUBLE;
+				uint32_t rows = 0;
+				uint32_t cols = 0;
+
+				std::vector<uint8_t> data;
+				size_t size = 0; // Size of the data in bytes
+				std::function<bool(const Output& output)> produce; // Writes the data in chunks, returns false when stopped
+
+				std::vector<std::string> fieldNames;
+				std::vector<Array> fields; // Values of the fields of a struct, of the first element first
+
+				template <typename T>
+				static Array matrix(ArrayClass arrayClass, DataType type, const std::vector<T>& values);
+				static Array text(const std::string& text);
+				static Array structure(const std::vector<std::pair<std::string, Array>>& fields);
+			};
+
+		private:
+			std::ofstream m_File;
+			bool m_Stopped = false;
+
+			static size_t padded(size_t size) { return (size + 7) / 8 * 8; };
+			static size_t contentSize(const Array& array, const std::string& name);
+			static bool writeMatrix(const Output& output, const Array& array, const std::string& name);
+
+		public:
+			MatWriter(const std::string& filename);
+
+			bool isOpen() const { return m_File.is_open(); };
+			static size_t variableSize(const Array& array, const std::string& name) { return 8 + contentSize(array, name); };
+			static bool compressible(const Array& array, const std::string& name) { return variableSize(array, name) <= MAX_COMPRESS_SIZE; };
+			bool write(const std::string& name, const Array& array, bool compress, const std::function<bool(size_t bytes)>& progress = nullptr);
+			bool close();
+		};
+
+		/**
+		* Matrix (column vector) with the given values, which are copied into the array.
+		**/
+		template <typename T>
+		MatWriter::Array MatWriter::Array::matrix(ArrayClass arrayClass, DataType type, const std::vector<T>& values) {
+			Array array;
+			array.arrayClass = arrayClass;
+			array.type = type;
+			array.rows = static_cast<uint32_t>(values.size());
+			array.cols = 1;
+			array.size = values.size() * sizeof(T);
+			array.data.resize(array.size);
+			if (array.size > 0) std::memcpy(array.data.data(), values.data(), array.size);
+			return array;
+		}
+
+	}
+}
@@ -9,6 +9,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <armadillo>
+#include <QByteArray>
 
 #include "Namespace.h"
 #include "DataStructures.h"
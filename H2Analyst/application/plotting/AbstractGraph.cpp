@@ -12,21 +12,88 @@ m_Color(QColor("black"))
 }
 
 /**
-* Returns the range of the X data.
+* Returns the range of the X data, read from the statistics of the dataset, or noRange if the dataset is empty.
 **/
 QCPRange AbstractGraph::rangeX() const {
-	bool rangeFound = false;
-	auto range = m_Graph->getKeyRange(rangeFound);
-	return range;
+	const H2A::Dataset* dataset = m_Datasets.front();
+	if (dataset->stats.count == 0) return noRange();
+	return QCPRange(dataset->datafile->correctTime(dataset->stats.firstTime), dataset->datafile->correctTime(dataset->stats.lastTime));
 }
 
 /**
-* Returns the range of the Y data.
+* Returns the range of the Y data, read from the statistics of the dataset or of the shown values if they are transformed.
+* Returns noRange if there are no finite values.
 **/
 QCPRange AbstractGraph::rangeY() const {
-	bool rangeFound = false;
-	auto range = m_Graph->getValueRange(rangeFound);
-	return range;
+	if (m_ValueIndex.built()) {
+		H2A::WindowStats stats;
+		if (!m_ValueIndex.query(-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(), stats)) return noRange();
+		return QCPRange(stats.min, stats.max);
+	}
+	const H2A::DatasetStats& stats = m_Datasets.front()->stats;
+	if (!stats.hasRange()) return noRange();
+	return QCPRange(stats.min, stats.max);
+}
+
+/**
+* Returns the range of the Y data within the given X range, or noRange if there are no finite values in it.
+*
+* @param rangeX Range of X data.
+**/
+QCPRange AbstractGraph::rangeY(const QCPRange& rangeX) const {
+	H2A::WindowStats stats;
+	if (!this->windowStats(rangeX, stats) || stats.count == 0) return noRange();
+	return QCPRange(stats.min, stats.max);
+}
+
+/**
+* Computes the statistics of the shown data within the given X range.
+*
+* @param rangeX Range of X data.
+* @param stats Object to store statistics in.
+**/
+bool AbstractGraph::windowStats(const QCPRange& rangeX, H2A::WindowStats& stats) const {
+	const H2A::Dataset* dataset = m_Datasets.front();
+	if (!m_ValueIndex.built()) return dataset->windowStats(rangeX.lower, rangeX.upper, stats);
+
+	// Same as the statistics of the dataset, on the transformed values
+	if (!m_ValueIndex.query(dataset->datafile->rawTime(rangeX.lower), dataset->datafile->rawTime(rangeX.upper), stats)) return false;
+	stats.integral *= 1.0 + dataset->datafile->timeDrift;
+	return true;
+}
+
+/**
+* Replace the Y values of the graph, while keeping its X values. Used to show a transformed version of the data.
+* The ranges and statistics of the graph are computed from the new values, until they are cleared.
+*
+* @param values New Y values, one for every datapoint of the graph.
+**/
+void AbstractGraph::setValues(std::vector<double> values) {
+	auto data = m_Graph->data();
+	if (static_cast<size_t>(data->size()) != values.size()) return;
+
+	size_t i = 0;
+	for (auto it = data->begin(); it != data->end(); ++it) it->value = values[i++];
+
+	m_Values = std::move(values);
+	m_ValueIndex.build(m_Datasets.front()->rawTimeVec(), m_Values);
+}
+
+/**
+* Show the data of the dataset again, after it was replaced by setValues.
+**/
+void AbstractGraph::clearValues() {
+	if (!m_ValueIndex.built()) return;
+	m_ValueIndex.clear();
+	m_Values.clear();
+	m_Values.shrink_to_fit();
+
+	const auto& dataVec = m_Datasets.front()->dataVec;
+	auto data = m_Graph->data();
+	if (static_cast<size_t>(data->size()) != dataVec.size()) return;
+
+	size_t i = 0;
+	for (auto it = data->begin(); it != data->end(); ++it) it->value = dataVec[i++];
 }
 
 /**
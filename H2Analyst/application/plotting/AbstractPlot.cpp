@@ -5,7 +5,9 @@ AbstractPlot::AbstractPlot(QWidget* parent) : QCustomPlot(parent),
 m_Type(H2A::Abstract),
 m_TimeCursor(new TimeCursor(this)),
 m_Rubberband(new Rubberband(this)),
-m_BusyEnforcingViewLimits(false)
+m_BusyEnforcingViewLimits(false),
+m_FollowTimeWindow(false),
+m_TimeWindow(-QCPRange::maxRange, QCPRange::maxRange)
 {
 	this->xAxis->setTickLabels(false);
 	this->yAxis->setTickLabels(false);
@@ -36,29 +38,31 @@ std::vector<const H2A::Dataset*> AbstractPlot::datasets() const
 }
 
 /**
-* Returns the range that spans all X data in the graphs.
+* Returns the range that spans all X data in the graphs. Graphs without data are skipped, if none has data the range is empty.
 **/
 QCPRange AbstractPlot::dataRangeX() const {
-	if (this->isEmpty()) return QCPRange();
-
-	QCPRange range = m_Graphs.front()->rangeX();
-	for (const auto& graph : m_Graphs)
-		range.expand(graph->rangeX());
-
-	return range;
+	QCPRange range = AbstractGraph::noRange();
+	for (const auto& graph : m_Graphs) {
+		const QCPRange graphRange = graph->rangeX();
+		if (!AbstractGraph::hasRange(graphRange)) continue;
+		if (AbstractGraph::hasRange(range)) range.expand(graphRange);
+		else range = graphRange;
+	}
+	return AbstractGraph::hasRange(range) ? range : QCPRange();
 }
 
 /**
-* Returns the range that spans all Y data in the graphs.
+* Returns the range that spans all Y data in the graphs. Graphs without data are skipped, if none has data the range is empty.
 **/
 QCPRange AbstractPlot::dataRangeY() const {
-	if (this->isEmpty()) return QCPRange();
-
-	QCPRange range = m_Graphs.front()->rangeY();
-	for (const auto& graph : m_Graphs)
-		range.expand(graph->rangeY());
-
-	return range;
+	QCPRange range = AbstractGraph::noRange();
+	for (const auto& graph : m_Graphs) {
+		const QCPRange graphRange = graph->rangeY();
+		if (!AbstractGraph::hasRange(graphRange)) continue;
+		if (AbstractGraph::hasRange(range)) range.expand(graphRange);
+		else range = graphRange;
+	}
+	return AbstractGraph::hasRange(range) ? range : QCPRange();
 }
 
 /**
@@ -91,6 +95,37 @@ void AbstractPlot::clear() {
 void AbstractPlot::setTimeCursorEnabled(bool enable) { m_TimeCursor->setEnabled(enable); }
 void AbstractPlot::setTimeCursorTime(double time) { m_TimeCursor->setTime(time); }
 
+/**
+* Slot that is called when the time correction of a datafile changed, which updates the time of the graphs of its datasets.
+*
+* @param datafile Datafile of which the time correction changed.
+**/
+void AbstractPlot::timeCorrected(const H2A::Datafile* datafile) {
+	bool changed = false;
+	for (const auto& graph : m_Graphs) {
+		if (graph->datasets().front()->datafile != datafile) continue;
+		graph->updateTime();
+		changed = true;
+	}
+	if (changed) this->replot();
+}
+
+/**
+* Slot that is called when the data of a dataset changed, which shows the new data in the graphs of the dataset.
+*
+* @param dataset Dataset of which the data changed.
+**/
+void AbstractPlot::datasetChanged(const H2A::Dataset* dataset) {
+	bool changed = false;
+	for (const auto& graph : m_Graphs) {
+		const auto datasets = graph->datasets();
+		if (std::find(datasets.begin(), datasets.end(), dataset) == datasets.end()) continue;
+		graph->reload();
+		changed = true;
+	}
+	if (changed) this->replot();
+}
+
 /**
 * Function that overrides Base and is called when the mouse is moved while it is over this widget.
 *
@@ -177,8 +212,10 @@ void AbstractPlot::dragEnterEvent(QDragEnterEvent* event) {
 **/
 void AbstractPlot::dropEvent(QDropEvent*) {
 	// If data is dropped on an AbstractPlot object, it should be changed to a TimePlot and plot the data.
+	// Spectrum and histogram plots keep their type and plot the spectrum or histogram of the data.
 	bool ctrlPressed = (QApplication::keyboardModifiers() & Qt::ControlModifier);
-	emit this->plotSelected(this, H2A::Time, !ctrlPressed);
+	const bool keepType = m_Type == H2A::Spectrum || m_Type == H2A::Histogram || m_Type == H2A::Heatmap || m_Type == H2A::XY;
+	emit this->plotSelected(this, keepType ? m_Type : H2A::Time, !ctrlPressed);
 }
 
 /**
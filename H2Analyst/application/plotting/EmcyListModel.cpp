@@ -0,0 +1,145 @@
+#include "EmcyListModel.h"
+
+/**
+* Model of the EMCY list.
+*
+* @param definitions Descriptions of the EMCY codes.
+* @param parent Parent of this model.
+**/
+EmcyListModel::EmcyListModel(const H2A::Emcy::Definitions* definitions, QObject* parent) : QAbstractListModel(parent),
+m_Definitions(definitions),
+m_CursorEnabled(true),
+m_CursorTime(-std::numeric_limits<double>::infinity()),
+m_CursorRow(0)
+{
+}
+
+int EmcyListModel::rowCount(const QModelIndex& parent) const {
+	if (parent.isValid()) return 0;
+	return static_cast<int>(m_Positions.size());
+}
+
+/**
+* Data of a row, which is generated when it is requested by the view.
+*
+* @param index Index of the row.
+* @param role Role of the requested data: the label, the source as tooltip or the EMCY itself.
+**/
+QVariant EmcyListModel::data(const QModelIndex& index, int role) const {
+	if (!index.isValid()) return QVariant();
+	const H2A::Emcy::Record* emcy = this->record(index.row());
+	if (emcy == nullptr) return QVariant();
+
+	const H2A::Emcy::Properties* properties = m_Definitions->find(emcy->code);
+	const QString description = properties ? QString::fromUtf8(properties->text.data(), static_cast<qsizetype>(properties->text.size())) : "unknown";
+
+	switch (role) {
+	case Qt::DisplayRole:
+		return QString("[%1]\t(%2)\t%3").arg(emcy->time, 0, 'f', 3).arg(QString::fromStdString(H2A::Emcy::getSeverityStr(emcy->severity))).arg(description);
+	case Qt::ToolTipRole:
+		return QString::fromStdString("Source: " + m_Index->sources()[emcy->source]);
+	case H2A::ItemRole::Sorting:
+		return emcy->time;
+	case H2A::ItemRole::Emcy: {
+		H2A::Emcy::Emcy full = {};
+		full.time = emcy->time;
+		full.source = "Source: " + m_Index->sources()[emcy->source];
+		full.code = emcy->code;
+		full.severity = emcy->severity;
+		full.description = description.toStdString();
+		return QVariant::fromValue(full);
+	}
+	default:
+		return QVariant();
+	}
+}
+
+/**
+* Replace the EMCYs in the list.
+*
+* @param index EMCY index of the datafile of the list.
+* @param positions Positions in the index of the EMCYs to list, in time order.
+**/
+void EmcyListModel::setEmcies(std::shared_ptr<const H2A::Emcy::Index> index, std::vector<uint32_t> positions) {
+	this->beginResetModel();
+	m_Index = std::move(index);
+	m_Positions = std::move(positions);
+	m_CursorRow = this->cursorPosition(m_CursorTime);
+	this->endResetModel();
+}
+
+/**
+* Change the descriptions of the EMCY codes, e.g. because another car is selected.
+* The descriptions are looked up when the labels are created, so the records are not changed.
+*
+* @param definitions Descriptions of the EMCY codes.
+**/
+void EmcyListModel::setDefinitions(const H2A::Emcy::Definitions* definitions) {
+	m_Definitions = definitions;
+	this->updateRows(0, static_cast<int>(m_Positions.size()) - 1);
+}
+
+/**
+* EMCY in a row, or nullptr if the row does not exist.
+*
+* @param row Row in the model.
+**/
+const H2A::Emcy::Record* EmcyListModel::record(int row) const {
+	if (row < 0 || row >= static_cast<int>(m_Positions.size())) return nullptr;
+	return &m_Index->emcies()[m_Positions[row]];
+}
+
+/**
+* Position of the time cursor in the list: in front of the first EMCY at or after the given time.
+*
+* @param time Time of the time cursor.
+**/
+int EmcyListModel::cursorPosition(double time) const {
+	if (!m_Index) return 0;
+	const auto& emcies = m_Index->emcies();
+	auto it = std::lower_bound(m_Positions.begin(), m_Positions.end(), time, [&](uint32_t position, double t) { return emcies[position].time < t; });
+	return static_cast<int>(it - m_Positions.begin());
+}
+
+/**
+* Notify the view that rows have to be repainted, e.g. because the time cursor is drawn on them.
+* The rows of the list have the same height, so this does not cause a new layout.
+*
+* @param first First row to repaint.
+* @param last Last row to repaint.
+**/
+void EmcyListModel::updateRows(int first, int last) {
+	first = std::max(first, 0);
+	last = std::min(last, static_cast<int>(m_Positions.size()) - 1);
+	if (first <= last) emit this->dataChanged(this->index(first), this->index(last), { Qt::DisplayRole });
+}
+
+/**
+* Show or hide the time cursor.
+*
+* @param enabled Show the time cursor if true.
+**/
+void EmcyListModel::setCursorEnabled(bool enabled) {
+	if (enabled == m_CursorEnabled) return;
+	m_CursorEnabled = enabled;
+	this->updateRows(m_CursorRow - 1, m_CursorRow);
+}
+
+/**
+* Move the time cursor, of which the row is found by binary search in the list.
+* Only the rows on which the old and new cursor are drawn are repainted.
+*
+* @param time Time of the time cursor.
+**/
+void EmcyListModel::setCursorTime(double time) {
+	m_CursorTime = time;
+	const int row = this->cursorPosition(time);
+	if (row == m_CursorRow) return;
+	const int previous = m_CursorRow;
+	m_CursorRow = row;
+	if (!m_CursorEnabled) return;
+
+	// The cursor is drawn below the last row when it is after all EMCYs
+	this->updateRows(previous - 1, previous);
+	this->updateRows(row - 1, row);
+}
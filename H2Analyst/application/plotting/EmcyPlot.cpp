@@ -4,15 +4,14 @@ EmcyPlot::EmcyPlot(const DataPanel* dataPanel, H2A::Car car, QWidget* parent) :
 m_DataPanel(dataPanel),
 m_VLayout(new QVBoxLayout(this)),
 m_List(new QListView()),
-m_ListModel(new QStandardItemModel(this)),
-m_TimeCursor(new TimeCursorItem()),
+m_ListModel(nullptr),
 m_ItemDelegate(nullptr),
 m_WarningMsg(new QWidget()),
-m_DataMutex(new QMutex())
+m_Datafile(nullptr),
+m_EmcyDefinitions(&H2A::Emcy::definitions(car))
 {
 	m_Type = H2A::EmcyList;
-
-	m_TimeCursor->setBackground(QBrush(QColor(Qt::black)));
+	m_ListModel = new EmcyListModel(m_EmcyDefinitions, this);
 
 	// Build warning message
 	QHBoxLayout* warningLayout = new QHBoxLayout(m_WarningMsg);
@@ -24,14 +23,15 @@ m_DataMutex(new QMutex())
 	warningLayout->addWidget(iconLbl);
 	warningLayout->addWidget(textLbl, Qt::AlignLeft | Qt::AlignVCenter);
 
+	m_VLayout->addWidget(this->createFilterBar());
 	m_VLayout->addWidget(m_List);
 	m_VLayout->addWidget(m_WarningMsg);
 
-	m_ItemDelegate = new ItemDelegate(m_ListModel, m_TimeCursor, this);
+	m_ItemDelegate = new ItemDelegate(m_ListModel, this);
 	m_List->setModel(m_ListModel);
-	m_ListModel->setSortRole(H2A::ItemRole::Sorting);
 	m_List->setItemDelegate(m_ItemDelegate);
-	m_ListModel->appendRow(m_TimeCursor);
+	m_List->setEditTriggers(QAbstractItemView::NoEditTriggers);
+	m_List->setUniformItemSizes(true); // Rows are not measured one by one, also when the model changes
 
 	// Hide plot elements
 	this->xAxis->setVisible(false);
@@ -41,113 +41,164 @@ m_DataMutex(new QMutex())
 
 	connect(m_List, &QListView::doubleClicked, this, &EmcyPlot::itemDoubleClicked);
 
-	H2A::Emcy::readEmcyCodesFromSettings(m_EmcyProperties, car);
+	this->readEmcies();
 	this->fillList();
 }
 
 /**
-* Function that gets the emcies from the dataStore via the dataPanel and puts them in the list.
+* Build the filter bar above the list, of which every change filters the list again.
 **/
-void EmcyPlot::fillList() {
-	// Mutex is used to protect the dataset vector
-	m_DataMutex->lock();
+QWidget* EmcyPlot::createFilterBar() {
+	QWidget* filterBar = new QWidget();
+	QGridLayout* layout = new QGridLayout(filterBar);
+	layout->setContentsMargins(0, 0, 0, 0);
+
+	m_CodeFilter = new QLineEdit();
+	m_CodeFilter->setPlaceholderText("Codes (hex, comma separated)");
+	m_CodeFilter->setValidator(new QRegularExpressionValidator(QRegularExpression("[0-9A-Fa-f,\\s]*"), m_CodeFilter));
+	layout->addWidget(m_CodeFilter, 0, 0, 1, 2);
+
+	m_SeverityFilter = new QComboBox();
+	m_SeverityFilter->addItem("All severities");
+	for (int severity = H2A::Emcy::Event; severity <= H2A::Emcy::Unknown; ++severity)
+		m_SeverityFilter->addItem(QString::fromStdString(H2A::Emcy::getSeverityStr(static_cast<H2A::Emcy::Severity>(severity)) + " or higher"));
+	layout->addWidget(m_SeverityFilter, 0, 2);
+
+	m_SourceFilter = new QComboBox();
+	m_SourceFilter->addItem("All sources");
+	layout->addWidget(m_SourceFilter, 0, 3);
+
+	m_StartFilter = new QLineEdit();
+	m_StartFilter->setPlaceholderText("From [s]");
+	m_StartFilter->setValidator(new QDoubleValidator(m_StartFilter));
+	layout->addWidget(m_StartFilter, 1, 0);
+
+	m_EndFilter = new QLineEdit();
+	m_EndFilter->setPlaceholderText("To [s]");
+	m_EndFilter->setValidator(new QDoubleValidator(m_EndFilter));
+	layout->addWidget(m_EndFilter, 1, 1);
+
+	m_FilterCount = new QLabel();
+	layout->addWidget(m_FilterCount, 1, 2);
+
+	QPushButton* btSearch = new QPushButton("Search all logs");
+	connect(btSearch, &QPushButton::clicked, this, &EmcyPlot::searchLogs);
+	layout->addWidget(btSearch, 1, 3);
+
+	connect(m_CodeFilter, &QLineEdit::textChanged, this, &EmcyPlot::applyFilter);
+	connect(m_SeverityFilter, SIGNAL(currentIndexChanged(int)), this, SLOT(applyFilter()));
+	connect(m_SourceFilter, SIGNAL(currentIndexChanged(int)), this, SLOT(applyFilter()));
+	connect(m_StartFilter, &QLineEdit::textChanged, this, &EmcyPlot::applyFilter);
+	connect(m_EndFilter, &QLineEdit::textChanged, this, &EmcyPlot::applyFilter);
+
+	return filterBar;
+}
+
+/**
+* Function that gets the EMCY index of the datafile from the dataStore via the dataPanel. The index is built (and the EMCY
+* datasets are populated) the first time it is requested, after which it is shared by all EMCY lists of the datafile.
+**/
+void EmcyPlot::readEmcies() {
+	m_Datafile = this->getDatafile();
+	if (m_Datafile == nullptr) return;
+	m_Index = m_DataPanel->getEmcyIndex(m_Datafile);
+	if (!m_Index) return;
 
-	if (m_EmcyDatasets.empty()) {
-		if (!this->getDatasets()) {
-			return;
-		}
+	const QSignalBlocker blocker(m_SourceFilter);
+	for (const auto& source : m_Index->sources())
+		m_SourceFilter->addItem(QString::fromStdString(source));
+}
+
+/**
+* Codes of the indexed EMCYs that are marked as hidden in the EMCY definitions.
+**/
+std::set<uint16_t> EmcyPlot::hiddenCodes() const {
+	std::set<uint16_t> hidden;
+	if (!m_Index) return hidden;
+	for (const auto& code : m_Index->codes()) {
+		const H2A::Emcy::Properties* properties = m_EmcyDefinitions->find(code);
+		if (properties && properties->hide) hidden.insert(code);
 	}
+	return hidden;
+}
 
-	m_DataMutex->unlock();
-
-	// Clear list except for the TimeCursor
-	m_ListModel->removeRows(0, m_TimeCursor->row());
-	m_ListModel->removeRows(1, m_ListModel->rowCount() - 1);
-
-	// Create vector of emcy structs
-	std::vector<H2A::Emcy::Emcy> emcies;
-	for (const auto& dataset : m_EmcyDatasets) {
-		auto timeVec = dataset->timeVec();
-		for (auto i = 0; i < timeVec.size(); ++i) {
-			H2A::Emcy::Emcy emcy;
-			auto payload = static_cast<uint64_t>(dataset->byteVec[i]);
-			H2A::Emcy::readPayload(emcy, payload);
-
-			if (m_EmcyProperties.find(emcy.code) != m_EmcyProperties.end()) {
-				auto description = m_EmcyProperties[emcy.code];
-				if (description.hide) continue; // Don't add the EMCY if it is marked as hidden
-				emcy.description = description.text;
-			}
-			else {
-				emcy.description = "unknown";
-				std::stringstream message;
-				message << "Found an EMCY (" << std::hex << emcy.code << std::dec << ") that is not listed in the emcy_codes settings file.";
-				H2A::logWarning(message.str());
-			}
-
-			emcy.time = timeVec[i];
-			std::vector<std::string> str_split;
-			boost::split_regex(str_split, dataset->name, boost::regex("EMCY"));
-			emcy.source = "Source: " + StrOps::trim_copy(str_split.back());
-			emcies.push_back(emcy);
-			
-		}
+/**
+* Put the indexed EMCYs in the list, leaving out hidden EMCYs and the EMCYs that do not match the filter bar.
+* The labels of the EMCYs are only created by the model for the rows that are shown.
+**/
+void EmcyPlot::fillList() {
+	if (!m_Index) return;
+	for (const auto& code : m_Index->codes()) {
+		if (m_EmcyDefinitions->find(code)) continue;
+		std::stringstream message;
+		message << "Found an EMCY (" << std::hex << code << std::dec << ") that is not listed in the emcy_codes settings file.";
+		H2A::logWarning(message.str());
 	}
 
-	// Add items
-	for (const auto& emcy : emcies)
-		this->addItem(emcy);
+	m_HiddenCodes = this->hiddenCodes();
+	this->applyFilter();
+}
 
-	// Sort
-	this->sort();
+/**
+* Filter of the list, from the filter bar and the hidden codes. Empty time boxes leave the time window open.
+**/
+H2A::Emcy::Filter EmcyPlot::filter() const {
+	H2A::Emcy::Filter filter;
+	filter.codes = DialogEmcySearch::parseCodes(m_CodeFilter->text());
+	filter.minSeverity = static_cast<H2A::Emcy::Severity>(m_SeverityFilter->currentIndex());
+	filter.source = m_SourceFilter->currentIndex() - 1;
+
+	bool ok;
+	const double start = m_StartFilter->locale().toDouble(m_StartFilter->text(), &ok);
+	if (ok) filter.tStart = start;
+	const double end = m_EndFilter->locale().toDouble(m_EndFilter->text(), &ok);
+	if (ok) filter.tEnd = end;
+
+	if (!m_HiddenCodes.empty()) {
+		filter.hidden.assign(std::numeric_limits<uint16_t>::max() + 1, false);
+		for (const auto& code : m_HiddenCodes) filter.hidden[code] = true;
+	}
+	return filter;
 }
 
 /**
-* Get EMCY datasets from the selected datafiles.
+* Slot that filters the list again, which is called whenever the filter bar is changed. Filtering uses the EMCY index, so
+* only the EMCYs of the selected codes or severities are visited.
+**/
+void EmcyPlot::applyFilter() {
+	if (!m_Index) return;
+	m_ListModel->setEmcies(m_Index, m_Index->filter(this->filter()));
+	m_FilterCount->setText(QString("%1 of %2 EMCYs").arg(m_ListModel->size()).arg(m_Index->emcies().size()));
+}
+
+/**
+* Slot that opens the dialog to search the EMCYs of all loaded logs, starting with the codes of the filter bar.
+**/
+void EmcyPlot::searchLogs() {
+	DialogEmcySearch* dialog = new DialogEmcySearch(m_DataPanel, m_EmcyDefinitions, m_CodeFilter->text(), this);
+	dialog->setAttribute(Qt::WA_DeleteOnClose);
+	connect(dialog, &DialogEmcySearch::timeSelected, this, &AbstractPlot::timeCursorPlaced);
+	dialog->show();
+}
+
+/**
+* Get the datafile of the EMCY list from the selected datafiles.
 * If multiple datafiles are selected the first file is used.
 **/
-bool EmcyPlot::getDatasets() {
+const H2A::Datafile* EmcyPlot::getDatafile() const {
 	// Make sure a datafile is selected (should also be taken care of by emcy plot command)
 	auto datafiles = m_DataPanel->getSelectedDatafiles();
 	const H2A::Datafile* datafile = nullptr;
 	if (datafiles.size() == 0 && m_DataPanel->getDatafiles().size() == 1) {
 		datafile = m_DataPanel->getDatafiles().front();
 	}
-	else {
-		datafile = m_DataPanel->getSelectedDatafiles().front();
+	else if (datafiles.size() > 0) {
+		datafile = datafiles.front();
 	}
 	if (datafile == nullptr) {
 		H2A::logWarning("Failed to select a datafile for emcy list.");
-		return false;
-	}
-
-	// Gather EMCY datasets and make sure they are populated before going on
-	for (const auto& dataset : datafile->datasets) {
-		if (dataset->datatype == 10) m_EmcyDatasets.push_back(dataset);
 	}
-	m_DataPanel->requestDatasetPopulation(m_EmcyDatasets, true);
-
-	return true;
-}
-
-/**
-* Create list items for a given emcy.
-* 
-* @param emcy Emcy to create list item for.
-**/
-void EmcyPlot::addItem(const H2A::Emcy::Emcy& emcy) {
-	
-	// Create text label based on emcy data
-	std::stringstream ss;
-	ss << "[" << std::fixed << std::setprecision(3) << emcy.time << "]\t(" << H2A::Emcy::getSeverityStr(emcy.severity) << ")\t" << emcy.description;
-	
-	auto item = new QStandardItem(tr(ss.str().c_str()));
-	item->setData(QVariant().fromValue<H2A::Emcy::Emcy>(emcy), H2A::ItemRole::Emcy);
-	item->setData(emcy.time + 1e-6, H2A::ItemRole::Sorting); // Add 1e-6 to sorting time to make sure cursor is always in front
-	item->setToolTip(QString(emcy.source.c_str()));
-	item->setEditable(false);
-	m_ListModel->appendRow(item);
-
+	return datafile;
 }
 
 /**
@@ -164,9 +215,8 @@ void EmcyPlot::resizeEvent(QResizeEvent* event) {
 * @param event Event that caused this slot to be called.
 **/
 void EmcyPlot::itemDoubleClicked(const QModelIndex& index) {
-	auto item = m_ListModel->itemFromIndex(index);
-	H2A::Emcy::Emcy emcy = item->data(H2A::ItemRole::Emcy).value<H2A::Emcy::Emcy>();
-	emit this->timeCursorPlaced(emcy.time);
+	const H2A::Emcy::Record* emcy = m_ListModel->record(index.row());
+	if (emcy != nullptr) emit this->timeCursorPlaced(emcy->time);
 }
 
 /**
@@ -175,8 +225,7 @@ void EmcyPlot::itemDoubleClicked(const QModelIndex& index) {
 * @param time Time to set the cursor to.
 **/
 void EmcyPlot::setTimeCursorTime(double time) {
-	m_TimeCursor->setData(time, H2A::ItemRole::Sorting);
-	this->sort();
+	m_ListModel->setCursorTime(time);
 }
 
 /**
@@ -185,45 +234,54 @@ void EmcyPlot::setTimeCursorTime(double time) {
 * @param enabled Flag that enables time cursor if true.
 **/
 void EmcyPlot::setTimeCursorEnabled(bool enabled) {
-	m_List->setRowHidden(m_TimeCursor->row(), !enabled);
-}
-
-/**
-* Sort the emcy list.
-**/
-void EmcyPlot::sort() {
-	m_ListModel->sort(0);
+	m_ListModel->setCursorEnabled(enabled);
 }
 
 /**
 * Slot that sets the currently selected car.
 * Connected to signal from PlotManager.
-* Whenever the selected car is changed the EmcyProperties should be reloaded.
+* Whenever the selected car is changed the EMCY definitions of that car are used. The EMCYs are not decoded again: if the
+* same EMCYs are hidden, only the descriptions in the list change, otherwise the index is filtered again.
 * 
 * @param car The currently selected car.
 **/
 void EmcyPlot::setSelectedCar(H2A::Car car) {
-	H2A::Emcy::readEmcyCodesFromSettings(m_EmcyProperties, car);
-	this->fillList();
+	m_EmcyDefinitions = &H2A::Emcy::definitions(car);
+	m_ListModel->setDefinitions(m_EmcyDefinitions);
+	if (this->hiddenCodes() != m_HiddenCodes) this->fillList();
 }
 
 /**
-* Custom delegate to change the height of a QStandardItem.
-* Used to make the TimeCursor much less high.
+* Slot that is called when the time correction of a datafile changed. The EMCY index of the datafile of the list is built
+* again with the corrected times, after which the list is filtered again.
+*
+* @param datafile Datafile of which the time correction changed.
 **/
-ItemDelegate::ItemDelegate(QStandardItemModel* model, TimeCursorItem* timeCursor, QObject* parent) : QStyledItemDelegate(parent),
-m_Model(model),
-m_TimeCursor(timeCursor) {}
+void EmcyPlot::timeCorrected(const H2A::Datafile* datafile) {
+	if (datafile != m_Datafile) return;
+	m_Index = m_DataPanel->getEmcyIndex(m_Datafile);
+	this->applyFilter();
+}
 
 /**
-* Custom delegate to make time cursor item only a single pixel in height.
+* Custom delegate that draws the time cursor as a line between the rows of the list.
 **/
-QSize ItemDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+ItemDelegate::ItemDelegate(const EmcyListModel* model, QObject* parent) : QStyledItemDelegate(parent),
+m_Model(model) {}
+
+/**
+* Paint a row, with the time cursor on top of it (or below it, for the last row) if the cursor is at its position.
+**/
+void ItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
 {
-	QSize s = QStyledItemDelegate::sizeHint(option, index);
-	auto item = m_Model->itemFromIndex(index);
-	if (m_Model->itemFromIndex(index)->row() == m_TimeCursor->row()) {
-		s.setHeight(1);
-	}
-	return s;
+	QStyledItemDelegate::paint(painter, option, index);
+	const bool above = m_Model->cursorAbove(index.row());
+	const bool below = m_Model->cursorBelow(index.row());
+	if (!above && !below) return;
+
+	painter->save();
+	painter->setPen(QPen(QColor(Qt::black), TIME_CURSOR_WIDTH));
+	const int y = above ? option.rect.top() + TIME_CURSOR_WIDTH / 2 : option.rect.bottom() - TIME_CURSOR_WIDTH / 2;
+	painter->drawLine(option.rect.left(), y, option.rect.right(), y);
+	painter->restore();
 }
@@ -0,0 +1,198 @@
+#include "HeatmapPlot.h"
+
+/**
+* Standard constructor.
+**/
+HeatmapPlot::HeatmapPlot(QWidget* parent) : AbstractPlot(parent),
+m_Histogram(nullptr),
+m_Bins(100),
+m_ColorMap(nullptr),
+m_ColorScale(nullptr)
+{
+	m_Type = H2A::Heatmap;
+	this->setInteractions(QCP::iRangeDrag | QCP::iRangeZoom);
+	this->legend->setVisible(false);
+
+	// Empty bins are not drawn, the color of the other bins is on a logarithmic scale
+	this->setCurrentLayer("main");
+	m_ColorMap = new QCPColorMap(this->xAxis, this->yAxis);
+	QCPColorGradient gradient(QCPColorGradient::gpThermal);
+	gradient.setNanHandling(QCPColorGradient::nhTransparent);
+	m_ColorMap->setGradient(gradient);
+	m_ColorMap->setDataScaleType(QCPAxis::stLogarithmic);
+	m_ColorMap->setInterpolate(false);
+	m_ColorMap->setVisible(false);
+
+	m_ColorScale = new QCPColorScale(this);
+	m_ColorScale->setType(QCPAxis::atRight);
+	m_ColorScale->setDataScaleType(QCPAxis::stLogarithmic);
+	m_ColorScale->axis()->setTicker(QSharedPointer<QCPAxisTickerLog>(new QCPAxisTickerLog));
+	m_ColorScale->axis()->setLabel("Time [sec]");
+	m_ColorScale->setVisible(false);
+	this->plotLayout()->addElement(0, 1, m_ColorScale);
+	m_ColorMap->setColorScale(m_ColorScale);
+
+	this->setAxisLabels();
+	AbstractPlot::setTimeCursorEnabled(false);
+}
+
+/**
+* Returns the time window that is binned.
+**/
+QCPRange HeatmapPlot::window() const {
+	return m_FollowTimeWindow ? m_TimeWindow : QCPRange(-QCPRange::maxRange, QCPRange::maxRange);
+}
+
+/**
+* Plot the two-dimensional histogram of the given datasets.
+*
+* @param datasets Datasets to plot, the first on the X axis and the second on the Y axis.
+* @param clearFirst Ignored, a heatmap always replaces its current datasets.
+**/
+void HeatmapPlot::plot(std::vector<const H2A::Dataset*> datasets, bool clearFirst) {
+	if (datasets.size() != 2) {
+		std::stringstream ss;
+		ss << datasets.size() << " datasets selected. Please select 2 for a heatmap.";
+		H2A::Dialog::message(QString(ss.str().c_str()));
+		return;
+	}
+
+	m_Datasets = datasets;
+	m_Histogram.reset(new H2A::Binning::Histogram(datasets[0], datasets[1], m_Bins, m_Bins));
+	if (m_FollowTimeWindow) m_Histogram->setWindow(m_TimeWindow.lower, m_TimeWindow.upper);
+
+	this->updateColorMap();
+	this->setAxisLabels();
+	this->resetView();
+}
+
+/**
+* Clear plot.
+**/
+void HeatmapPlot::clear() {
+	m_Histogram.reset();
+	m_Datasets.clear();
+	m_ColorMap->data()->clear();
+	m_ColorMap->setVisible(false);
+	m_ColorScale->setVisible(false);
+	this->setAxisLabels();
+	AbstractPlot::clear();
+}
+
+/**
+* Set the number of bins along each axis.
+*
+* @param bins Number of bins.
+**/
+void HeatmapPlot::setBins(size_t bins) {
+	m_Bins = bins;
+	if (this->isEmpty()) return;
+	this->plot(m_Datasets);
+}
+
+/**
+* Bin the datasets over the visible time window of the time plots instead of their overlapping duration.
+*
+* @param follow Flag if heatmap should follow the time window.
+**/
+void HeatmapPlot::setFollowTimeWindow(bool follow) {
+	m_FollowTimeWindow = follow;
+	if (this->isEmpty()) return;
+	m_Histogram->setWindow(this->window().lower, this->window().upper);
+	this->updateColorMap();
+	this->replot();
+}
+
+/**
+* Set the time window to bin the datasets over, when following the time window. Only the datapoints that entered
+* or left the window are rebinned, so this is cheap for small changes.
+*
+* @param range Visible time window of the time plots.
+**/
+void HeatmapPlot::setTimeWindow(const QCPRange& range) {
+	m_TimeWindow = range;
+	if (!m_FollowTimeWindow || this->isEmpty()) return;
+	m_Histogram->setWindow(m_TimeWindow.lower, m_TimeWindow.upper);
+	this->updateColorMap();
+	this->replot();
+}
+
+/**
+* Copy the bins of the histogram into the color map.
+**/
+void HeatmapPlot::updateColorMap() {
+	const size_t binsX = m_Histogram->binsX();
+	const size_t binsY = m_Histogram->binsY();
+	m_ColorMap->data()->setSize(static_cast<int>(binsX), static_cast<int>(binsY));
+	m_ColorMap->data()->setRange(QCPRange(m_Histogram->binCenterX(0), m_Histogram->binCenterX(binsX - 1)),
+		QCPRange(m_Histogram->binCenterY(0), m_Histogram->binCenterY(binsY - 1)));
+
+	for (size_t x = 0; x < binsX; ++x) {
+		for (size_t y = 0; y < binsY; ++y) {
+			const double count = m_Histogram->count(x, y);
+			m_ColorMap->data()->setCell(static_cast<int>(x), static_cast<int>(y), count > 0.0 ? count : std::numeric_limits<double>::quiet_NaN());
+		}
+	}
+	m_ColorMap->rescaleDataRange(true);
+	m_ColorMap->setVisible(true);
+	m_ColorScale->setVisible(true);
+}
+
+/**
+* Returns the range of the X dataset.
+**/
+QCPRange HeatmapPlot::dataRangeX() const {
+	if (this->isEmpty()) return QCPRange();
+	return QCPRange(m_Histogram->lowerX(), m_Histogram->upperX());
+}
+
+/**
+* Returns the range of the Y dataset.
+**/
+QCPRange HeatmapPlot::dataRangeY() const {
+	if (this->isEmpty()) return QCPRange();
+	return QCPRange(m_Histogram->lowerY(), m_Histogram->upperY());
+}
+
+/**
+* Set axis labels of the plot.
+**/
+void HeatmapPlot::setAxisLabels() {
+	this->xAxis->setLabel("");
+	this->yAxis->setLabel("");
+	this->xAxis->setTickLabels(!this->isEmpty());
+	this->yAxis->setTickLabels(!this->isEmpty());
+	if (this->isEmpty()) return;
+
+	std::stringstream ss;
+	ss << m_Datasets[0]->name << " (" << m_Datasets[0]->quantity << " [" << m_Datasets[0]->unit << "])";
+	this->xAxis->setLabel(QString(ss.str().c_str()));
+
+	ss.str("");
+	ss << m_Datasets[1]->name << " (" << m_Datasets[1]->quantity << " [" << m_Datasets[1]->unit << "])";
+	this->yAxis->setLabel(QString(ss.str().c_str()));
+}
+
+/**
+* Reset view to fit the heatmap.
+**/
+void HeatmapPlot::resetView() {
+	if (this->isEmpty()) {
+		this->xAxis->setRange(0.0, 10.0);
+		this->yAxis->setRange(0.0, 10.0);
+	}
+	else {
+		m_LimHardX = this->dataRangeX();
+		m_LimHardY = this->dataRangeY();
+		this->xAxis->setRange(m_LimHardX);
+		this->yAxis->setRange(m_LimHardY);
+	}
+	this->replot();
+}
+
+/**
+* The time cursor has no meaning for heatmaps, so it is always disabled.
+**/
+void HeatmapPlot::setTimeCursorEnabled(bool enable) {
+	AbstractPlot::setTimeCursorEnabled(false);
+}
@@ -0,0 +1,73 @@
+#include "HistogramGraph.h"
+
+/**
+* A histogram graph shows the time a single dataset spent at its values,
+* with the values on the X-axis and the time on the Y-axis.
+**/
+HistogramGraph::HistogramGraph(QCustomPlot* parent, const H2A::Dataset* dataset, size_t bins) : AbstractGraph(parent, dataset),
+m_Histogram(new H2A::Binning::Histogram(dataset, bins)),
+m_MaxCount(0.0)
+{
+	m_Graph->setName(QString(dataset->name.c_str()));
+	m_Graph->setLineStyle(QCPGraph::lsStepCenter);
+	this->updateData();
+}
+
+/**
+* Change the number of bins, which rebins the dataset.
+*
+* @param bins Number of bins.
+* @param window Time window to bin.
+**/
+void HistogramGraph::setBins(size_t bins, const QCPRange& window) {
+	m_Histogram.reset(new H2A::Binning::Histogram(m_Datasets.front(), bins));
+	this->setWindow(window);
+}
+
+/**
+* Change the time window that is binned.
+*
+* @param window Time window to bin.
+**/
+void HistogramGraph::setWindow(const QCPRange& window) {
+	m_Histogram->setWindow(window.lower, window.upper);
+	this->updateData();
+}
+
+/**
+* Copy the bins of the histogram into the graph.
+**/
+void HistogramGraph::updateData() {
+	QVector<double> x(m_Histogram->binsX()), y(m_Histogram->binsX());
+	m_MaxCount = 0.0;
+	for (size_t i = 0; i < m_Histogram->binsX(); ++i) {
+		x[i] = m_Histogram->binCenterX(i);
+		y[i] = m_Histogram->count(i);
+		m_MaxCount = std::max(m_MaxCount, y[i]);
+	}
+	m_Graph->setData(x, y, true);
+}
+
+/**
+* Set color of the graph, the area under the graph is filled with a transparent version of the color.
+**/
+void HistogramGraph::setColor(QColor color) {
+	m_Color = color;
+	m_Graph->setPen(QPen(color));
+	color.setAlpha(60);
+	m_Graph->setBrush(QBrush(color));
+}
+
+/**
+* Returns the range of the bins.
+**/
+QCPRange HistogramGraph::rangeX() const {
+	return QCPRange(m_Histogram->lowerX(), m_Histogram->upperX());
+}
+
+/**
+* Returns the range of the bin contents.
+**/
+QCPRange HistogramGraph::rangeY() const {
+	return QCPRange(0.0, m_MaxCount > 0.0 ? m_MaxCount : 1.0);
+}
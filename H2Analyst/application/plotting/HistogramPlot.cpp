@@ -0,0 +1,135 @@
+#include "HistogramPlot.h"
+
+/**
+* Standard constructor.
+**/
+HistogramPlot::HistogramPlot(QWidget* parent) : AbstractPlot(parent),
+m_Bins(100)
+{
+	m_Type = H2A::Histogram;
+	this->setInteractions(QCP::iRangeDrag | QCP::iRangeZoom | QCP::iSelectPlottables | QCP::iMultiSelect);
+	this->legend->setVisible(false);
+	this->setAxisLabels();
+	AbstractPlot::setTimeCursorEnabled(false);
+}
+
+/**
+* Returns the time window that is binned.
+**/
+QCPRange HistogramPlot::window() const {
+	return m_FollowTimeWindow ? m_TimeWindow : QCPRange(-QCPRange::maxRange, QCPRange::maxRange);
+}
+
+/**
+* Plot the histograms of the given list of datasets.
+*
+* @param datasets Datasets to plot.
+* @param clearFirst Flag if plot should be cleared before plotting datasets.
+**/
+void HistogramPlot::plot(std::vector<const H2A::Dataset*> datasets, bool clearFirst) {
+	if (datasets.size() == 0) return;
+
+	if (clearFirst) this->clear();
+
+	for (const auto& dataset : datasets) {
+		auto plotted = this->datasets();
+		if (std::find(plotted.begin(), plotted.end(), dataset) != plotted.end()) continue;
+
+		HistogramGraph* graph = new HistogramGraph(this, dataset, m_Bins);
+		graph->setColor(H2A::PlotColors[m_Graphs.size() % H2A::PlotColors.size()]);
+		if (m_FollowTimeWindow) graph->setWindow(this->window());
+		m_Graphs.push_back(graph);
+	}
+
+	this->setAxisLabels();
+	this->legend->setVisible(true);
+	this->resetView();
+}
+
+/**
+* Set the number of bins of the histograms.
+*
+* @param bins Number of bins.
+**/
+void HistogramPlot::setBins(size_t bins) {
+	m_Bins = bins;
+	for (const auto& graph : m_Graphs) static_cast<HistogramGraph*>(graph)->setBins(m_Bins, this->window());
+	this->resetView();
+}
+
+/**
+* Bin the datasets over the visible time window of the time plots instead of their full duration.
+*
+* @param follow Flag if histograms should follow the time window.
+**/
+void HistogramPlot::setFollowTimeWindow(bool follow) {
+	m_FollowTimeWindow = follow;
+	for (const auto& graph : m_Graphs) static_cast<HistogramGraph*>(graph)->setWindow(this->window());
+	this->resetView();
+}
+
+/**
+* Set the time window to bin the datasets over, when following the time window. Only the datapoints that entered
+* or left the window are rebinned, so this is cheap for small changes.
+*
+* @param range Visible time window of the time plots.
+**/
+void HistogramPlot::setTimeWindow(const QCPRange& range) {
+	m_TimeWindow = range;
+	if (!m_FollowTimeWindow || this->isEmpty()) return;
+
+	for (const auto& graph : m_Graphs) static_cast<HistogramGraph*>(graph)->setWindow(m_TimeWindow);
+	m_LimHardY = QCPRange(0.0, (1.0 + LIMIT_PADDING) * this->dataRangeY().upper);
+	this->yAxis->setRange(0.0, (1.0 + STD_VIEW_PADDING) * this->dataRangeY().upper);
+	this->replot();
+}
+
+/**
+* Set axis labels of the plot.
+**/
+void HistogramPlot::setAxisLabels() {
+	this->xAxis->setLabel("");
+	this->yAxis->setLabel("Time [sec]");
+	this->xAxis->setTickLabels(!this->isEmpty());
+	this->yAxis->setTickLabels(!this->isEmpty());
+	if (this->isEmpty()) return;
+
+	// Create set of dataset units
+	std::set<std::string> units;
+	auto datasets = this->datasets();
+	for (const auto& dataset : datasets) units.insert(dataset->unit);
+
+	std::stringstream ss;
+	if (units.size() == 1) ss << datasets.front()->quantity << "[" << datasets.front()->unit << "]";
+	else ss << "Mixed quantities";
+	this->xAxis->setLabel(QString(ss.str().c_str()));
+}
+
+/**
+* Reset view to fit all histograms.
+**/
+void HistogramPlot::resetView() {
+	if (this->isEmpty()) {
+		this->xAxis->setRange(0.0, 10.0);
+		this->yAxis->setRange(0.0, 10.0);
+		this->setAxisLabels();
+	}
+	else {
+		QCPRange rangeX = this->dataRangeX();
+		QCPRange rangeY = this->dataRangeY();
+		m_LimHardX = QCPRange(rangeX.lower - LIMIT_PADDING * rangeX.size(), rangeX.upper + LIMIT_PADDING * rangeX.size());
+		m_LimHardY = QCPRange(0.0, (1.0 + LIMIT_PADDING) * rangeY.upper);
+
+		const double padding = STD_VIEW_PADDING * rangeX.size();
+		this->xAxis->setRange(rangeX.lower - padding, rangeX.upper + padding);
+		this->yAxis->setRange(0.0, (1.0 + STD_VIEW_PADDING) * rangeY.upper);
+	}
+	this->replot();
+}
+
+/**
+* The time cursor has no meaning for histograms, so it is always disabled.
+**/
+void HistogramPlot::setTimeCursorEnabled(bool enable) {
+	AbstractPlot::setTimeCursorEnabled(false);
+}
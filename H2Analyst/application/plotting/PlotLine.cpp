@@ -14,7 +14,7 @@ m_Color(Qt::black)
 
 	// Save data range
 	rangeX = QCPRange(x.front(), x.back()); // Assumes time vector always points 'to the right'
-	rangeY = QCPRange(*std::min_element(y.begin(), y.end()), *std::max_element(y.begin(), y.end()));
+	rangeY = m_Dataset->stats.hasRange() ? QCPRange(m_Dataset->stats.min, m_Dataset->stats.max) : QCPRange();
 
 	// Add graph and data
 	m_Graph = m_Parent->addGraph();
@@ -10,23 +10,24 @@
 **/
 const bool isSpecial(const std::vector<const H2A::Dataset*> datasets, const H2A::PlotType type, H2A::specialPlot& plot) {
 
-    // Check if list of datasets matches any of the defined special plots
-    std::vector<uint32_t> ds_uids;
-    for (const auto& dataset : datasets)
-        ds_uids.push_back(dataset->uid);
-    std::sort(ds_uids.begin(), ds_uids.end());
-
-    for (const auto& specialPlot : H2A::SpecialPlots) {
-        if (type != specialPlot.type) continue;
-
-        std::vector<uint32_t> uids({ specialPlot.x, specialPlot.y });
-        std::sort(uids.begin(), uids.end());
-        if (ds_uids == uids) {
-            plot = specialPlot;
-            return true;
-        }
-    }
-    return false;
+    // Index of the special plots on their type and (sorted) pair of UIDs, built only once
+    static const std::map<std::tuple<H2A::PlotType, uint32_t, uint32_t>, H2A::specialPlot> index = []() {
+        std::map<std::tuple<H2A::PlotType, uint32_t, uint32_t>, H2A::specialPlot> map;
+        for (const auto& specialPlot : H2A::SpecialPlots)
+            map.emplace(std::make_tuple(specialPlot.type, std::min(specialPlot.x, specialPlot.y), std::max(specialPlot.x, specialPlot.y)), specialPlot);
+        return map;
+    }();
+
+    // All special plots consist of exactly 2 datasets
+    if (datasets.size() != 2) return false;
+
+    const uint32_t uid0 = datasets[0]->uid;
+    const uint32_t uid1 = datasets[1]->uid;
+    auto entry = index.find(std::make_tuple(type, std::min(uid0, uid1), std::max(uid0, uid1)));
+    if (entry == index.end()) return false;
+
+    plot = entry->second;
+    return true;
 
 }
 
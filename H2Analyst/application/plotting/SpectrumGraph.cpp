@@ -0,0 +1,60 @@
+#include "SpectrumGraph.h"
+
+/**
+* A spectrum graph shows the power spectral density of a single dataset,
+* with the frequency on the X-axis and the density on the Y-axis.
+**/
+SpectrumGraph::SpectrumGraph(QCustomPlot* parent, const H2A::Dataset* dataset) : AbstractGraph(parent, dataset),
+m_Spectrum(nullptr)
+{
+	m_Graph->setName(QString(dataset->name.c_str()));
+	m_Graph->setLineStyle(QCPGraph::lsLine);
+}
+
+/**
+* Set the spectrum that is shown by the graph.
+*
+* @param spectrum Spectrum to show, nullptr to show nothing.
+**/
+void SpectrumGraph::setSpectrum(const std::shared_ptr<const H2A::Spectral::Result>& spectrum) {
+	m_Spectrum = spectrum;
+	if (!m_Spectrum) {
+		m_Graph->data()->clear();
+		return;
+	}
+	auto x = QVector<double>(m_Spectrum->frequency.begin(), m_Spectrum->frequency.end());
+	auto y = QVector<double>(m_Spectrum->psd.begin(), m_Spectrum->psd.end());
+	m_Graph->setData(x, y, true);
+}
+
+/**
+* Set color of the graph.
+**/
+void SpectrumGraph::setColor(QColor color) {
+	m_Color = color;
+	m_Graph->setPen(QPen(color));
+}
+
+/**
+* Returns the frequency range of the spectrum, or noRange if there is no spectrum.
+**/
+QCPRange SpectrumGraph::rangeX() const {
+	if (!m_Spectrum || m_Spectrum->frequency.empty()) return noRange();
+	return QCPRange(0.0, m_Spectrum->frequency.back());
+}
+
+/**
+* Returns the range of the positive values of the spectrum, so it can be shown on a logarithmic axis.
+* Returns noRange if there is no spectrum or no positive value.
+**/
+QCPRange SpectrumGraph::rangeY() const {
+	if (!m_Spectrum) return noRange();
+
+	QCPRange range(QCPRange::maxRange, QCPRange::minRange);
+	for (const auto& value : m_Spectrum->psd) {
+		if (value <= 0.0) continue;
+		range.lower = std::min(range.lower, value);
+		range.upper = std::max(range.upper, value);
+	}
+	return range.lower <= range.upper ? range : noRange();
+}
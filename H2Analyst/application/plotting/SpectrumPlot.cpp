@@ -0,0 +1,252 @@
+#include "SpectrumPlot.h"
+
+/**
+* Standard constructor.
+**/
+SpectrumPlot::SpectrumPlot(QWidget* parent) : AbstractPlot(parent),
+m_UpdateTimer(new QTimer(this)),
+m_ColorMap(nullptr)
+{
+	m_Type = H2A::Spectrum;
+	this->setInteractions(QCP::iRangeDrag | QCP::iRangeZoom | QCP::iSelectPlottables | QCP::iMultiSelect);
+	this->legend->setVisible(false);
+
+	this->setCurrentLayer("main");
+	m_ColorMap = new QCPColorMap(this->xAxis, this->yAxis);
+	m_ColorMap->setGradient(QCPColorGradient::gpSpectrum);
+	m_ColorMap->setInterpolate(false);
+	m_ColorMap->setVisible(false);
+	this->setAxisLabels();
+
+	// Spectra are recomputed once the time window stops changing
+	m_UpdateTimer->setSingleShot(true);
+	m_UpdateTimer->setInterval(UPDATE_DELAY);
+	connect(m_UpdateTimer, SIGNAL(timeout()), this, SLOT(updateSpectra()));
+
+	AbstractPlot::setTimeCursorEnabled(false);
+}
+
+/**
+* Plot the spectra of the given list of datasets.
+*
+* @param datasets Datasets to plot.
+* @param clearFirst Flag if plot should be cleared before plotting datasets.
+**/
+void SpectrumPlot::plot(std::vector<const H2A::Dataset*> datasets, bool clearFirst) {
+	if (datasets.size() == 0) return;
+
+	if (clearFirst) this->clear();
+
+	for (const auto& dataset : datasets) {
+		auto plotted = this->datasets();
+		if (std::find(plotted.begin(), plotted.end(), dataset) != plotted.end()) continue;
+
+		SpectrumGraph* graph = new SpectrumGraph(this, dataset);
+		graph->setColor(H2A::PlotColors[m_Graphs.size() % H2A::PlotColors.size()]);
+		m_Graphs.push_back(graph);
+	}
+
+	this->legend->setVisible(!m_Settings.spectrogram);
+	this->updateSpectraAndView();
+}
+
+/**
+* Set the number of samples in a segment of the Welch method. Longer segments give a finer frequency resolution,
+* shorter segments give a smoother spectrum (and a finer time resolution of the spectrogram).
+*
+* @param size Segment size, rounded down to a power of two.
+**/
+void SpectrumPlot::setSegmentSize(size_t size) {
+	m_Settings.segmentSize = size;
+	this->updateSpectraAndView();
+}
+
+/**
+* Show the spectrogram of the first dataset instead of the spectra of all datasets.
+*
+* @param visible Flag if spectrogram should be visible.
+**/
+void SpectrumPlot::setSpectrogramVisible(bool visible) {
+	m_Settings.spectrogram = visible;
+	this->updateSpectraAndView();
+}
+
+/**
+* Compute the spectra over the visible time window of the time plots instead of the full duration of the datasets.
+*
+* @param follow Flag if spectra should follow the time window.
+**/
+void SpectrumPlot::setFollowTimeWindow(bool follow) {
+	m_FollowTimeWindow = follow;
+	this->updateSpectraAndView();
+}
+
+/**
+* Set the time window to compute the spectra over, when following the time window.
+*
+* @param range Visible time window of the time plots.
+**/
+void SpectrumPlot::setTimeWindow(const QCPRange& range) {
+	m_TimeWindow = range;
+	if (m_FollowTimeWindow && !this->isEmpty()) m_UpdateTimer->start();
+}
+
+/**
+* Compute the spectra of all graphs (or the spectrogram of the first) in a separate thread, after which the plot is
+* updated. Results of a computation that was started before the latest one are dropped.
+**/
+void SpectrumPlot::updateSpectra() {
+	const uint64_t generation = ++m_Generation;
+	if (this->isEmpty()) {
+		this->showSpectra({});
+		return;
+	}
+
+	const QCPRange window = m_FollowTimeWindow ? m_TimeWindow : QCPRange(-QCPRange::maxRange, QCPRange::maxRange);
+	auto spectra = std::make_shared<SpectrumWorker::Spectra>();
+
+	QThread* thread = new QThread();
+	SpectrumWorker* worker = new SpectrumWorker(this->datasets(), window.lower, window.upper, m_Settings, spectra);
+	worker->moveToThread(thread);
+
+	connect(thread, &QThread::started, worker, &SpectrumWorker::run);
+	connect(worker, &SpectrumWorker::finished, this, [=]() {
+		if (generation == m_Generation) this->showSpectra(*spectra);
+	});
+	connect(worker, &SpectrumWorker::finished, thread, &QThread::quit);
+	connect(worker, &SpectrumWorker::finished, worker, &SpectrumWorker::deleteLater);
+	connect(thread, &QThread::finished, thread, &QThread::deleteLater);
+
+	thread->start();
+}
+
+/**
+* Compute the spectra and reset the view once they are shown, after the datasets or settings changed.
+**/
+void SpectrumPlot::updateSpectraAndView() {
+	m_ResetPending = true;
+	this->updateSpectra();
+}
+
+/**
+* Show computed spectra in the graphs, or the spectrogram of the first dataset in the color map, and update the plot.
+*
+* @param spectra Spectra in the order of the graphs, of which only the first is used for the spectrogram.
+**/
+void SpectrumPlot::showSpectra(const SpectrumWorker::Spectra& spectra) {
+	if (spectra.size() != m_Graphs.size()) return;
+	m_ColorMap->setVisible(m_Settings.spectrogram && !this->isEmpty());
+
+	for (size_t i = 0; i < m_Graphs.size(); ++i) {
+		SpectrumGraph* spectrumGraph = static_cast<SpectrumGraph*>(m_Graphs[i]);
+		spectrumGraph->setSpectrum(m_Settings.spectrogram ? nullptr : spectra[i]);
+		spectrumGraph->graph()->setVisible(!m_Settings.spectrogram);
+	}
+
+	if (m_ColorMap->visible()) {
+		const auto& spectrum = spectra.front();
+		if (spectrum && spectrum->time.size() > 0) {
+			const arma::mat& power = spectrum->spectrogram;
+			m_ColorMap->data()->setSize(static_cast<int>(power.n_cols), static_cast<int>(power.n_rows));
+			m_ColorMap->data()->setRange(QCPRange(spectrum->time.front(), spectrum->time.back()), QCPRange(0.0, spectrum->frequency.back()));
+			for (arma::uword c = 0; c < power.n_cols; ++c)
+				for (arma::uword r = 0; r < power.n_rows; ++r)
+					m_ColorMap->data()->setCell(static_cast<int>(c), static_cast<int>(r), 10.0 * std::log10(std::max(power(r, c), 1e-30)));
+			m_ColorMap->rescaleDataRange(true);
+		}
+		else m_ColorMap->data()->clear();
+	}
+
+	this->setAxisLabels();
+	this->updateLimits();
+	if (m_ResetPending) {
+		m_ResetPending = false;
+		this->resetView();
+	}
+	else this->replot();
+}
+
+/**
+* Set hard view limits based on the spectra.
+**/
+void SpectrumPlot::updateLimits() {
+	if (this->isEmpty()) {
+		m_LimHardX = QCPRange(-QCPRange::maxRange, QCPRange::maxRange);
+		m_LimHardY = QCPRange(-QCPRange::maxRange, QCPRange::maxRange);
+		return;
+	}
+
+	if (m_Settings.spectrogram) {
+		bool found;
+		m_LimHardX = m_ColorMap->getKeyRange(found);
+		m_LimHardY = m_ColorMap->getValueRange(found);
+		return;
+	}
+
+	m_LimHardX = this->dataRangeX();
+	m_LimHardY = this->dataRangeY();
+	m_LimHardX = QCPRange(m_LimHardX.lower - STD_VIEW_PADDING * m_LimHardX.size(), m_LimHardX.upper + STD_VIEW_PADDING * m_LimHardX.size());
+	m_LimHardY = m_LimHardY.lower > 0.0 ? QCPRange(m_LimHardY.lower / LIMIT_PADDING, m_LimHardY.upper * LIMIT_PADDING) : QCPRange(QCPRange::minRange, QCPRange::maxRange);
+}
+
+/**
+* Set axis labels and scale of the plot.
+**/
+void SpectrumPlot::setAxisLabels() {
+	if (m_Settings.spectrogram) {
+		this->xAxis->setLabel("Time [sec]");
+		this->yAxis->setLabel("Frequency [Hz]");
+		this->yAxis->setScaleType(QCPAxis::stLinear);
+		this->yAxis->setTicker(QSharedPointer<QCPAxisTicker>(new QCPAxisTicker));
+	}
+	else {
+		this->xAxis->setLabel("Frequency [Hz]");
+		this->yAxis->setLabel("PSD");
+		this->yAxis->setScaleType(QCPAxis::stLogarithmic);
+		this->yAxis->setTicker(QSharedPointer<QCPAxisTickerLog>(new QCPAxisTickerLog));
+
+		// Label shows unit if all datasets share the same unit
+		auto datasets = this->datasets();
+		if (datasets.size() > 0 && std::all_of(datasets.begin(), datasets.end(), [&](const H2A::Dataset* d) { return d->unit == datasets.front()->unit; })) {
+			std::stringstream ss;
+			ss << "PSD [" << datasets.front()->unit << "^2/Hz]";
+			this->yAxis->setLabel(QString(ss.str().c_str()));
+		}
+	}
+
+	this->xAxis->setTickLabels(!this->isEmpty());
+	this->yAxis->setTickLabels(!this->isEmpty());
+}
+
+/**
+* Reset view to fit all spectra.
+**/
+void SpectrumPlot::resetView() {
+	this->updateLimits();
+	if (this->isEmpty()) {
+		m_ColorMap->setVisible(false);
+		this->xAxis->setRange(0.0, 10.0);
+		this->yAxis->setScaleType(QCPAxis::stLinear);
+		this->yAxis->setRange(0.0, 10.0);
+		this->setAxisLabels();
+	}
+	else if (m_Settings.spectrogram) {
+		this->xAxis->setRange(m_LimHardX);
+		this->yAxis->setRange(m_LimHardY);
+	}
+	else {
+		QCPRange rangeX = this->dataRangeX();
+		QCPRange rangeY = this->dataRangeY();
+		if (rangeY.lower <= 0.0) rangeY = QCPRange(1e-12, 1.0);
+		this->xAxis->setRange(rangeX);
+		this->yAxis->setRange(rangeY.lower / 2.0, rangeY.upper * 2.0);
+	}
+	this->replot();
+}
+
+/**
+* The time cursor has no meaning in the frequency domain, so it is always disabled.
+**/
+void SpectrumPlot::setTimeCursorEnabled(bool enable) {
+	AbstractPlot::setTimeCursorEnabled(false);
+}
@@ -10,7 +10,7 @@ TimeGraph::TimeGraph(QCustomPlot* parent, const H2A::Dataset* dataset) : Abstrac
 	auto x = QVector<double>(timeVec.begin(), timeVec.end());
 	auto y = QVector<double>(dataset->dataVec.begin(), dataset->dataVec.end());
 
-	m_Graph->setData(x, y);
+	m_Graph->setData(x, y, true); // Time vector is sorted, which keeps datapoints in the order of the dataset
 	m_Graph->setName(QString(dataset->name.c_str()));
 	m_Graph->setLineStyle(QCPGraph::lsStepLeft);
 }
@@ -43,4 +43,34 @@ bool TimeGraph::dataAt(double time, QPointF& point) const {
 		}
 	}
 	return false;
-}
\ No newline at end of file
+}
+/**
+* Read the time of the datapoints from the dataset again, after the time correction of its datafile changed.
+* The correction keeps the time increasing, so the datapoints stay sorted.
+**/
+void TimeGraph::updateTime() {
+	const auto timeVec = m_Datasets.front()->timeVec();
+	auto data = m_Graph->data();
+	if (static_cast<size_t>(data->size()) != timeVec.size()) return;
+
+	size_t i = 0;
+	for (auto it = data->begin(); it != data->end(); ++it) it->key = timeVec[i++];
+}
+
+/**
+* Read the datapoints from the dataset again, after its data changed. Values that were shown instead of the data
+* (see setValues) are discarded, as they do not match the new data.
+**/
+void TimeGraph::reload() {
+	const H2A::Dataset* dataset = m_Datasets.front();
+	dataset->mutex.lock();
+	auto timeVec = dataset->timeVec();
+	auto x = QVector<double>(timeVec.begin(), timeVec.end());
+	auto y = QVector<double>(dataset->dataVec.begin(), dataset->dataVec.end());
+	dataset->mutex.unlock();
+
+	m_ValueIndex.clear();
+	m_Values.clear();
+	m_Values.shrink_to_fit();
+	m_Graph->setData(x, y, true);
+}
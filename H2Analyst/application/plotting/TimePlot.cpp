@@ -3,12 +3,30 @@
 /**
 * Standard constructor.
 **/
-TimePlot::TimePlot(QWidget* parent) : AbstractPlot(parent)
+TimePlot::TimePlot(QWidget* parent) : AbstractPlot(parent),
+m_StatsLabel(nullptr),
+m_StatsVisible(false),
+m_AutoFitY(false)
 {
 	m_Type = H2A::Time;
 	this->setInteractions(QCP::iRangeDrag | QCP::iRangeZoom | QCP::iSelectPlottables | QCP::iMultiSelect);
 	this->setAxisLabels();
 	this->legend->setVisible(false);
+
+	// Statistics readout in top left corner of the plot
+	m_StatsLabel = new QCPItemText(this);
+	m_StatsLabel->setLayer("legend");
+	m_StatsLabel->setClipToAxisRect(true);
+	m_StatsLabel->setBrush(QBrush(Qt::white));
+	m_StatsLabel->setPen(QPen(Qt::black));
+	m_StatsLabel->setPadding(QMargins(2, 2, 2, 2));
+	m_StatsLabel->setTextAlignment(Qt::AlignLeft);
+	m_StatsLabel->setPositionAlignment(Qt::AlignLeft | Qt::AlignTop);
+	m_StatsLabel->position->setType(QCPItemPosition::ptAxisRectRatio);
+	m_StatsLabel->position->setCoords(0.01, 0.01);
+	m_StatsLabel->setVisible(false);
+
+	connect(this->xAxis, SIGNAL(rangeChanged(const QCPRange&)), this, SLOT(xRangeChanged(const QCPRange&)));
 }
 
 /**
@@ -22,6 +40,7 @@ void TimePlot::plot(std::vector<const H2A::Dataset*> datasets, bool clearFirst)
 
 	if (clearFirst) this->clear();
 
+	std::vector<AbstractGraph*> newGraphs;
 	for (const auto& dataset : datasets) {
 
 		// Check if dataset is not already plotted
@@ -38,22 +57,57 @@ void TimePlot::plot(std::vector<const H2A::Dataset*> datasets, bool clearFirst)
 		TimeGraph* graph = new TimeGraph(this, dataset);
 		graph->setColor(H2A::PlotColors[m_Graphs.size() % H2A::PlotColors.size()]);
 		m_Graphs.push_back(graph);
+		newGraphs.push_back(graph);
 	}
+	if (m_Filter.type != H2A::FilterType::None) this->applyFilter(newGraphs);
 
 	this->setAxisLabels();
+	this->updateLimits();
 
-	// Set hard view limits based on graph ranges
-	m_LimHardX = m_Graphs.front()->rangeX();
-	m_LimHardY = m_Graphs.front()->rangeY();
-	for (auto const& graph : m_Graphs) {
-		m_LimHardX.expand(graph->rangeX());
-		m_LimHardY.expand(graph->rangeY());
-	}
+	this->legend->setVisible(true);
+	this->resetView();
+	this->updateStatistics();
+}
+
+/**
+* Set hard view limits based on the ranges of the graphs, which are the ranges of the shown (possibly filtered) values.
+**/
+void TimePlot::updateLimits() {
+	if (this->isEmpty()) return;
+
+	m_LimHardX = this->dataRangeX();
+	m_LimHardY = this->dataRangeY();
+	if (m_LimHardY.size() <= 0.0) m_LimHardY = QCPRange(m_LimHardY.lower - 0.5, m_LimHardY.upper + 0.5);
 	m_LimHardX = QCPRange(m_LimHardX.lower - LIMIT_PADDING * m_LimHardX.size(), m_LimHardX.upper + LIMIT_PADDING * m_LimHardX.size());
 	m_LimHardY = QCPRange(m_LimHardY.lower - LIMIT_PADDING * m_LimHardY.size(), m_LimHardY.upper + LIMIT_PADDING * m_LimHardY.size());
+}
 
-	this->legend->setVisible(true);
-	this->resetView();
+/**
+* Update the time of the graphs and the view limits after the time correction of a datafile changed.
+*
+* @param datafile Datafile of which the time correction changed.
+**/
+void TimePlot::timeCorrected(const H2A::Datafile* datafile) {
+	this->updateLimits();
+	AbstractPlot::timeCorrected(datafile);
+}
+
+/**
+* Show the new data of a dataset, filtered with the filter of this plot, and update the view limits and statistics.
+*
+* @param dataset Dataset of which the data changed.
+**/
+void TimePlot::datasetChanged(const H2A::Dataset* dataset) {
+	std::vector<AbstractGraph*> graphs;
+	for (const auto& graph : m_Graphs)
+		if (graph->datasets().front() == dataset) graphs.push_back(graph);
+	if (graphs.empty()) return;
+
+	for (const auto& graph : graphs) graph->reload();
+	this->applyFilter(graphs);
+	this->updateLimits();
+	this->updateStatistics();
+	this->replot();
 }
 
 /**
@@ -106,6 +160,7 @@ void TimePlot::resetView() {
 		rangeX = QCPRange(rangeX.lower - padding, rangeX.upper + padding);
 
 		QCPRange rangeY = this->dataRangeY();
+		if (rangeY.size() <= 0.0) rangeY = QCPRange(rangeY.lower - 0.5, rangeY.upper + 0.5);
 		padding = rangeY.size() * STD_VIEW_PADDING;
 		rangeY = QCPRange(rangeY.lower - padding, rangeY.upper + padding);
 
@@ -128,3 +183,115 @@ void TimePlot::mouseDoubleClickEvent(QMouseEvent* event) {
 
 	AbstractPlot::mouseDoubleClickEvent(event);
 }
+
+/**
+* Show or hide the statistics (min, max, mean, RMS and integral) of all graphs over the visible time window.
+*
+* @param visible Flag if statistics should be visible.
+**/
+void TimePlot::setStatisticsVisible(bool visible) {
+	m_StatsVisible = visible;
+	this->updateStatistics();
+	this->replot();
+}
+
+/**
+* Enable or disable automatic fitting of the Y axis to the visible data when the time axis changes.
+*
+* @param enable Flag if Y axis should be fitted automatically.
+**/
+void TimePlot::setAutoFitY(bool enable) {
+	m_AutoFitY = enable;
+	if (m_AutoFitY) {
+		this->fitY();
+		this->replot();
+	}
+}
+
+/**
+* Fit the Y axis to the data of all graphs within the visible time window.
+**/
+void TimePlot::fitY() {
+	if (this->isEmpty()) return;
+
+	QCPRange rangeY = AbstractGraph::noRange();
+	for (const auto& graph : m_Graphs) {
+		const QCPRange graphRange = graph->rangeY(this->xAxis->range());
+		if (!AbstractGraph::hasRange(graphRange)) continue;
+		if (AbstractGraph::hasRange(rangeY)) rangeY.expand(graphRange);
+		else rangeY = graphRange;
+	}
+	if (!AbstractGraph::hasRange(rangeY)) return;
+
+	double padding = rangeY.size() > 0.0 ? rangeY.size() * FIT_PADDING : 1.0;
+	this->yAxis->setRange(rangeY.lower - padding, rangeY.upper + padding);
+}
+
+/**
+* Slot that is called when the time axis changes.
+*
+* @param range New range of the time axis.
+**/
+void TimePlot::xRangeChanged(const QCPRange& range) {
+	if (m_AutoFitY) this->fitY();
+	this->updateStatistics();
+}
+
+/**
+* Update the statistics readout with the data of all graphs within the visible time window.
+**/
+void TimePlot::updateStatistics() {
+	m_StatsLabel->setVisible(m_StatsVisible && !this->isEmpty());
+	if (!m_StatsLabel->visible()) return;
+
+	std::stringstream ss;
+	ss << std::setprecision(4);
+	for (const auto& graph : m_Graphs) {
+		if (graph != m_Graphs.front()) ss << "\n";
+		ss << graph->datasets().front()->name << ": ";
+
+		H2A::WindowStats stats;
+		if (!graph->windowStats(this->xAxis->range(), stats)) {
+			ss << "no data";
+			continue;
+		}
+		ss << "min " << stats.min << ", max " << stats.max << ", mean " << stats.mean << ", rms " << stats.rms << ", integral " << stats.integral;
+	}
+	m_StatsLabel->setText(QString(ss.str().c_str()));
+}
+
+/**
+* Show all graphs filtered with the given filter. The datasets are not modified, so the filter can be changed or removed
+* (with filter type None) at any time. The view limits, the Y axis and the statistics follow the shown values, so the Y
+* axis is fitted to the (un)filtered data in the visible time window.
+*
+* @param settings Type and parameter of the filter.
+**/
+void TimePlot::setFilter(const H2A::Filters::Settings& settings) {
+	m_Filter = settings;
+	this->applyFilter(m_Graphs);
+	this->updateLimits();
+	this->fitY();
+	this->updateStatistics();
+	this->replot();
+}
+
+/**
+* Filter the datasets of the given graphs in parallel, and show the result in the graphs.
+* Without filter, the graphs show the data of their datasets again.
+*
+* @param graphs Graphs to apply the filter of this plot to.
+**/
+void TimePlot::applyFilter(const std::vector<AbstractGraph*>& graphs) {
+	if (m_Filter.type == H2A::FilterType::None) {
+		for (const auto& graph : graphs) graph->clearValues();
+		return;
+	}
+
+	std::vector<const H2A::Dataset*> datasets;
+	for (const auto& graph : graphs) datasets.push_back(graph->datasets().front());
+
+	std::vector<std::vector<double>> values;
+	H2A::Filters::apply(datasets, m_Filter, values);
+	for (size_t i = 0; i < graphs.size(); ++i) graphs[i]->setValues(std::move(values[i]));
+}
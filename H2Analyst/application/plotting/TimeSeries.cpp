@@ -12,8 +12,9 @@ TimeSeries::TimeSeries(QCustomPlot* plot, const H2A::Dataset* dataset) : Plottab
 	QVector<double> y(m_Dataset->dataVec.begin(), m_Dataset->dataVec.end());
 
 	// Save data range
-	m_RangeX = QCPRange(*std::min_element(x.begin(), x.end()), *std::max_element(x.begin(), x.end()));
-	m_RangeY = QCPRange(*std::min_element(y.begin(), y.end()), *std::max_element(y.begin(), y.end()));
+	const H2A::DatasetStats& stats = m_Dataset->stats;
+	m_RangeX = QCPRange(m_Dataset->datafile->correctTime(stats.firstTime), m_Dataset->datafile->correctTime(stats.lastTime));
+	m_RangeY = stats.hasRange() ? QCPRange(stats.min, stats.max) : QCPRange();
 
 	// Add graph and data
 	m_Graph = m_Plot->addGraph();
@@ -86,7 +87,8 @@ const QPointF TimeSeries::dataAt(double time) const {
 
 const bool TimeSeries::boundedRangeY(const QCPRange bounds, QCPRange& range) const
 {
-	bool foundRange;
-	range = m_Graph->getValueRange(foundRange, QCP::sdBoth, bounds);
-	return foundRange;
+	H2A::WindowStats stats;
+	if (!m_Dataset->windowStats(bounds.lower, bounds.upper, stats)) return false;
+	range = QCPRange(stats.min, stats.max);
+	return true;
 }
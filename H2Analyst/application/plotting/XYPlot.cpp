@@ -0,0 +1,207 @@
+#include "XYPlot.h"
+
+/**
+* Standard constructor.
+**/
+XYPlot::XYPlot(QWidget* parent) : AbstractPlot(parent),
+m_Raster(nullptr),
+m_ColorMap(nullptr),
+m_ColorScale(nullptr),
+m_UpdateTimer(new QTimer(this))
+{
+	m_Type = H2A::XY;
+	this->setInteractions(QCP::iRangeDrag | QCP::iRangeZoom);
+	this->legend->setVisible(false);
+
+	this->setCurrentLayer("main");
+	m_ColorMap = new QCPColorMap(this->xAxis, this->yAxis);
+	QCPColorGradient gradient(QCPColorGradient::gpThermal);
+	gradient.setNanHandling(QCPColorGradient::nhTransparent);
+	m_ColorMap->setGradient(gradient);
+	m_ColorMap->setInterpolate(false);
+	m_ColorMap->setVisible(false);
+
+	m_ColorScale = new QCPColorScale(this);
+	m_ColorScale->setType(QCPAxis::atRight);
+	m_ColorScale->setVisible(false);
+	this->plotLayout()->addElement(0, 1, m_ColorScale);
+	m_ColorMap->setColorScale(m_ColorScale);
+
+	// Raster is aggregated once all changes of the view in an event are processed
+	m_UpdateTimer->setSingleShot(true);
+	m_UpdateTimer->setInterval(0);
+	connect(m_UpdateTimer, SIGNAL(timeout()), this, SLOT(updateRaster()));
+	connect(this->xAxis, SIGNAL(rangeChanged(QCPRange)), m_UpdateTimer, SLOT(start()));
+	connect(this->yAxis, SIGNAL(rangeChanged(QCPRange)), m_UpdateTimer, SLOT(start()));
+
+	this->setAxisLabels();
+	AbstractPlot::setTimeCursorEnabled(false);
+}
+
+/**
+* Plot the second dataset against the first, optionally colored by the third.
+*
+* @param datasets Datasets to plot: X, Y and optionally color.
+* @param clearFirst Ignored, an XY plot always replaces its current datasets.
+**/
+void XYPlot::plot(std::vector<const H2A::Dataset*> datasets, bool clearFirst) {
+	if (datasets.size() != 2 && datasets.size() != 3) {
+		std::stringstream ss;
+		ss << datasets.size() << " datasets selected. Please select 2 for XY plot, or 3 to color by the third.";
+		H2A::Dialog::message(QString(ss.str().c_str()));
+		return;
+	}
+
+	m_Datasets = datasets;
+	m_Raster.reset(new H2A::DensityRaster(datasets));
+	if (m_FollowTimeWindow) m_Raster->setWindow(m_TimeWindow.lower, m_TimeWindow.upper);
+
+	// Counts span orders of magnitude, so they are shown on a logarithmic scale
+	const bool color = m_Raster->hasColor();
+	m_ColorMap->setDataScaleType(color ? QCPAxis::stLinear : QCPAxis::stLogarithmic);
+	m_ColorScale->setDataScaleType(color ? QCPAxis::stLinear : QCPAxis::stLogarithmic);
+	if (color) m_ColorScale->axis()->setTicker(QSharedPointer<QCPAxisTicker>(new QCPAxisTicker));
+	else m_ColorScale->axis()->setTicker(QSharedPointer<QCPAxisTickerLog>(new QCPAxisTickerLog));
+	std::stringstream ss;
+	if (color) ss << m_Datasets[2]->name << " [" << m_Datasets[2]->unit << "]";
+	else ss << "Datapoints";
+	m_ColorScale->axis()->setLabel(QString(ss.str().c_str()));
+
+	m_ColorMap->setVisible(true);
+	m_ColorScale->setVisible(true);
+	this->setAxisLabels();
+	this->resetView();
+}
+
+/**
+* Clear plot.
+**/
+void XYPlot::clear() {
+	m_Raster.reset();
+	m_Datasets.clear();
+	m_ColorMap->data()->clear();
+	m_ColorMap->setVisible(false);
+	m_ColorScale->setVisible(false);
+	this->setAxisLabels();
+	AbstractPlot::clear();
+}
+
+/**
+* Only plot the datapoints within the visible time window of the time plots.
+*
+* @param follow Flag if plot should follow the time window.
+**/
+void XYPlot::setFollowTimeWindow(bool follow) {
+	m_FollowTimeWindow = follow;
+	if (this->isEmpty()) return;
+	if (m_FollowTimeWindow) m_Raster->setWindow(m_TimeWindow.lower, m_TimeWindow.upper);
+	else m_Raster->setWindow(-QCPRange::maxRange, QCPRange::maxRange);
+	this->updateRaster();
+}
+
+/**
+* Set the time window of datapoints to plot, when following the time window.
+*
+* @param range Visible time window of the time plots.
+**/
+void XYPlot::setTimeWindow(const QCPRange& range) {
+	m_TimeWindow = range;
+	if (!m_FollowTimeWindow || this->isEmpty()) return;
+	m_Raster->setWindow(m_TimeWindow.lower, m_TimeWindow.upper);
+	m_UpdateTimer->start();
+}
+
+/**
+* Aggregate the datapoints in the visible area into a raster with one cell per pixel.
+**/
+void XYPlot::updateRaster() {
+	if (this->isEmpty()) return;
+
+	const QCPRange rangeX = this->xAxis->range();
+	const QCPRange rangeY = this->yAxis->range();
+	const int width = std::max(this->axisRect()->width(), 1);
+	const int height = std::max(this->axisRect()->height(), 1);
+	m_Raster->render(rangeX.lower, rangeX.upper, rangeY.lower, rangeY.upper, width, height, m_Cells);
+
+	// Color map range spans the centers of the outer cells
+	const double halfX = 0.5 * rangeX.size() / width;
+	const double halfY = 0.5 * rangeY.size() / height;
+	m_ColorMap->data()->setSize(width, height);
+	m_ColorMap->data()->setRange(QCPRange(rangeX.lower + halfX, rangeX.upper - halfX), QCPRange(rangeY.lower + halfY, rangeY.upper - halfY));
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x)
+			m_ColorMap->data()->setCell(x, y, m_Cells[x + static_cast<size_t>(y) * width]);
+	m_ColorMap->rescaleDataRange(true);
+	this->replot();
+}
+
+/**
+* Returns the range of the X dataset.
+**/
+QCPRange XYPlot::dataRangeX() const {
+	if (this->isEmpty() || !m_Datasets[0]->stats.hasRange()) return QCPRange();
+	return QCPRange(m_Datasets[0]->stats.min, m_Datasets[0]->stats.max);
+}
+
+/**
+* Returns the range of the Y dataset.
+**/
+QCPRange XYPlot::dataRangeY() const {
+	if (this->isEmpty() || !m_Datasets[1]->stats.hasRange()) return QCPRange();
+	return QCPRange(m_Datasets[1]->stats.min, m_Datasets[1]->stats.max);
+}
+
+/**
+* Set axis labels of the plot.
+**/
+void XYPlot::setAxisLabels() {
+	this->xAxis->setLabel("");
+	this->yAxis->setLabel("");
+	this->xAxis->setTickLabels(!this->isEmpty());
+	this->yAxis->setTickLabels(!this->isEmpty());
+	if (this->isEmpty()) return;
+
+	std::stringstream ss;
+	ss << m_Datasets[0]->name << " (" << m_Datasets[0]->quantity << " [" << m_Datasets[0]->unit << "])";
+	this->xAxis->setLabel(QString(ss.str().c_str()));
+
+	ss.str("");
+	ss << m_Datasets[1]->name << " (" << m_Datasets[1]->quantity << " [" << m_Datasets[1]->unit << "])";
+	this->yAxis->setLabel(QString(ss.str().c_str()));
+}
+
+/**
+* Reset view to fit all data with some padding.
+**/
+void XYPlot::resetView() {
+	if (this->isEmpty()) {
+		this->xAxis->setRange(0.0, 10.0);
+		this->yAxis->setRange(0.0, 10.0);
+	}
+	else {
+		QCPRange rangeX = this->dataRangeX();
+		QCPRange rangeY = this->dataRangeY();
+		if (rangeX.size() <= 0.0) rangeX = QCPRange(rangeX.lower - 0.5, rangeX.upper + 0.5);
+		if (rangeY.size() <= 0.0) rangeY = QCPRange(rangeY.lower - 0.5, rangeY.upper + 0.5);
+		m_LimHardX = QCPRange(rangeX.lower - LIMIT_PADDING * rangeX.size(), rangeX.upper + LIMIT_PADDING * rangeX.size());
+		m_LimHardY = QCPRange(rangeY.lower - LIMIT_PADDING * rangeY.size(), rangeY.upper + LIMIT_PADDING * rangeY.size());
+		this->xAxis->setRange(rangeX.lower - STD_VIEW_PADDING * rangeX.size(), rangeX.upper + STD_VIEW_PADDING * rangeX.size());
+		this->yAxis->setRange(rangeY.lower - STD_VIEW_PADDING * rangeY.size(), rangeY.upper + STD_VIEW_PADDING * rangeY.size());
+	}
+	this->replot();
+}
+
+/**
+* The raster has one cell per pixel, so it is aggregated again when the plot is resized.
+**/
+void XYPlot::resizeEvent(QResizeEvent* event) {
+	AbstractPlot::resizeEvent(event);
+	m_UpdateTimer->start();
+}
+
+/**
+* The time cursor has no meaning in an XY plot, so it is always disabled.
+**/
+void XYPlot::setTimeCursorEnabled(bool enable) {
+	AbstractPlot::setTimeCursorEnabled(false);
+}
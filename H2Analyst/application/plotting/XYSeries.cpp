@@ -1,7 +1,7 @@
 #include "XYSeries.h"
 
 
-XYSeries::XYSeries(QCustomPlot* plot, const std::vector<const H2A::Dataset*> datasets) : Plottable(plot)
+XYSeries::XYSeries(QCustomPlot* plot, const std::vector<const H2A::Dataset*> datasets, H2A::ResampleMode mode) : Plottable(plot)
 {
 
 	// Check dataset vector contains 2 datasets
@@ -16,14 +16,14 @@ XYSeries::XYSeries(QCustomPlot* plot, const std::vector<const H2A::Dataset*> dat
 	// Create QVectors from data
 	std::vector<double> time;
 	std::vector<std::vector<double>> data;
-	H2A::resample(datasets, time, data);
+	H2A::resampleOnOverlap(datasets, 0.0, time, data, mode);
 	QVector<double> x(data[0].begin(), data[0].end());
 	QVector<double> y(data[1].begin(), data[1].end());
 
 
 	// Save data range
-	m_RangeX = QCPRange(*std::min_element(x.begin(), x.end()), *std::max_element(x.begin(), x.end()));
-	m_RangeY = QCPRange(*std::min_element(y.begin(), y.end()), *std::max_element(y.begin(), y.end()));
+	m_RangeX = datasets[0]->stats.hasRange() ? QCPRange(datasets[0]->stats.min, datasets[0]->stats.max) : QCPRange();
+	m_RangeY = datasets[1]->stats.hasRange() ? QCPRange(datasets[1]->stats.min, datasets[1]->stats.max) : QCPRange();
 
 	plot->setCurrentLayer("main");
 	m_Curve = new QCPCurve(m_Plot->xAxis, m_Plot->yAxis);
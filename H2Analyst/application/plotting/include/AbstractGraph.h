@@ -12,6 +12,10 @@ protected:
 	std::vector<const H2A::Dataset*> m_Datasets;
 	QCPGraph* m_Graph;
 
+	// Transformed values that are shown instead of the data of the dataset, with their index for ranges and statistics
+	std::vector<double> m_Values;
+	H2A::RangeIndex m_ValueIndex;
+
 public:
 
 	AbstractGraph(QCustomPlot* parent, const H2A::Dataset* dataset);
@@ -19,9 +23,17 @@ public:
 
 	QCPGraph* graph() { return m_Graph; };
 	std::vector<const H2A::Dataset*> datasets() const { return m_Datasets; };
+	static QCPRange noRange() { return QCPRange(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN()); };
+	static bool hasRange(const QCPRange& range) { return !std::isnan(range.lower) && !std::isnan(range.upper); };
 	virtual QCPRange rangeX() const;
 	virtual QCPRange rangeY() const;
+	virtual QCPRange rangeY(const QCPRange& rangeX) const;
+	virtual bool windowStats(const QCPRange& rangeX, H2A::WindowStats& stats) const;
 	virtual bool dataAt(double time, QPointF& point) const { return false; };
+	virtual void setValues(std::vector<double> values);
+	virtual void clearValues();
+	virtual void updateTime() {};
+	virtual void reload() {};
 	virtual void setColor(QColor color) {};
 	virtual QColor color() const { return m_Color; }
 };
@@ -32,6 +32,10 @@ protected:
 	QCPRange m_LimHardX, m_LimHardY;
 	bool m_BusyEnforcingViewLimits;
 
+	// Visible time window of the time plots, used by plots that do not have a time axis themselves
+	bool m_FollowTimeWindow;
+	QCPRange m_TimeWindow;
+
 	virtual void setAxisLabels() {};
 
 public:
@@ -42,6 +46,9 @@ public:
 	H2A::PlotType type() const { return m_Type; };
 	std::vector<const H2A::Dataset*> datasets() const;
 	std::vector<AbstractGraph*> graphs() const { return m_Graphs; };
+	bool followTimeWindow() const { return m_FollowTimeWindow; };
+	virtual void setFollowTimeWindow(bool follow) { m_FollowTimeWindow = follow; };
+	virtual void setTimeWindow(const QCPRange& range) { m_TimeWindow = range; };
 
 	// Properties
 	virtual bool isEmpty() const { return m_Graphs.size() == 0; }
@@ -73,12 +80,14 @@ private slots:
 
 public slots:
 	virtual void resetView() {};
-	void clear();
+	virtual void clear();
 	void clip();
 
 	// Time cursor
 	virtual void setTimeCursorEnabled(bool enable);
 	virtual void setTimeCursorTime(double time);
+	virtual void timeCorrected(const H2A::Datafile* datafile);
+	virtual void datasetChanged(const H2A::Dataset* dataset);
 
 signals:
 	void contextMenuRequested(AbstractPlot* source, const QPoint& pos);
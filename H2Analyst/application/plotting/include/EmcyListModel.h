@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QString>
+#include <QVariant>
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+#include "Emcies.h"
+
+Q_DECLARE_METATYPE(H2A::Emcy::Emcy)
+
+/**
+* Model of the EMCY list, on the positions of the listed EMCYs in the EMCY index of a datafile. Filtering the list only
+* replaces the positions. Labels, tooltips and EMCY structs are only created in data(), for the rows that are shown, so the
+* size of the list does not matter for opening and scrolling it.
+* The time cursor is not a row of the model: it is drawn by the delegate as a line on top of the first EMCY at or after the
+* cursor time, which is found by binary search. Moving it only repaints two rows, so all rows keep the same height.
+**/
+class EmcyListModel : public QAbstractListModel
+{
+	Q_OBJECT
+
+	std::shared_ptr<const H2A::Emcy::Index> m_Index;
+	std::vector<uint32_t> m_Positions; // Positions of the listed EMCYs in the index, in time order
+	const H2A::Emcy::Definitions* m_Definitions;
+
+	bool m_CursorEnabled;
+	double m_CursorTime;
+	int m_CursorRow; // First row at or after the time cursor, equal to the number of rows in front of it
+
+	int cursorPosition(double time) const;
+	void updateRows(int first, int last);
+
+public:
+	EmcyListModel(const H2A::Emcy::Definitions* definitions, QObject* parent = nullptr);
+
+	int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+	void setEmcies(std::shared_ptr<const H2A::Emcy::Index> index, std::vector<uint32_t> positions);
+	const H2A::Emcy::Record* record(int row) const;
+	void setDefinitions(const H2A::Emcy::Definitions* definitions);
+	size_t size() const { return m_Positions.size(); };
+
+	bool cursorAbove(int row) const { return m_CursorEnabled && row == m_CursorRow; };
+	bool cursorBelow(int row) const { return m_CursorEnabled && row + 1 == m_CursorRow && m_CursorRow == static_cast<int>(m_Positions.size()); };
+	void setCursorEnabled(bool enabled);
+	void setCursorTime(double time);
+};
@@ -2,40 +2,39 @@
 
 
 #include <QListWidget>
+#include <QStyledItemDelegate>
+#include <QPainter>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QPushButton>
+#include <QDoubleValidator>
+#include <QRegularExpressionValidator>
 #include "Emcies.h"
+#include "EmcyListModel.h"
 #include "AbstractPlot.h"
 #include "DataPanel.h"
+#include "DialogEmcySearch.h"
 #include "StringOperations.h"
 
-#include <QVariant>
-
 #include <algorithm>
-#include <boost/range/combine.hpp>
 #include <boost/algorithm/string/regex.hpp>
-#include <fstream>
-#include <filesystem>
 #include <map>
-#include <iomanip>
+#include <set>
+#include <execution>
+#include <numeric>
 
 /**
 * Emcy codes defined here: https://github.com/StichtingFormulaZeroTeamDelft/Software_F8/blob/fda9a0777535e28049107f6815ac82edf8b60bf5/iar_workspace/generic/definitions/emcy_list.c
 **/
 
-Q_DECLARE_METATYPE(H2A::Emcy::Emcy)
-
-class TimeCursorItem : public QStandardItem
-{
-public:
-	TimeCursorItem() : QStandardItem("") {};
-};
-
 class ItemDelegate : public QStyledItemDelegate
 {
-	QStandardItemModel* m_Model;
-	TimeCursorItem* m_TimeCursor;
+	const int TIME_CURSOR_WIDTH = 2;
+
+	const EmcyListModel* m_Model;
 public:
-	ItemDelegate(QStandardItemModel* model, TimeCursorItem* timeCursor, QObject* parent = nullptr);
-	QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+	ItemDelegate(const EmcyListModel* model, QObject* parent = nullptr);
+	void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
 };
 
 
@@ -48,24 +47,33 @@ class EmcyPlot : public AbstractPlot
 	QVBoxLayout* m_VLayout;
 	QWidget* m_WarningMsg;
 
+	// Filter bar
+	QLineEdit* m_CodeFilter;
+	QComboBox* m_SeverityFilter;
+	QComboBox* m_SourceFilter;
+	QLineEdit* m_StartFilter;
+	QLineEdit* m_EndFilter;
+	QLabel* m_FilterCount;
+
 	// List view objects
 	QListView* m_List;
-	QStandardItemModel* m_ListModel;
+	EmcyListModel* m_ListModel;
 	ItemDelegate* m_ItemDelegate;
 
 	const DataPanel* m_DataPanel;
 
-	QMutex* m_DataMutex;
-	std::vector<const H2A::Dataset*> m_EmcyDatasets;
-	std::map<uint16_t, H2A::Emcy::Properties> m_EmcyProperties;
-	
-	// Time cursor
-	TimeCursorItem* m_TimeCursor;
+	const H2A::Emcy::Definitions* m_EmcyDefinitions;
+
+	const H2A::Datafile* m_Datafile;
+	std::shared_ptr<const H2A::Emcy::Index> m_Index; // All EMCYs of the datafile (including hidden ones), which are filtered into the list
+	std::set<uint16_t> m_HiddenCodes; // Codes of the EMCYs that are hidden by the current definitions
 
-	bool getDatasets();
+	QWidget* createFilterBar();
+	const H2A::Datafile* getDatafile() const;
+	void readEmcies();
 	void fillList();
-	void addItem(const H2A::Emcy::Emcy& emcy);
-	void sort();
+	std::set<uint16_t> hiddenCodes() const;
+	H2A::Emcy::Filter filter() const;
 	//void drawTimeCursor();
 
 public:
@@ -78,11 +86,14 @@ protected:
 
 private slots:
 	void itemDoubleClicked(const QModelIndex&);
+	void applyFilter();
+	void searchLogs();
 
 public slots:
 	virtual void setTimeCursorEnabled(bool enable);
 	virtual void setTimeCursorTime(double time);
 	void setSelectedCar(H2A::Car car);
+	void timeCorrected(const H2A::Datafile* datafile) override;
 
 signals:
 	void setTimeCursor(double time);
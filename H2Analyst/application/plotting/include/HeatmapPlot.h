@@ -0,0 +1,54 @@
+#pragma once
+
+#include "AbstractPlot.h"
+#include "Binning.h"
+#include "Dialogs.h"
+
+#include <memory>
+
+/**
+* Plot that shows the two-dimensional histogram of two datasets as a heatmap: the time spent at every combination
+* of their values, over their overlapping duration or over the visible time window of the time plots.
+**/
+class HeatmapPlot : public AbstractPlot
+{
+
+	Q_OBJECT
+
+	std::vector<const H2A::Dataset*> m_Datasets;
+	std::unique_ptr<H2A::Binning::Histogram> m_Histogram;
+	size_t m_Bins;
+
+	QCPColorMap* m_ColorMap;
+	QCPColorScale* m_ColorScale;
+
+	QCPRange window() const;
+	void updateColorMap();
+
+public:
+
+	HeatmapPlot(QWidget* parent);
+
+	// Getters/Setters
+	size_t bins() const { return m_Bins; };
+	void setBins(size_t bins);
+	void setFollowTimeWindow(bool follow) override;
+	void setTimeWindow(const QCPRange& range) override;
+
+	// Properties
+	bool isEmpty() const override { return m_Histogram == nullptr; };
+	QCPRange dataRangeX() const override;
+	QCPRange dataRangeY() const override;
+
+	// Actions
+	void plot(std::vector<const H2A::Dataset*> datasets, bool clearFirst = false) override;
+	void resetView() override;
+
+protected:
+	virtual void setAxisLabels() override;
+
+public slots:
+	void clear() override;
+	void setTimeCursorEnabled(bool enable) override;
+
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "AbstractGraph.h"
+#include "Binning.h"
+
+#include <memory>
+
+class HistogramGraph : public AbstractGraph
+{
+
+	std::unique_ptr<H2A::Binning::Histogram> m_Histogram;
+	double m_MaxCount;
+
+	void updateData();
+
+public:
+	HistogramGraph(QCustomPlot* parent, const H2A::Dataset* dataset, size_t bins);
+
+	void setBins(size_t bins, const QCPRange& window);
+	void setWindow(const QCPRange& window);
+
+	void setColor(QColor color) override;
+	QCPRange rangeX() const override;
+	QCPRange rangeY() const override;
+	bool windowStats(const QCPRange& rangeX, H2A::WindowStats& stats) const override { return false; };
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "AbstractPlot.h"
+#include "HistogramGraph.h"
+
+#include <set>
+
+/**
+* Plot that shows the histograms of datasets: the time spent at their values, over their full duration or over the
+* visible time window of the time plots.
+**/
+class HistogramPlot : public AbstractPlot
+{
+
+	Q_OBJECT
+
+	const double STD_VIEW_PADDING = 0.05;
+	const double LIMIT_PADDING = 1.0;
+
+	size_t m_Bins;
+
+	QCPRange window() const;
+
+public:
+
+	HistogramPlot(QWidget* parent);
+
+	// Getters/Setters
+	size_t bins() const { return m_Bins; };
+	void setBins(size_t bins);
+	void setFollowTimeWindow(bool follow) override;
+	void setTimeWindow(const QCPRange& range) override;
+
+	// Actions
+	void plot(std::vector<const H2A::Dataset*> datasets, bool clearFirst = false) override;
+	void resetView() override;
+
+protected:
+	virtual void setAxisLabels() override;
+
+public slots:
+	void setTimeCursorEnabled(bool enable) override;
+
+};
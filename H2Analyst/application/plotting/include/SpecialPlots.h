@@ -4,6 +4,8 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <map>
+#include <tuple>
 #include "PlotDefinitions.h"
 
 const bool isSpecial(const std::vector<const H2A::Dataset*> datasets, const H2A::PlotType type, H2A::specialPlot& plot);
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "AbstractGraph.h"
+#include "Spectral.h"
+
+class SpectrumGraph : public AbstractGraph
+{
+
+	std::shared_ptr<const H2A::Spectral::Result> m_Spectrum;
+
+public:
+	SpectrumGraph(QCustomPlot* parent, const H2A::Dataset* dataset);
+
+	const std::shared_ptr<const H2A::Spectral::Result>& spectrum() const { return m_Spectrum; };
+	void setSpectrum(const std::shared_ptr<const H2A::Spectral::Result>& spectrum);
+
+	void setColor(QColor color) override;
+	QCPRange rangeX() const override;
+	QCPRange rangeY() const override;
+	bool windowStats(const QCPRange& rangeX, H2A::WindowStats& stats) const override { return false; };
+};
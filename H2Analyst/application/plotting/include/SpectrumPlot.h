@@ -0,0 +1,58 @@
+#pragma once
+
+#include "AbstractPlot.h"
+#include "SpectrumGraph.h"
+#include "Spectral.h"
+#include "SpectrumWorker.h"
+
+#include <QTimer>
+
+/**
+* Frequency domain plot, which shows the power spectral density (Welch method) of datasets over their full duration
+* or over the visible time window of the time plots. Alternatively, the spectrogram of the first dataset is shown.
+**/
+class SpectrumPlot : public AbstractPlot
+{
+
+	Q_OBJECT
+
+	const double STD_VIEW_PADDING = 0.05;
+	const double LIMIT_PADDING = 1e3; // Factor the Y axis can be zoomed out beyond the data (logarithmic axis)
+	const int UPDATE_DELAY = 100; // Delay [ms] before recomputing spectra when the time window changes
+
+	H2A::Spectral::Settings m_Settings;
+	QTimer* m_UpdateTimer;
+	QCPColorMap* m_ColorMap;
+	uint64_t m_Generation = 0; // Incremented for every computation of the spectra, so outdated results are dropped
+	bool m_ResetPending = false; // Reset the view once the spectra are computed
+
+	void updateLimits();
+	void showSpectra(const SpectrumWorker::Spectra& spectra);
+
+public:
+
+	SpectrumPlot(QWidget* parent);
+
+	// Getters/Setters
+	size_t segmentSize() const { return m_Settings.segmentSize; };
+	void setSegmentSize(size_t size);
+	bool spectrogramVisible() const { return m_Settings.spectrogram; };
+	void setSpectrogramVisible(bool visible);
+	void setFollowTimeWindow(bool follow) override;
+	void setTimeWindow(const QCPRange& range) override;
+
+	// Actions
+	void plot(std::vector<const H2A::Dataset*> datasets, bool clearFirst = false) override;
+	void resetView() override;
+
+protected:
+	virtual void setAxisLabels() override;
+
+private slots:
+	void updateSpectra();
+	void updateSpectraAndView();
+
+public slots:
+	void setTimeCursorEnabled(bool enable) override;
+
+};
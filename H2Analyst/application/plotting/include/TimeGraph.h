@@ -10,5 +10,7 @@ public:
 
 	void setColor(QColor color) override;
 	bool dataAt(double time, QPointF& point) const override;
+	void updateTime() override;
+	void reload() override;
 };
 
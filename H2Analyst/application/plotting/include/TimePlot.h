@@ -2,7 +2,9 @@
 
 #include "AbstractPlot.h"
 #include <set>
+#include <iomanip>
 #include "TimeGraph.h"
+#include "Filters.h"
 
 /**
 * Time-based plot, which extends the AbstractPlot class.
@@ -14,20 +16,44 @@ class TimePlot : public AbstractPlot
 
 	const float STD_VIEW_PADDING = 0.2f;
 	const float LIMIT_PADDING = 1.0f;
+	const float FIT_PADDING = 0.05f;
+
+	QCPItemText* m_StatsLabel;
+	bool m_StatsVisible;
+	bool m_AutoFitY;
+	H2A::Filters::Settings m_Filter;
+
+	void applyFilter(const std::vector<AbstractGraph*>& graphs);
+	void updateLimits();
 
 public:
 
 	TimePlot(QWidget* parent);
 
+	// Getters/Setters
+	bool statisticsVisible() const { return m_StatsVisible; };
+	void setStatisticsVisible(bool visible);
+	bool autoFitY() const { return m_AutoFitY; };
+	void setAutoFitY(bool enable);
+	const H2A::Filters::Settings& filter() const { return m_Filter; };
+	void setFilter(const H2A::Filters::Settings& settings);
+
 	// Actions
 	void plot(std::vector<const H2A::Dataset*> datasets, bool clearFirst = false) override;
 	void resetView() override;
+	void fitY();
+	void timeCorrected(const H2A::Datafile* datafile) override;
+	void datasetChanged(const H2A::Dataset* dataset) override;
 
 protected:
 
 	virtual void mouseDoubleClickEvent(QMouseEvent* event);
 	virtual void setAxisLabels() override;
 
+private slots:
+	void xRangeChanged(const QCPRange& range);
+	void updateStatistics();
+
 };
 
 
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "AbstractPlot.h"
+#include "DensityRaster.h"
+#include "Dialogs.h"
+
+#include <QTimer>
+#include <memory>
+
+/**
+* Plot of one dataset against another, drawn as a density raster: every pixel is colored by the number of
+* datapoints in it, or by the mean value of a third dataset. The raster is aggregated again when the view changes.
+**/
+class XYPlot : public AbstractPlot
+{
+
+	Q_OBJECT
+
+	const double LIMIT_PADDING = 1.0;
+	const double STD_VIEW_PADDING = 0.05;
+
+	std::vector<const H2A::Dataset*> m_Datasets;
+	std::unique_ptr<H2A::DensityRaster> m_Raster;
+	std::vector<double> m_Cells;
+
+	QCPColorMap* m_ColorMap;
+	QCPColorScale* m_ColorScale;
+	QTimer* m_UpdateTimer;
+
+public:
+
+	XYPlot(QWidget* parent);
+
+	// Getters/Setters
+	void setFollowTimeWindow(bool follow) override;
+	void setTimeWindow(const QCPRange& range) override;
+
+	// Properties
+	bool isEmpty() const override { return m_Raster == nullptr; };
+	QCPRange dataRangeX() const override;
+	QCPRange dataRangeY() const override;
+
+	// Actions
+	void plot(std::vector<const H2A::Dataset*> datasets, bool clearFirst = false) override;
+	void resetView() override;
+
+protected:
+	virtual void setAxisLabels() override;
+	void resizeEvent(QResizeEvent* event) override;
+
+private slots:
+	void updateRaster();
+
+public slots:
+	void clear() override;
+	void setTimeCursorEnabled(bool enable) override;
+
+};
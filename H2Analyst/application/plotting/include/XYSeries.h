@@ -15,7 +15,7 @@ class XYSeries : public Plottable
 
 public:
 
-	XYSeries(QCustomPlot* plot, const std::vector<const H2A::Dataset*> datasets);
+	XYSeries(QCustomPlot* plot, const std::vector<const H2A::Dataset*> datasets, H2A::ResampleMode mode = H2A::ResampleMode::Linear);
 	~XYSeries();
 
 	void setAxisLabels();
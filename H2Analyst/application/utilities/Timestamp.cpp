@@ -9,6 +9,19 @@ void Timestamp::set(std::vector<uint16_t> vec) {
 		boost::posix_time::milliseconds(vec[6]));
 }
 
+/**
+* Timestamp as [year, month, day, hours, minutes, seconds, milliseconds], as it is stored in the logs of the car.
+**/
+std::vector<uint16_t> Timestamp::get() const {
+	const boost::gregorian::date date = timePoint.date();
+	const boost::posix_time::time_duration time = timePoint.time_of_day();
+	return {
+		static_cast<uint16_t>(date.year()), static_cast<uint16_t>(date.month()), static_cast<uint16_t>(date.day()),
+		static_cast<uint16_t>(time.hours()), static_cast<uint16_t>(time.minutes()), static_cast<uint16_t>(time.seconds()),
+		static_cast<uint16_t>(time.total_milliseconds() % 1000)
+	};
+}
+
 std::ostream& operator<<(std::ostream& os, const Timestamp& dt) {
 	os << boost::posix_time::to_simple_string(dt.timePoint);
 	return os;
@@ -36,7 +36,7 @@ ControlPanel::ControlPanel(QWidget* parent) : QWidget(parent)
 
 	m_Layout->addWidget(m_BtLoad, 0, 0, 1, 2);
 	m_Layout->addWidget(m_BtPlotLayout, 1, 0, 1, 2);
-	//m_Layout->addWidget(m_BtExport, 2, 0, 1, 2);
+	m_Layout->addWidget(m_BtExport, 2, 0, 1, 2);
 	m_Layout->addWidget(m_TbTimeAlign, 3, 0, 1, 2);
 	m_Layout->addWidget(m_CbTimeCursor, 4, 0, 1, 2);
 	m_Layout->addWidget(m_LeTimeCursor, 5, 0, 1, 2);
@@ -24,6 +24,8 @@ m_TreeProxyModel(new QSortFilterProxyModel(this))
 	m_TreeView->setModel(m_TreeProxyModel);
 
 	m_TreeView->setSelectionModel(m_TreeSelectionModel);
+	m_TreeView->setContextMenuPolicy(Qt::CustomContextMenu);
+	connect(m_TreeView, &QWidget::customContextMenuRequested, this, &DataPanel::contextMenu);
 
 	m_Layout->addWidget(m_SearchBox);
 	m_Layout->addWidget(m_TreeView);
@@ -131,7 +133,7 @@ void DataPanel::updateData() {
 void DataPanel::requestDatasetPopulation(const H2A::Dataset* dataset, bool blocking) const {
 	if (!dataset->populated) m_DataStore->requestDatasetPopulation(dataset);	
 	if (!blocking) return;
-	while (!dataset->populated);
+	PopulatorWorker::waitPopulated(dataset);
 }
 
 /**
@@ -145,7 +147,17 @@ void DataPanel::requestDatasetPopulation(std::vector<const H2A::Dataset*> datase
 		if (!dataset->populated) this->requestDatasetPopulation(dataset, false);	
 	if (!blocking) return;
 	for (auto const& dataset : datasets)
-		while (!dataset->populated);
+		PopulatorWorker::waitPopulated(dataset);
+}
+
+/**
+* Index of the EMCYs of a datafile, of which the EMCY datasets are populated first. Blocks until the index is available.
+*
+* @param datafile Datafile to get the EMCY index of.
+**/
+std::shared_ptr<const H2A::Emcy::Index> DataPanel::getEmcyIndex(const H2A::Datafile* datafile) const {
+	this->requestDatasetPopulation(H2A::Emcy::datasets(datafile), true);
+	return m_DataStore->emcyIndex(datafile);
 }
 
 /**
@@ -249,14 +261,9 @@ QStandardItem* DataPanel::createTreeItem(const H2A::Datafile* datafile, const st
 * @param name Display name of the item.
 **/
 QStandardItem* DataPanel::createTreeItem(const H2A::Dataset* dataset, const std::string& name) {
-	auto item = this->createTreeItem(H2A::ItemType::Dataset, name);
+	auto item = this->createTreeItem(H2A::ItemType::Dataset, name, new DatasetItem(dataset, QString(name.c_str())));
 	item->setData(QVariant::fromValue(QString(dataset->name.c_str())), H2A::ItemRole::Filter);
 	item->setData(QVariant::fromValue(static_cast<const void*>(dataset)), H2A::ItemRole::DataPtr);
-	std::stringstream ttStream;
-	ttStream << "<p style = 'white-space:pre'>";
-	ttStream << "<b>UID:</b> " << dataset->uid << "\n";
-	ttStream << "</p>";
-	item->setToolTip(ttStream.str().c_str());
 	return item;
 }
 
@@ -265,9 +272,10 @@ QStandardItem* DataPanel::createTreeItem(const H2A::Dataset* dataset, const std:
 *
 * @param type Item type.
 * @param name Display name of the item.
+* @param item Item to initialize, if nullptr a new standardItem is created.
 **/
-QStandardItem* DataPanel::createTreeItem(const H2A::ItemType& type, const std::string& name) {
-	QStandardItem* item = new QStandardItem(QString(name.c_str()));
+QStandardItem* DataPanel::createTreeItem(const H2A::ItemType& type, const std::string& name, QStandardItem* item) {
+	if (item == nullptr) item = new QStandardItem(QString(name.c_str()));
 	item->setEditable(false);
 	item->setData(QVariant::fromValue(type), H2A::ItemRole::ItemType);
 	item->setData("", H2A::ItemRole::Filter);
@@ -301,6 +309,118 @@ QStandardItem* DataPanel::createTreeItem(const H2A::ItemType& type, const std::s
 }
 
 
+/**
+* Context menu of the tree view with actions on the selected datafiles.
+*
+* @param pos Position of the request, relative to the tree view.
+**/
+void DataPanel::contextMenu(const QPoint& pos) {
+	QMenu menu(this);
+	auto datafiles = this->getSelectedDatafiles();
+
+	QAction* acMerge = new QAction("Merge datafiles", &menu);
+	acMerge->setEnabled(datafiles.size() > 1);
+	connect(acMerge, &QAction::triggered, [=]() { m_DataStore->mergeDatafiles(datafiles); });
+	menu.addAction(acMerge);
+
+	auto datasets = this->getSelectedDatasets();
+	QAction* acAlignSignal = new QAction("Align on selected signal", &menu);
+	acAlignSignal->setEnabled(datasets.size() == 2 && datasets.front()->datafile != datasets.back()->datafile);
+	connect(acAlignSignal, &QAction::triggered, this, &DataPanel::alignOnSignal);
+	menu.addAction(acAlignSignal);
+
+	QAction* acAlignAnchors = new QAction("Align with anchors...", &menu);
+	acAlignAnchors->setEnabled(datafiles.size() == 1);
+	connect(acAlignAnchors, &QAction::triggered, this, &DataPanel::alignOnAnchors);
+	menu.addAction(acAlignAnchors);
+
+	menu.addSeparator();
+	QAction* acDerived = new QAction("New derived dataset...", &menu);
+	acDerived->setEnabled(!m_DataStore->getDatafiles().empty());
+	connect(acDerived, &QAction::triggered, this, &DataPanel::createDerivedDataset);
+	menu.addAction(acDerived);
+
+	menu.exec(m_TreeView->viewport()->mapToGlobal(pos));
+}
+
+/**
+* Aligns the datafiles of the two selected datasets by cross-correlating them, which runs in the background.
+* The dataset of the datafile that was loaded first is used as reference.
+**/
+void DataPanel::alignOnSignal() {
+	auto datasets = this->getSelectedDatasets();
+	if (datasets.size() != 2) return;
+
+	const auto& datafiles = m_DataStore->getDatafiles();
+	auto position = [&](const H2A::Dataset* dataset) { return std::find(datafiles.begin(), datafiles.end(), dataset->datafile) - datafiles.begin(); };
+	if (position(datasets.back()) < position(datasets.front())) std::swap(datasets.front(), datasets.back());
+
+	bool ok;
+	double maxLag = QInputDialog::getDouble(this, "Align on signal", "Maximum time difference [s]:", 10.0, 0.001, 3600.0, 3, &ok);
+	if (!ok) return;
+
+	auto failed = []() { H2A::Dialog::message("Could not align the datafiles on the selected signal."); };
+	if (!m_DataStore->alignOnSignal(datasets.front(), datasets.back(), maxLag, [=](bool success) { if (!success) failed(); }))
+		failed();
+}
+
+/**
+* Aligns the selected datafile with anchors that are entered by the user.
+**/
+void DataPanel::alignOnAnchors() {
+	auto datafiles = this->getSelectedDatafiles();
+	if (datafiles.size() != 1) return;
+
+	bool ok;
+	QString input = QInputDialog::getText(this, "Align with anchors", "Anchors as 'current time = correct time', separated by ';':", QLineEdit::Normal, "", &ok);
+	if (!ok) return;
+
+	std::vector<std::pair<double, double>> anchors;
+	for (const auto& anchor : input.split(";", Qt::SkipEmptyParts)) {
+		QStringList times = anchor.split("=");
+		bool okCurrent = false, okCorrect = false;
+		if (times.size() == 2) anchors.push_back({ times[0].trimmed().toDouble(&okCurrent), times[1].trimmed().toDouble(&okCorrect) });
+		if (!okCurrent || !okCorrect) {
+			H2A::Dialog::message("Invalid anchor: " + anchor);
+			return;
+		}
+	}
+
+	if (!m_DataStore->alignOnAnchors(datafiles.front(), anchors))
+		H2A::Dialog::message("Could not align the datafile with the given anchors.");
+}
+
+/**
+* Creates a dataset that is computed with a formula from other datasets. The selected datasets are filled in
+* the formula to start with.
+**/
+void DataPanel::createDerivedDataset() {
+	bool ok;
+	QString name = QInputDialog::getText(this, "New derived dataset", "Name (optionally followed by unit in brackets, e.g. 'Stack power [W]'):", QLineEdit::Normal, "", &ok).trimmed();
+	if (!ok || name.isEmpty()) return;
+
+	QString unit = "-";
+	QRegularExpressionMatch match = QRegularExpression("^(.*?)\\s*\\[(.*)\\]$").match(name);
+	if (match.hasMatch()) {
+		name = match.captured(1);
+		unit = match.captured(2);
+	}
+
+	QStringList inputs;
+	for (const auto& dataset : this->getSelectedDatasets())
+		inputs.append("[" + QString(dataset->name.c_str()) + "]");
+
+	QString formula = QInputDialog::getMultiLineText(this, "New derived dataset",
+		"Formula, with datasets in brackets. Supported: + - * / ^, comparisons, && || !, t (time),\n"
+		"abs, sqrt, exp, log, sin, cos, min(a, b), max(a, b), if(c, a, b), der(x), int(x),\n"
+		"movmean(x, s), movmin(x, s), movmax(x, s) with a window of s seconds.", inputs.join(" * "), &ok);
+	if (!ok || formula.trimmed().isEmpty()) return;
+
+	std::string error;
+	if (!m_DataStore->createDerivedDataset(name.toStdString(), unit.toStdString(), formula.toStdString(), error))
+		H2A::Dialog::message("Invalid formula: " + QString(error.c_str()));
+}
+
 /**
 * Applies the filter from the input box.
 **/
@@ -336,3 +456,30 @@ int DataPanel::countRows(const QModelIndex& index) {
 	return count;
 }
 
+
+/**
+* Returns the data of the item, with a tooltip containing the UID and (once populated) the statistics of the dataset.
+*
+* @param role Role of the data.
+**/
+QVariant DatasetItem::data(int role) const {
+	if (role != Qt::ToolTipRole) return QStandardItem::data(role);
+
+	const H2A::DatasetStats& stats = m_Dataset->stats;
+	std::stringstream ttStream;
+	ttStream << "<p style = 'white-space:pre'>";
+	ttStream << "<b>UID:</b> " << m_Dataset->uid;
+	if (m_Dataset->populated) {
+		ttStream << "\n<b>Datapoints:</b> " << stats.count;
+		if (stats.hasRange()) {
+			ttStream << "\n<b>Range:</b> " << stats.min << " to " << stats.max << " " << m_Dataset->unit;
+			ttStream << "\n<b>Mean:</b> " << stats.mean << " (std " << stats.stddev << ")";
+		}
+		else ttStream << "\n<b>Range:</b> no finite values";
+		ttStream << "\n<b>Time:</b> " << m_Dataset->datafile->correctTime(stats.firstTime) << " to " << m_Dataset->datafile->correctTime(stats.lastTime) << " s";
+		ttStream << "\n<b>Sampling:</b> " << H2A::samplingFreq(m_Dataset) << " Hz (median interval " << stats.medianInterval * 1000.0 << " ms)";
+		ttStream << "\n<b>Gaps:</b> " << stats.gaps;
+	}
+	ttStream << "</p>";
+	return QString(ttStream.str().c_str());
+}
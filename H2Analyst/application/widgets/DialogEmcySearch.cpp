@@ -0,0 +1,112 @@
+#include "DialogEmcySearch.h"
+
+/**
+* Dialog that is used to search for EMCYs in all loaded logs.
+*
+* @param dataPanel Data panel that gives access to the loaded datafiles.
+* @param definitions Descriptions of the EMCY codes.
+* @param codes Codes to search for initially, as comma separated hexadecimal values.
+* @param parent Parent of this dialog.
+**/
+DialogEmcySearch::DialogEmcySearch(const DataPanel* dataPanel, const H2A::Emcy::Definitions* definitions, const QString& codes, QWidget* parent) : QDialog(parent, Qt::WindowCloseButtonHint),
+m_DataPanel(dataPanel),
+m_Definitions(definitions)
+{
+	this->setWindowTitle("Search EMCYs in all logs");
+
+	QGridLayout* layout = new QGridLayout(this);
+
+	m_Codes = new QLineEdit(codes, this);
+	m_Codes->setPlaceholderText("Comma separated hexadecimal codes");
+	m_Codes->setValidator(new QRegularExpressionValidator(QRegularExpression("[0-9A-Fa-f,\\s]*"), this));
+	layout->addWidget(new QLabel("Codes", this), 0, 0);
+	layout->addWidget(m_Codes, 0, 1, 1, 2);
+
+	m_Severity = new QComboBox(this);
+	m_Severity->addItem("All severities");
+	for (int severity = H2A::Emcy::Event; severity <= H2A::Emcy::Unknown; ++severity)
+		m_Severity->addItem(QString::fromStdString(H2A::Emcy::getSeverityStr(static_cast<H2A::Emcy::Severity>(severity)) + " or higher"));
+	layout->addWidget(new QLabel("Severity", this), 1, 0);
+	layout->addWidget(m_Severity, 1, 1, 1, 2);
+
+	QPushButton* btSearch = new QPushButton("Search", this);
+	btSearch->setDefault(true);
+	connect(btSearch, &QPushButton::clicked, this, &DialogEmcySearch::search);
+	layout->addWidget(btSearch, 2, 2);
+
+	m_Results = new QTreeWidget(this);
+	m_Results->setHeaderLabels({ "Log / time", "Severity", "Description" });
+	m_Results->setMinimumWidth(600);
+	connect(m_Results, &QTreeWidget::itemActivated, [=](QTreeWidgetItem* item) {
+		const QVariant time = item->data(0, Qt::UserRole);
+		if (time.isValid()) emit this->timeSelected(time.toDouble());
+	});
+	layout->addWidget(m_Results, 3, 0, 1, 3);
+
+	m_Status = new QLabel(this);
+	layout->addWidget(m_Status, 4, 0, 1, 3);
+
+	this->setLayout(layout);
+}
+
+/**
+* Codes in a text of comma or space separated hexadecimal values. Values that are not a valid code are skipped.
+*
+* @param text Text to parse.
+**/
+std::vector<uint16_t> DialogEmcySearch::parseCodes(const QString& text) {
+	std::vector<uint16_t> codes;
+	for (const auto& value : text.split(QRegularExpression("[,\\s]+"), Qt::SkipEmptyParts)) {
+		bool ok;
+		const uint16_t code = value.toUShort(&ok, 16);
+		if (ok) codes.push_back(code);
+	}
+	return codes;
+}
+
+/**
+* Search the EMCY index of every loaded datafile and list the found EMCYs per datafile.
+**/
+void DialogEmcySearch::search() {
+	H2A::Emcy::Filter filter;
+	filter.codes = parseCodes(m_Codes->text());
+	filter.minSeverity = static_cast<H2A::Emcy::Severity>(m_Severity->currentIndex());
+
+	auto start = std::chrono::steady_clock::now();
+	m_Results->clear();
+	size_t total = 0;
+	size_t logs = 0;
+	for (const auto& datafile : m_DataPanel->getDatafiles()) {
+		const auto index = m_DataPanel->getEmcyIndex(datafile);
+		if (!index || index->emcies().empty()) continue;
+		const auto positions = index->filter(filter);
+		if (positions.empty()) continue;
+		total += positions.size();
+		++logs;
+
+		std::stringstream ss;
+		ss << datafile->name << " (" << datafile->startTime << "): " << positions.size() << " EMCYs";
+		QTreeWidgetItem* item = new QTreeWidgetItem(m_Results, { QString::fromStdString(ss.str()) });
+		item->setFirstColumnSpanned(true);
+
+		for (size_t i = 0; i < positions.size() && i < MAX_LISTED; ++i) {
+			const H2A::Emcy::Record& emcy = index->emcies()[positions[i]];
+			const H2A::Emcy::Properties* properties = m_Definitions->find(emcy.code);
+			std::stringstream code;
+			code << std::hex << std::uppercase << std::setw(4) << std::setfill('0') << emcy.code << " ";
+
+			QTreeWidgetItem* child = new QTreeWidgetItem(item, {
+				QString::number(emcy.time, 'f', 3),
+				QString::fromStdString(H2A::Emcy::getSeverityStr(emcy.severity)),
+				QString::fromStdString(code.str() + (properties ? std::string(properties->text) : "unknown")) });
+			child->setToolTip(0, QString::fromStdString("Source: " + index->sources()[emcy.source]));
+			child->setData(0, Qt::UserRole, emcy.time);
+		}
+	}
+	auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+	std::stringstream ss;
+	ss << total << " EMCYs found in " << logs << " logs in " << duration.count() << " ms";
+	if (total > 0) ss << " (at most " << MAX_LISTED << " listed per log)";
+	m_Status->setText(QString(ss.str().c_str()));
+}
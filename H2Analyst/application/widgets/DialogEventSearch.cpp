@@ -0,0 +1,141 @@
+#include "DialogEventSearch.h"
+
+/**
+* Dialog that is used to search for events in datasets.
+*
+* @param datasets Datasets to search in.
+* @param parent Parent of this dialog.
+**/
+DialogEventSearch::DialogEventSearch(const std::vector<const H2A::Dataset*>& datasets, QWidget* parent) : QDialog(parent, Qt::WindowCloseButtonHint),
+m_Datasets(datasets),
+m_CurrentTime(0.0)
+{
+	this->setWindowTitle("Search events");
+
+	QGridLayout* layout = new QGridLayout(this);
+
+	std::stringstream ss;
+	if (m_Datasets.size() == 1) ss << "Search in " << m_Datasets.front()->name;
+	else ss << "Search in " << m_Datasets.size() << " datasets";
+	layout->addWidget(new QLabel(QString(ss.str().c_str()), this), 0, 0, 1, 4);
+
+	m_Condition = new QComboBox(this);
+	m_Condition->addItems({ "Above threshold", "Below threshold", "In range", "Out of range", "In set", "Rising edge", "Falling edge", "Value change" });
+	layout->addWidget(new QLabel("Condition", this), 1, 0);
+	layout->addWidget(m_Condition, 1, 1, 1, 3);
+
+	m_Lower = new QLineEdit("0", this);
+	m_Lower->setValidator(new QDoubleValidator(this));
+	m_Upper = new QLineEdit("1", this);
+	m_Upper->setValidator(new QDoubleValidator(this));
+	layout->addWidget(new QLabel("Threshold / lower", this), 2, 0);
+	layout->addWidget(m_Lower, 2, 1);
+	layout->addWidget(new QLabel("Upper", this), 2, 2);
+	layout->addWidget(m_Upper, 2, 3);
+
+	m_Values = new QLineEdit(this);
+	m_Values->setPlaceholderText("Comma separated values");
+	layout->addWidget(new QLabel("Values", this), 3, 0);
+	layout->addWidget(m_Values, 3, 1, 1, 3);
+
+	QPushButton* btSearch = new QPushButton("Search", this);
+	btSearch->setDefault(true);
+	connect(btSearch, &QPushButton::clicked, this, &DialogEventSearch::search);
+	layout->addWidget(btSearch, 4, 3);
+
+	m_List = new QListWidget(this);
+	m_List->setMinimumWidth(400);
+	connect(m_List, &QListWidget::itemActivated, [=]() { this->select(m_List->currentRow()); });
+	layout->addWidget(m_List, 5, 0, 1, 4);
+
+	m_Status = new QLabel(this);
+	layout->addWidget(m_Status, 6, 0, 1, 2);
+
+	QPushButton* btPrevious = new QPushButton("Previous", this);
+	connect(btPrevious, &QPushButton::clicked, this, &DialogEventSearch::previous);
+	layout->addWidget(btPrevious, 6, 2);
+	QPushButton* btNext = new QPushButton("Next", this);
+	connect(btNext, &QPushButton::clicked, this, &DialogEventSearch::next);
+	layout->addWidget(btNext, 6, 3);
+
+	this->setLayout(layout);
+
+	connect(m_Condition, SIGNAL(currentIndexChanged(int)), this, SLOT(conditionChanged(int)));
+	this->conditionChanged(m_Condition->currentIndex());
+}
+
+/**
+* Slot that is called when another condition is selected. Enables the inputs that the condition uses.
+*
+* @param index Index of the selected condition.
+**/
+void DialogEventSearch::conditionChanged(int index) {
+	const H2A::EventCondition type = static_cast<H2A::EventCondition>(index);
+	const bool range = type == H2A::EventCondition::InRange || type == H2A::EventCondition::OutOfRange;
+	m_Lower->setEnabled(type != H2A::EventCondition::InSet && type != H2A::EventCondition::Change);
+	m_Upper->setEnabled(range);
+	m_Values->setEnabled(type == H2A::EventCondition::InSet);
+}
+
+/**
+* Search the datasets for the selected condition and list the found events.
+**/
+void DialogEventSearch::search() {
+	H2A::Events::Condition condition;
+	condition.type = static_cast<H2A::EventCondition>(m_Condition->currentIndex());
+	condition.lower = m_Lower->locale().toDouble(m_Lower->text());
+	condition.upper = m_Upper->locale().toDouble(m_Upper->text());
+	for (const auto& value : m_Values->text().split(',', Qt::SkipEmptyParts)) {
+		bool ok;
+		const double v = value.trimmed().toDouble(&ok);
+		if (ok) condition.values.push_back(v);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	H2A::Events::search(m_Datasets, condition, m_Events);
+	auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+	m_List->clear();
+	for (size_t i = 0; i < m_Events.size() && i < MAX_LISTED; ++i) {
+		const auto& event = m_Events[i];
+		std::stringstream ss;
+		ss << std::fixed << std::setprecision(3) << event.tStart;
+		if (event.tEnd > event.tStart) ss << " - " << event.tEnd << " (" << event.tEnd - event.tStart << " s)";
+		ss << "  " << event.dataset->name;
+		m_List->addItem(QString(ss.str().c_str()));
+	}
+
+	std::stringstream ss;
+	ss << m_Events.size() << " events found in " << duration.count() << " ms";
+	if (m_Events.size() > MAX_LISTED) ss << " (first " << MAX_LISTED << " listed)";
+	m_Status->setText(QString(ss.str().c_str()));
+}
+
+/**
+* Move the time cursor to the start of the given event.
+*
+* @param index Index of the event.
+**/
+void DialogEventSearch::select(size_t index) {
+	if (index >= m_Events.size()) return;
+	m_CurrentTime = m_Events[index].tStart;
+	if (index < static_cast<size_t>(m_List->count())) m_List->setCurrentRow(static_cast<int>(index));
+	else m_List->clearSelection();
+	emit this->timeSelected(m_CurrentTime);
+}
+
+/**
+* Move the time cursor to the last event before the current time.
+**/
+void DialogEventSearch::previous() {
+	auto it = std::lower_bound(m_Events.begin(), m_Events.end(), m_CurrentTime, [](const H2A::Events::Interval& event, double time) { return event.tStart < time; });
+	if (it != m_Events.begin()) this->select(std::distance(m_Events.begin(), it) - 1);
+}
+
+/**
+* Move the time cursor to the first event after the current time.
+**/
+void DialogEventSearch::next() {
+	auto it = std::upper_bound(m_Events.begin(), m_Events.end(), m_CurrentTime, [](double time, const H2A::Events::Interval& event) { return time < event.tStart; });
+	if (it != m_Events.end()) this->select(std::distance(m_Events.begin(), it));
+}
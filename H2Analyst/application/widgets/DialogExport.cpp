@@ -0,0 +1,177 @@
+#include "DialogExport.h"
+
+/**
+* Dialog that is used to set up an export.
+*
+* @param settings Settings of the previous export, which are shown initially.
+* @param parent Parent of this dialog.
+**/
+DialogExport::DialogExport(const H2A::Export::Settings& settings, QWidget* parent) : QDialog(parent, Qt::WindowCloseButtonHint),
+m_VisibleStart(0.0),
+m_VisibleEnd(0.0),
+m_CursorTime(0.0)
+{
+	this->setModal(true);
+	this->setWindowTitle("Export datasets");
+
+	QGridLayout* layout = new QGridLayout(this);
+
+	m_Format = new QComboBox(this);
+	m_Format->addItems({ "CSV", "Arrow/Feather", "MAT-file (struct per dataset)", "MAT-file (car log, can be opened again)" });
+	m_Format->setCurrentIndex(static_cast<int>(settings.format));
+	layout->addWidget(new QLabel("Format", this), 0, 0);
+	layout->addWidget(m_Format, 0, 1, 1, 2);
+
+	m_Layout = new QComboBox(this);
+	m_Layout->addItems({ "Resampled", "Event table (native timestamps)", "Long format (time, signal, value)", "Per signal (time, signal, value, one signal after the other)" });
+	m_Layout->setCurrentIndex(static_cast<int>(settings.layout));
+	layout->addWidget(new QLabel("Layout", this), 1, 0);
+	layout->addWidget(m_Layout, 1, 1, 1, 2);
+
+	m_Freq = new QDoubleSpinBox(this);
+	m_Freq->setRange(0.001, 1e6);
+	m_Freq->setDecimals(3);
+	m_Freq->setSuffix(" Hz");
+	m_Freq->setValue(settings.resamplingFreq);
+	layout->addWidget(new QLabel("Resampling frequency", this), 2, 0);
+	layout->addWidget(m_Freq, 2, 1, 1, 2);
+
+	m_Mode = new QComboBox(this);
+	m_Mode->addItems({ "Zero-order hold", "Nearest", "Linear", "Average" });
+	m_Mode->setCurrentIndex(static_cast<int>(settings.mode));
+	layout->addWidget(new QLabel("Resampling method", this), 3, 0);
+	layout->addWidget(m_Mode, 3, 1, 1, 2);
+
+	// The minimum stands for the shortest representation that reads back to the same value
+	m_Precision = new QSpinBox(this);
+	m_Precision->setRange(0, H2A::Export::MAX_PRECISION);
+	m_Precision->setSpecialValueText("Shortest round-trip");
+	m_Precision->setSuffix(" significant digits");
+	m_Precision->setValue(std::clamp(settings.precision, 0, H2A::Export::MAX_PRECISION));
+	layout->addWidget(new QLabel("Precision", this), 4, 0);
+	layout->addWidget(m_Precision, 4, 1, 1, 2);
+
+	m_Range = new QComboBox(this);
+	m_Range->addItems({ "Full", "Visible range", "Around time cursor", "Custom" });
+	layout->addWidget(new QLabel("Time range", this), 5, 0);
+	layout->addWidget(m_Range, 5, 1, 1, 2);
+
+	m_Margin = new QDoubleSpinBox(this);
+	m_Margin->setRange(0.001, 1e6);
+	m_Margin->setDecimals(3);
+	m_Margin->setPrefix("± ");
+	m_Margin->setSuffix(" s");
+	m_Margin->setValue(10.0);
+	layout->addWidget(new QLabel("Window around cursor", this), 6, 0);
+	layout->addWidget(m_Margin, 6, 1, 1, 2);
+
+	m_Start = this->createTimeBox(std::isfinite(settings.tStart) ? settings.tStart : 0.0);
+	m_End = this->createTimeBox(std::isfinite(settings.tEnd) ? settings.tEnd : 0.0);
+	layout->addWidget(new QLabel("From/to", this), 7, 0);
+	layout->addWidget(m_Start, 7, 1);
+	layout->addWidget(m_End, 7, 2);
+
+	m_Compress = new QCheckBox("Compress", this);
+	m_Compress->setChecked(settings.compress);
+	layout->addWidget(m_Compress, 8, 1, 1, 2);
+
+	QPushButton* cancel = new QPushButton("Cancel", this);
+	connect(cancel, &QPushButton::clicked, this, &QDialog::reject);
+	layout->addWidget(cancel, 9, 1);
+	QPushButton* ok = new QPushButton("Export...", this);
+	ok->setDefault(true);
+	connect(ok, &QPushButton::clicked, this, &QDialog::accept);
+	layout->addWidget(ok, 9, 2);
+
+	this->setLayout(layout);
+
+	// The visible range and time cursor are only available once they are set
+	m_Range->setItemData(Range::Visible, false, Qt::UserRole - 1);
+	m_Range->setItemData(Range::Cursor, false, Qt::UserRole - 1);
+	m_Range->setCurrentIndex(std::isfinite(settings.tStart) || std::isfinite(settings.tEnd) ? Range::Custom : Range::Full);
+
+	connect(m_Format, SIGNAL(currentIndexChanged(int)), this, SLOT(updateFields()));
+	connect(m_Layout, SIGNAL(currentIndexChanged(int)), this, SLOT(updateFields()));
+	connect(m_Range, SIGNAL(currentIndexChanged(int)), this, SLOT(updateFields()));
+	connect(m_Margin, SIGNAL(valueChanged(double)), this, SLOT(updateFields()));
+	this->updateFields();
+}
+
+QDoubleSpinBox* DialogExport::createTimeBox(double value) {
+	QDoubleSpinBox* box = new QDoubleSpinBox(this);
+	box->setRange(-1e9, 1e9);
+	box->setDecimals(3);
+	box->setSuffix(" s");
+	box->setValue(value);
+	return box;
+}
+
+/**
+* Make the visible time range of a plot available as time range.
+*
+* @param start Start of the visible range.
+* @param end End of the visible range.
+* @param select Select the visible range as time range.
+**/
+void DialogExport::setVisibleRange(double start, double end, bool select) {
+	m_VisibleStart = start;
+	m_VisibleEnd = end;
+	m_Range->setItemData(Range::Visible, QVariant(), Qt::UserRole - 1);
+	if (select) m_Range->setCurrentIndex(Range::Visible);
+}
+
+/**
+* Make a window around the time cursor available as time range.
+*
+* @param time Time of the time cursor.
+**/
+void DialogExport::setCursorTime(double time) {
+	m_CursorTime = time;
+	m_Range->setItemData(Range::Cursor, QVariant(), Qt::UserRole - 1);
+}
+
+/**
+* Slot that is called when the format, layout or time range changes. Enables the fields that apply and fills in the time range.
+* MAT-files are written at the native timestamps, only CSV files are formatted with a precision, and only MAT-files can be compressed.
+**/
+void DialogExport::updateFields() {
+	const H2A::ExportFormat format = static_cast<H2A::ExportFormat>(m_Format->currentIndex());
+	const bool table = format == H2A::ExportFormat::CSV || format == H2A::ExportFormat::Arrow;
+	const bool resampled = table && m_Layout->currentIndex() == static_cast<int>(H2A::ExportLayout::Resampled);
+	m_Layout->setEnabled(table);
+	m_Freq->setEnabled(resampled);
+	m_Mode->setEnabled(resampled);
+	m_Precision->setEnabled(format == H2A::ExportFormat::CSV);
+	m_Compress->setEnabled(!table);
+
+	const Range range = static_cast<Range>(m_Range->currentIndex());
+	m_Margin->setEnabled(range == Range::Cursor);
+	m_Start->setEnabled(range == Range::Custom);
+	m_End->setEnabled(range == Range::Custom);
+	if (range == Range::Visible) {
+		m_Start->setValue(m_VisibleStart);
+		m_End->setValue(m_VisibleEnd);
+	}
+	else if (range == Range::Cursor) {
+		m_Start->setValue(m_CursorTime - m_Margin->value());
+		m_End->setValue(m_CursorTime + m_Margin->value());
+	}
+}
+
+/**
+* Settings of the export as set in the dialog.
+**/
+H2A::Export::Settings DialogExport::settings() const {
+	H2A::Export::Settings settings;
+	settings.format = static_cast<H2A::ExportFormat>(m_Format->currentIndex());
+	settings.compress = m_Compress->isChecked();
+	settings.layout = static_cast<H2A::ExportLayout>(m_Layout->currentIndex());
+	settings.resamplingFreq = m_Freq->value();
+	settings.mode = static_cast<H2A::ResampleMode>(m_Mode->currentIndex());
+	settings.precision = m_Precision->value() == m_Precision->minimum() ? -1 : m_Precision->value();
+	if (m_Range->currentIndex() != Range::Full) {
+		settings.tStart = std::min(m_Start->value(), m_End->value());
+		settings.tEnd = std::max(m_Start->value(), m_End->value());
+	}
+	return settings;
+}
@@ -0,0 +1,112 @@
+#include "DialogFilter.h"
+
+/**
+* Dialog that is used to select the filter of a plot.
+*
+* @param settings Current filter of the plot.
+* @param parent Parent of this dialog.
+**/
+DialogFilter::DialogFilter(const H2A::Filters::Settings& settings, QWidget* parent) : QDialog(parent, Qt::WindowCloseButtonHint),
+m_Settings(settings)
+{
+	this->setModal(true);
+	this->setWindowTitle("Filter");
+
+	QGridLayout* layout = new QGridLayout(this);
+
+	m_Type = new QComboBox(this);
+	m_Type->addItems({ "None", "Moving average", "Exponential smoothing", "Low-pass (Butterworth)", "High-pass (Butterworth)", "Median" });
+	layout->addWidget(new QLabel("Type", this), 0, 0);
+	layout->addWidget(m_Type, 0, 1, 1, 2);
+
+	m_Slider = new QSlider(Qt::Horizontal, this);
+	m_Slider->setRange(0, SLIDER_STEPS);
+	m_Slider->setMinimumWidth(250);
+	m_Value = new QLabel(this);
+	m_Value->setMinimumWidth(80);
+	layout->addWidget(new QLabel("Parameter", this), 1, 0);
+	layout->addWidget(m_Slider, 1, 1);
+	layout->addWidget(m_Value, 1, 2);
+
+	QPushButton* close = new QPushButton("Close", this);
+	connect(close, &QPushButton::clicked, this, &QDialog::accept);
+	layout->addWidget(close, 2, 2);
+
+	this->setLayout(layout);
+
+	// Put slider at current parameter before connecting, so the plot is not updated on opening the dialog
+	m_Type->setCurrentIndex(static_cast<int>(m_Settings.type));
+	double lower, upper;
+	this->parameterRange(lower, upper);
+	const double ratio = std::log(std::clamp(m_Settings.parameter, lower, upper) / lower) / std::log(upper / lower);
+	m_Slider->setValue(static_cast<int>(std::round(ratio * SLIDER_STEPS)));
+	this->sliderMoved(m_Slider->value());
+	m_Slider->setEnabled(m_Settings.type != H2A::FilterType::None);
+
+	connect(m_Type, SIGNAL(currentIndexChanged(int)), this, SLOT(typeChanged(int)));
+	connect(m_Slider, SIGNAL(valueChanged(int)), this, SLOT(sliderMoved(int)));
+}
+
+/**
+* Range of the filter parameter of the selected filter type, which is spread logarithmically over the slider.
+*
+* @param lower Variable to store the lower bound in.
+* @param upper Variable to store the upper bound in.
+**/
+void DialogFilter::parameterRange(double& lower, double& upper) const {
+	switch (static_cast<H2A::FilterType>(m_Type->currentIndex())) {
+	case H2A::FilterType::LowPass:
+	case H2A::FilterType::HighPass:
+		lower = 0.01;
+		upper = 500.0;
+		break;
+	case H2A::FilterType::Median:
+		lower = 0.001;
+		upper = 1.0;
+		break;
+	default:
+		lower = 0.001;
+		upper = 10.0;
+		break;
+	}
+}
+
+/**
+* Slot that is called when another filter type is selected.
+*
+* @param index Index of the selected filter type.
+**/
+void DialogFilter::typeChanged(int index) {
+	m_Slider->setEnabled(index != static_cast<int>(H2A::FilterType::None));
+	this->sliderMoved(m_Slider->value());
+}
+
+/**
+* Slot that is called when the slider is moved. Updates the parameter and emits the filter.
+*
+* @param position New position of the slider.
+**/
+void DialogFilter::sliderMoved(int position) {
+	double lower, upper;
+	this->parameterRange(lower, upper);
+
+	m_Settings.type = static_cast<H2A::FilterType>(m_Type->currentIndex());
+	m_Settings.parameter = lower * std::pow(upper / lower, static_cast<double>(position) / SLIDER_STEPS);
+
+	QString text;
+	switch (m_Settings.type) {
+	case H2A::FilterType::None:
+		text = "";
+		break;
+	case H2A::FilterType::LowPass:
+	case H2A::FilterType::HighPass:
+		text = QString::number(m_Settings.parameter, 'g', 3) + " Hz";
+		break;
+	default:
+		text = QString::number(m_Settings.parameter, 'g', 3) + " s";
+		break;
+	}
+	m_Value->setText(text);
+
+	emit this->filterChanged(m_Settings);
+}
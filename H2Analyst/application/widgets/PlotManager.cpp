@@ -22,11 +22,21 @@ AbstractPlot* PlotManager::createPlot(H2A::PlotType type) {
 		plot = new TimePlot(this);
 		break;
 	case H2A::XY:
+		plot = new XYPlot(this);
 		break;
 	case H2A::EmcyList:
 		plot = new EmcyPlot(m_DataPanel, m_SelectedCar, this);
 		connect(this, SIGNAL(selectedCarChanged(H2A::Car)), plot, SLOT(setSelectedCar(H2A::Car)));
 		break;
+	case H2A::Spectrum:
+		plot = new SpectrumPlot(this);
+		break;
+	case H2A::Histogram:
+		plot = new HistogramPlot(this);
+		break;
+	case H2A::Heatmap:
+		plot = new HeatmapPlot(this);
+		break;
 	default:
 		break;
 	}
@@ -78,8 +88,8 @@ void PlotManager::alignTimeAxis(AbstractPlot* ref) {
 	
 	if (!m_TimeAlignEnabled) return;
 
-	// Avoid aligning time axis when a plot is cleared
-	if (ref != nullptr) { if (ref->isEmpty()) return; }
+	// Avoid aligning time axis when a plot is cleared, or when the X axis of the plot is not a time axis
+	if (ref != nullptr) { if (ref->isEmpty() || ref->type() != H2A::Time) return; }
 
 	if (!m_BusyAligning) {
 		// Setting ranges of other plots causes this slots to be called recursively.
@@ -101,7 +111,8 @@ void PlotManager::alignTimeAxis(AbstractPlot* ref) {
 
 		// Set plots to match the reference.
 		for (const auto& plot : plots) {
-			if (!plot->type() == H2A::Time || plot == ref) continue;
+			if (plot->type() != H2A::Time) plot->setTimeWindow(ref->xAxis->range());
+			if (plot->type() != H2A::Time || plot == ref) continue;
 			plot->xAxis->setRange(ref->xAxis->range());
 			//plot->zoomYToData();
 			plot->replot();
@@ -139,6 +150,21 @@ bool PlotManager::allPlotsEmpty() {
 	return true;
 }
 
+/**
+* Function that gives the visible time range of the first time plot that is not empty.
+*
+* @param range Object to store the visible range in.
+**/
+bool PlotManager::visibleTimeRange(QCPRange& range) {
+	for (const auto& plot : this->plots()) {
+		if (plot->type() == H2A::Time && !plot->isEmpty()) {
+			range = plot->xAxis->range();
+			return true;
+		}
+	}
+	return false;
+}
+
 /**
 * Function to set the time of the time cursors of the plots in this manager.
 *
@@ -150,6 +176,44 @@ void PlotManager::setTimeCursorTime(double time) {
 	emit this->timeCursorMoved(m_TimeCursorTime);
 }
 
+/**
+* Place the time cursor at the given time and move the time plots that do not show that time to it.
+*
+* @param time Time to show.
+**/
+void PlotManager::showTime(double time) {
+	this->setTimeCursorEnabled(true);
+	this->setTimeCursorTime(time);
+	for (const auto& plot : this->plots()) {
+		if (plot->type() != H2A::Time || plot->isEmpty() || plot->xAxis->range().contains(time)) continue;
+		const double size = plot->xAxis->range().size();
+		plot->xAxis->setRange(time - 0.5 * size, time + 0.5 * size);
+		plot->replot();
+	}
+}
+
+/**
+* Open the event search dialog for the selected datasets, or the datasets in the given plot if none are selected.
+*
+* @param source Plot the search was started from.
+**/
+void PlotManager::searchEvents(AbstractPlot* source) {
+	auto datasets = m_DataPanel->getSelectedDatasets();
+	if (datasets.empty() && source != nullptr) datasets = source->datasets();
+	if (datasets.empty()) {
+		H2A::Dialog::message("Select datasets to search in.");
+		return;
+	}
+	m_DataPanel->requestDatasetPopulation(datasets, true);
+
+	DialogEventSearch* dialog = new DialogEventSearch(datasets, this);
+	dialog->setAttribute(Qt::WA_DeleteOnClose);
+	dialog->setCurrentTime(m_TimeCursorTime);
+	connect(dialog, &DialogEventSearch::timeSelected, this, &PlotManager::showTime);
+	connect(this, &PlotManager::timeCursorMoved, dialog, &DialogEventSearch::setCurrentTime);
+	dialog->show();
+}
+
 /**
 * Function to enable or disable the time cursors in the plots of this manager.
 *
@@ -250,8 +314,9 @@ void PlotManager::contextMenu(AbstractPlot* source, const QPoint& pos) {
 	QMenu* plotMenu = menu.addMenu(QIcon(QPixmap(":/icons/more-information")), "Other plots");
 
 	QAction* acPlotXY = new QAction("XY");
-	acPlotXY->setEnabled(false);
-	// connect action
+	enabled = m_DataPanel->getSelectedDatasets().size() == 2 || m_DataPanel->getSelectedDatasets().size() == 3;
+	acPlotXY->setEnabled(enabled);
+	connect(acPlotXY, &QAction::triggered, [=]() {this->plotSelected(source, H2A::XY); });
 	plotMenu->addAction(acPlotXY);
 
 	QAction* acPlotEmcy = new QAction("Emcy");
@@ -260,6 +325,26 @@ void PlotManager::contextMenu(AbstractPlot* source, const QPoint& pos) {
 	connect(acPlotEmcy, &QAction::triggered, [=]() {this->replacePlot(source, H2A::EmcyList); });
 	plotMenu->addAction(acPlotEmcy);
 
+	QAction* acPlotSpectrum = new QAction("Spectrum");
+	acPlotSpectrum->setEnabled(m_DataPanel->getSelectedDatasets().size() > 0);
+	connect(acPlotSpectrum, &QAction::triggered, [=]() {this->plotSelected(source, H2A::Spectrum); });
+	plotMenu->addAction(acPlotSpectrum);
+
+	QAction* acPlotHistogram = new QAction("Histogram");
+	acPlotHistogram->setEnabled(m_DataPanel->getSelectedDatasets().size() > 0);
+	connect(acPlotHistogram, &QAction::triggered, [=]() {this->plotSelected(source, H2A::Histogram); });
+	plotMenu->addAction(acPlotHistogram);
+
+	QAction* acPlotHeatmap = new QAction("Heatmap (2D histogram)");
+	acPlotHeatmap->setEnabled(m_DataPanel->getSelectedDatasets().size() == 2);
+	connect(acPlotHeatmap, &QAction::triggered, [=]() {this->plotSelected(source, H2A::Heatmap); });
+	plotMenu->addAction(acPlotHeatmap);
+
+	QAction* acSearch = new QAction(QString("Search events..."));
+	acSearch->setEnabled(m_DataPanel->getSelectedDatasets().size() > 0 || (!source->isEmpty() && source->type() != H2A::EmcyList));
+	connect(acSearch, &QAction::triggered, [=]() {this->searchEvents(source); });
+	menu.addAction(acSearch);
+
 	QAction* acResetView = new QAction(QIcon(QPixmap(":/icons/uno")), QString("Reset view"));
 	acResetView->setEnabled(!source->isEmpty() && source->type() != H2A::EmcyList);
 	connect(acResetView, &QAction::triggered, [=]() {source->resetView(); });
@@ -269,6 +354,86 @@ void PlotManager::contextMenu(AbstractPlot* source, const QPoint& pos) {
 	connect(acResetAllViews, &QAction::triggered, [=]() {this->resetAllViews(); });
 	menu.addAction(acResetAllViews);
 
+	if (source->type() == H2A::Time) {
+		TimePlot* timePlot = static_cast<TimePlot*>(source);
+
+		QAction* acStatistics = new QAction(QString("Show statistics"));
+		acStatistics->setCheckable(true);
+		acStatistics->setChecked(timePlot->statisticsVisible());
+		connect(acStatistics, &QAction::toggled, [=](bool checked) {timePlot->setStatisticsVisible(checked); });
+		menu.addAction(acStatistics);
+
+		QAction* acAutoFit = new QAction(QString("Auto-fit Y axis"));
+		acAutoFit->setCheckable(true);
+		acAutoFit->setChecked(timePlot->autoFitY());
+		connect(acAutoFit, &QAction::toggled, [=](bool checked) {timePlot->setAutoFitY(checked); });
+		menu.addAction(acAutoFit);
+
+		QAction* acFilter = new QAction(QString("Filter..."));
+		acFilter->setEnabled(!source->isEmpty());
+		connect(acFilter, &QAction::triggered, [=]() {
+			DialogFilter dialog(timePlot->filter(), this);
+			connect(&dialog, &DialogFilter::filterChanged, [=](const H2A::Filters::Settings& settings) {timePlot->setFilter(settings); });
+			dialog.exec();
+			});
+		menu.addAction(acFilter);
+
+		QAction* acExport = new QAction(QString("Export view..."));
+		acExport->setEnabled(!source->isEmpty());
+		connect(acExport, &QAction::triggered, [=]() {emit this->exportRequested(source); });
+		menu.addAction(acExport);
+	}
+
+	if (source->type() == H2A::Spectrum) {
+		SpectrumPlot* spectrumPlot = static_cast<SpectrumPlot*>(source);
+
+		QAction* acSpectrogram = new QAction(QString("Show spectrogram"));
+		acSpectrogram->setCheckable(true);
+		acSpectrogram->setChecked(spectrumPlot->spectrogramVisible());
+		connect(acSpectrogram, &QAction::toggled, [=](bool checked) {spectrumPlot->setSpectrogramVisible(checked); });
+		menu.addAction(acSpectrogram);
+
+		QMenu* segmentMenu = menu.addMenu("Segment size");
+		for (size_t size = 256; size <= 65536; size *= 4) {
+			QAction* acSegment = new QAction(QString::number(size));
+			acSegment->setCheckable(true);
+			acSegment->setChecked(spectrumPlot->segmentSize() == size);
+			connect(acSegment, &QAction::triggered, [=]() {spectrumPlot->setSegmentSize(size); });
+			segmentMenu->addAction(acSegment);
+		}
+	}
+
+	if (source->type() == H2A::Histogram || source->type() == H2A::Heatmap) {
+		QMenu* binMenu = menu.addMenu("Bins");
+		for (size_t bins = 25; bins <= 400; bins *= 2) {
+			QAction* acBins = new QAction(QString::number(bins));
+			acBins->setCheckable(true);
+			if (source->type() == H2A::Histogram) {
+				HistogramPlot* histogramPlot = static_cast<HistogramPlot*>(source);
+				acBins->setChecked(histogramPlot->bins() == bins);
+				connect(acBins, &QAction::triggered, [=]() {histogramPlot->setBins(bins); });
+			}
+			else {
+				HeatmapPlot* heatmapPlot = static_cast<HeatmapPlot*>(source);
+				acBins->setChecked(heatmapPlot->bins() == bins);
+				connect(acBins, &QAction::triggered, [=]() {heatmapPlot->setBins(bins); });
+			}
+			binMenu->addAction(acBins);
+		}
+	}
+
+	if (source->type() == H2A::Spectrum || source->type() == H2A::Histogram || source->type() == H2A::Heatmap || source->type() == H2A::XY) {
+		QAction* acFollow = new QAction(QString("Follow time window"));
+		acFollow->setCheckable(true);
+		acFollow->setChecked(source->followTimeWindow());
+		connect(acFollow, &QAction::toggled, [=](bool checked) {
+			QCPRange range;
+			if (this->visibleTimeRange(range)) source->setTimeWindow(range);
+			source->setFollowTimeWindow(checked);
+			});
+		menu.addAction(acFollow);
+	}
+
 	QAction* acClear = new QAction(QString("Clear"));
 	acClear->setEnabled(!source->isEmpty() && source->type() != H2A::EmcyList);
 	connect(acClear, &QAction::triggered, [=]() {source->clear(); });
@@ -312,4 +477,23 @@ void PlotManager::contextMenu(AbstractPlot* source, const QPoint& pos) {
 void PlotManager::setSelectedCar(H2A::Car car) {
 	m_SelectedCar = car;
 	emit selectedCarChanged(m_SelectedCar);
-}
\ No newline at end of file
+}
+/**
+* Slot that is called when the time correction of a datafile changed, so the plots update the time of its datasets.
+* Connected to signal from DataStore.
+*
+* @param datafile Datafile of which the time correction changed.
+**/
+void PlotManager::timeCorrected(const H2A::Datafile* datafile) {
+	for (const auto& plot : this->plots()) plot->timeCorrected(datafile);
+}
+
+/**
+* Slot that is called when the data of a dataset changed, e.g. a derived dataset that is evaluated again, so the plots
+* show the new data. Connected to signal from DataStore.
+*
+* @param dataset Dataset of which the data changed.
+**/
+void PlotManager::datasetChanged(const H2A::Dataset* dataset) {
+	for (const auto& plot : this->plots()) plot->datasetChanged(dataset);
+}
@@ -0,0 +1,57 @@
+# Generates application/core/include/EmcyCodes.h from the EMCY code tables in this folder.
+# Runs as custom build step of the tables, so the header is regenerated whenever a table is changed.
+param(
+    [string]$OutFile = (Join-Path $PSScriptRoot "..\..\application\core\include\EmcyCodes.h")
+)
+
+$ErrorActionPreference = "Stop"
+
+# Table as lines of C++ initializers, sorted on code. Lines are formatted as "<hex code>; <text>; [hide]".
+function Convert-Table([string]$Name, [string]$File) {
+    $codes = @{}
+    foreach ($line in Get-Content $File) {
+        if ($line.Length -lt 5) { continue }
+        $fields = $line.Split(';')
+        # Codes are read up to the first character that is not a hexadecimal digit (e.g. the suffix in "1000u")
+        if ($fields[0].Trim() -notmatch '^[0-9A-Fa-f]+') { continue }
+        $code = [Convert]::ToUInt16($Matches[0], 16)
+        $text = if ($fields.Length -gt 1) { $fields[1].Trim() } else { "" }
+        $hide = ($fields.Length -gt 2) -and ($fields[2].Trim() -eq "hide")
+        if ($codes.ContainsKey($code)) { Write-Warning ("Duplicate EMCY code {0:X4} in {1}" -f $code, $File) }
+        $codes[$code] = @($text, $hide)
+    }
+
+    $lines = @("`t`tinline constexpr Properties $Name[] = {")
+    foreach ($code in ($codes.Keys | Sort-Object)) {
+        $text = $codes[$code][0].Replace('\', '\\').Replace('"', '\"')
+        $hide = if ($codes[$code][1]) { "true" } else { "false" }
+        $lines += "`t`t`t{{ 0x{0:X4}, `"{1}`", {2} }}," -f $code, $text, $hide
+    }
+    $lines += "`t`t};"
+    return $lines
+}
+
+$header = @(
+    "#pragma once",
+    "",
+    "// Generated from data/default_settings/emcy_codes_f8.txt and emcy_codes_f9.txt by generate_emcy_codes.ps1, do not edit.",
+    "",
+    "#include `"Emcies.h`"",
+    "",
+    "namespace H2A",
+    "{",
+    "`tnamespace Emcy",
+    "`t{",
+    "",
+    "`t`t// EMCY definitions per car, sorted on code"
+)
+$header += Convert-Table "F8_CODES" (Join-Path $PSScriptRoot "emcy_codes_f8.txt")
+$header += ""
+$header += Convert-Table "F9_CODES" (Join-Path $PSScriptRoot "emcy_codes_f9.txt")
+$header += @(
+    "",
+    "`t}",
+    "}"
+)
+
+Set-Content -Path $OutFile -Value $header -Encoding ASCII